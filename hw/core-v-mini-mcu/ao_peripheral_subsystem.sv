@@ -21,6 +21,8 @@ module ao_peripheral_subsystem
     input  logic        execute_from_flash_i,
     output logic        exit_valid_o,
     output logic [31:0] exit_value_o,
+    output logic bus_qos_override_o,
+    output logic [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER-1:0][1:0] bus_qos_priority_o,
 
     // Memory Map SPI Region
     input  obi_req_t  spimemio_req_i,
@@ -142,9 +144,24 @@ module ao_peripheral_subsystem
   logic spi_flash_rx_valid;
   logic spi_flash_tx_ready;
 
+  logic rv_timer_0_tick;
+  logic rv_timer_1_tick;
+  logic dma_timer_rx_pending;
+  logic dma_timer_tx_pending;
+
+  logic [63:0] event_matrix_sources;
+  logic event_matrix_dma_start;
+  logic [31:0] event_matrix_dma_size;
+  logic [1:0] event_matrix_timer_hold;
+  logic [7:0] event_matrix_gpio_sel;
+  logic [7:0] event_matrix_gpio;
+
+  logic [7:0] gpio_ao_in_sync;
+  logic [7:0] gpio_ao_out;
   logic [23:0] intr_gpio_unused;
   logic [23:0] cio_gpio_unused;
   logic [23:0] cio_gpio_en_unused;
+  logic [23:0] gpio_in_sync_unused;
 
   assign ext_peripheral_slave_req_o = ao_peripheral_slv_req[core_v_mini_mcu_pkg::EXT_PERIPHERAL_IDX];
   assign ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::EXT_PERIPHERAL_IDX] = ext_peripheral_slave_resp_i;
@@ -212,7 +229,9 @@ module ao_peripheral_subsystem
       .execute_from_flash_i,
       .use_spimemio_o(use_spimemio),
       .exit_valid_o,
-      .exit_value_o
+      .exit_value_o,
+      .bus_qos_override_o,
+      .bus_qos_priority_o
   );
 
   boot_rom boot_rom_i (
@@ -323,16 +342,43 @@ module ao_peripheral_subsystem
       .tl_i(rv_timer_tl_h2d),
       .tl_o(rv_timer_tl_d2h),
       .intr_timer_expired_0_0_o(rv_timer_0_intr_o),
-      .intr_timer_expired_1_0_o(rv_timer_1_intr_o)
+      .intr_timer_expired_1_0_o(rv_timer_1_intr_o),
+      .tick_0_o(rv_timer_0_tick),
+      .tick_1_o(rv_timer_1_tick),
+      .hold_0_i(event_matrix_timer_hold[0]),
+      .hold_1_i(event_matrix_timer_hold[1])
   );
 
-  parameter DMA_TRIGGER_SLOT_NUM = 5;
+  // Timer paced DMA trigger slots: each tick of rv_timer 1 lets the DMA do one read
+  // (rx slot) or one write (tx slot), e.g. of the GPIO input or output register.
+  // The tick is held until the access is granted, ticks are lost if the DMA is slower.
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_dma_timer_slots
+    if (~rst_ni) begin
+      dma_timer_rx_pending <= 1'b0;
+      dma_timer_tx_pending <= 1'b0;
+    end else begin
+      if (rv_timer_1_tick == 1'b1) begin
+        dma_timer_rx_pending <= 1'b1;
+      end else if (dma_master0_ch0_req_o.req == 1'b1 && dma_master0_ch0_resp_i.gnt == 1'b1) begin
+        dma_timer_rx_pending <= 1'b0;
+      end
+      if (rv_timer_1_tick == 1'b1) begin
+        dma_timer_tx_pending <= 1'b1;
+      end else if (dma_master1_ch0_req_o.req == 1'b1 && dma_master1_ch0_resp_i.gnt == 1'b1) begin
+        dma_timer_tx_pending <= 1'b0;
+      end
+    end
+  end
+
+  parameter DMA_TRIGGER_SLOT_NUM = 7;
   logic [DMA_TRIGGER_SLOT_NUM-1:0] dma_trigger_slots;
   assign dma_trigger_slots[0] = spi_rx_valid;
   assign dma_trigger_slots[1] = spi_tx_ready;
   assign dma_trigger_slots[2] = spi_flash_rx_valid;
   assign dma_trigger_slots[3] = spi_flash_tx_ready;
   assign dma_trigger_slots[4] = i2s_rx_valid_i;
+  assign dma_trigger_slots[5] = dma_timer_rx_pending;
+  assign dma_trigger_slots[6] = dma_timer_tx_pending;
 
   dma #(
       .reg_req_t (reg_pkg::reg_req_t),
@@ -350,6 +396,8 @@ module ao_peripheral_subsystem
       .dma_master1_ch0_req_o,
       .dma_master1_ch0_resp_i,
       .trigger_slot_i(dma_trigger_slots),
+      .ext_start_i(event_matrix_dma_start),
+      .ext_size_i(event_matrix_dma_size),
       .dma_intr_o
   );
 
@@ -377,9 +425,9 @@ module ao_peripheral_subsystem
       .reg_req_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::GPIO_AO_IDX]),
       .reg_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::GPIO_AO_IDX]),
       .gpio_in({24'b0, cio_gpio_i}),
-      .gpio_out({cio_gpio_unused, cio_gpio_o}),
+      .gpio_out({cio_gpio_unused, gpio_ao_out}),
       .gpio_tx_en_o({cio_gpio_en_unused, cio_gpio_en_o}),
-      .gpio_in_sync_o(),
+      .gpio_in_sync_o({gpio_in_sync_unused, gpio_ao_in_sync}),
       .pin_level_interrupts_o({intr_gpio_unused, intr_gpio_o}),
       .global_interrupt_o()
   );
@@ -419,4 +467,33 @@ module ao_peripheral_subsystem
       .intr_rx_parity_err_o(uart_intr_rx_parity_err_o)
   );
 
+  // Source events of the event matrix, the numbers used by the SOURCE field of its channels
+  assign event_matrix_sources[7:0] = gpio_ao_in_sync;  // 0-7: always-on GPIO pins
+  assign event_matrix_sources[22:8] = fast_intr_i;  // 8-22: fast interrupts (rv_timer 1-3, DMA, SPI, SPI flash, GPIO 0-7)
+  assign event_matrix_sources[23] = rv_timer_0_intr_o;
+  assign event_matrix_sources[30:24] = dma_trigger_slots;  // 24-30: DMA trigger slots
+  assign event_matrix_sources[31] = 1'b0;
+  assign event_matrix_sources[32] = rv_timer_0_tick;
+  assign event_matrix_sources[33] = rv_timer_1_tick;
+  assign event_matrix_sources[63:34] = '0;
+
+  event_matrix #(
+      .reg_req_t(reg_pkg::reg_req_t),
+      .reg_rsp_t(reg_pkg::reg_rsp_t)
+  ) event_matrix_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i(ao_peripheral_slv_req[core_v_mini_mcu_pkg::EVENT_MATRIX_IDX]),
+      .reg_rsp_o(ao_peripheral_slv_rsp[core_v_mini_mcu_pkg::EVENT_MATRIX_IDX]),
+      .event_i(event_matrix_sources),
+      .dma_start_o(event_matrix_dma_start),
+      .dma_size_o(event_matrix_dma_size),
+      .timer_hold_o(event_matrix_timer_hold),
+      .gpio_sel_o(event_matrix_gpio_sel),
+      .gpio_o(event_matrix_gpio)
+  );
+
+  // The GPIO pins selected by the event matrix are driven by it instead of the GPIO
+  assign cio_gpio_o = (event_matrix_gpio_sel & event_matrix_gpio) | (~event_matrix_gpio_sel & gpio_ao_out);
+
 endmodule : ao_peripheral_subsystem
@@ -40,6 +40,9 @@ module core_v_mini_mcu
     output obi_req_t  ext_xbar_slave_req_o,
     input  obi_resp_t ext_xbar_slave_resp_i,
 
+    output core_v_mini_mcu_pkg::ext_axi_req_t  ext_axi_slave_req_o,
+    input  core_v_mini_mcu_pkg::ext_axi_resp_t ext_axi_slave_resp_i,
+
     output reg_req_t ext_peripheral_slave_req_o,
     input  reg_rsp_t ext_peripheral_slave_resp_i,
 
@@ -120,6 +123,10 @@ module core_v_mini_mcu
   obi_req_t flash_mem_slave_req;
   obi_resp_t flash_mem_slave_resp;
 
+  // Bus QoS
+  logic bus_qos_override;
+  logic [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER-1:0][1:0] bus_qos_priority;
+
   // rv_timer
   logic [3:0] rv_timer_intr;
 
@@ -259,7 +266,11 @@ module core_v_mini_mcu
       .flash_mem_slave_req_o(flash_mem_slave_req),
       .flash_mem_slave_resp_i(flash_mem_slave_resp),
       .ext_xbar_slave_req_o(ext_xbar_slave_req_o),
-      .ext_xbar_slave_resp_i(ext_xbar_slave_resp_i)
+      .ext_xbar_slave_resp_i(ext_xbar_slave_resp_i),
+      .ext_axi_slave_req_o(ext_axi_slave_req_o),
+      .ext_axi_slave_resp_i(ext_axi_slave_resp_i),
+      .bus_qos_override_i(bus_qos_override),
+      .bus_qos_priority_i(bus_qos_priority)
   );
 
   memory_subsystem #(
@@ -282,6 +293,8 @@ module core_v_mini_mcu
       .execute_from_flash_i,
       .exit_valid_o,
       .exit_value_o,
+      .bus_qos_override_o(bus_qos_override),
+      .bus_qos_priority_o(bus_qos_priority),
       .spimemio_req_i(flash_mem_slave_req),
       .spimemio_resp_o(flash_mem_slave_resp),
       .spi_flash_sck_o,
@@ -13,6 +13,8 @@
  *
  */
 
+`include "axi/typedef.svh"
+
 package core_v_mini_mcu_pkg;
 
   import addr_map_rule_pkg::*;
@@ -41,8 +43,22 @@ package core_v_mini_mcu_pkg;
 
   localparam SYSTEM_XBAR_NMASTER = 5;
 
+  //bus QoS, priorities and budgets indexed by master idx
+  localparam int unsigned BUS_QOS_WINDOW = ${bus_qos_window};
+  localparam logic [1:0] BUS_QOS_PRIORITY[SYSTEM_XBAR_NMASTER] = '{
+% for master in bus_qos_masters[:-1]:
+      2'd${bus_qos_priority[master]}${',' if not loop.last else ''}
+% endfor
+  };
+  localparam int unsigned BUS_QOS_BUDGET[SYSTEM_XBAR_NMASTER] = '{
+% for master in bus_qos_masters[:-1]:
+      ${bus_qos_budget[master]}${',' if not loop.last else ''}
+% endfor
+  };
+  localparam logic [1:0] BUS_QOS_EXT_PRIORITY = 2'd${bus_qos_priority['ext']};
+  localparam int unsigned BUS_QOS_EXT_BUDGET = ${bus_qos_budget['ext']};
+
   //slave mmap and idx
-  //must be power of two
   localparam int unsigned MEM_SIZE = 32'h${ram_size_address};
 
   localparam SYSTEM_XBAR_NSLAVE = ${int(ram_numbanks) + 6};
@@ -52,6 +68,18 @@ package core_v_mini_mcu_pkg;
 
   localparam int unsigned NUM_BANKS = ${ram_numbanks};
   localparam int unsigned NUM_BANKS_IL = ${ram_numbanks_il};
+
+  //size in bytes and start address of each bank, the interleaved banks start with the interleaved region
+  localparam int unsigned BANK_SIZE[NUM_BANKS] = '{
+% for bank in range(ram_numbanks):
+      32'h${'{:08X}'.format(ram_bank_sizes[bank])}${',' if bank < ram_numbanks - 1 else ''}
+% endfor
+  };
+  localparam logic [31:0] BANK_START_ADDRESS[NUM_BANKS] = '{
+% for bank in range(ram_numbanks):
+      32'h${'{:08X}'.format(ram_bank_start_addresses[bank])}${',' if bank < ram_numbanks - 1 else ''}
+% endfor
+  };
   localparam int unsigned EXTERNAL_DOMAINS = ${external_domains};
 
   localparam logic[31:0] ERROR_START_ADDRESS = 32'hBADACCE5;
@@ -60,14 +88,14 @@ package core_v_mini_mcu_pkg;
   localparam logic[31:0] ERROR_IDX = 32'd0;
 
 % for bank in range(ram_numbanks_cont):
-  localparam logic [31:0] RAM${bank}_START_ADDRESS = 32'h${'{:08X}'.format(int(ram_start_address) + bank*32*1024)};
-  localparam logic [31:0] RAM${bank}_SIZE = 32'h${hex(32*1024)[2:]};
+  localparam logic [31:0] RAM${bank}_START_ADDRESS = 32'h${'{:08X}'.format(ram_bank_start_addresses[bank])};
+  localparam logic [31:0] RAM${bank}_SIZE = 32'h${hex(ram_bank_sizes[bank])[2:]};
   localparam logic [31:0] RAM${bank}_END_ADDRESS = RAM${bank}_START_ADDRESS + RAM${bank}_SIZE;
   localparam logic [31:0] RAM${bank}_IDX = 32'd${bank + 1};
 % endfor
 % if ram_numbanks_il != 0:
-  localparam logic [31:0] RAM${ram_numbanks_cont}_START_ADDRESS = 32'h${'{:08X}'.format(int(ram_start_address) + int(ram_numbanks_cont)*32*1024)};
-  localparam logic [31:0] RAM${ram_numbanks_cont}_SIZE = 32'h${hex(int(ram_numbanks_il)*32*1024)[2:]};
+  localparam logic [31:0] RAM${ram_numbanks_cont}_START_ADDRESS = 32'h${'{:08X}'.format(ram_il_start_address)};
+  localparam logic [31:0] RAM${ram_numbanks_cont}_SIZE = 32'h${hex(ram_il_size)[2:]};
   localparam logic [31:0] RAM${ram_numbanks_cont}_END_ADDRESS = RAM${ram_numbanks_cont}_START_ADDRESS + RAM${ram_numbanks_cont}_SIZE;
   localparam logic [31:0] RAM${ram_numbanks_cont}_IDX = 32'd${ram_numbanks_cont + 1};
 % for bank in range(ram_numbanks_il - 1):
@@ -89,16 +117,31 @@ package core_v_mini_mcu_pkg;
   localparam logic[31:0] PERIPHERAL_SIZE = 32'h${peripheral_size_address};
   localparam logic[31:0] PERIPHERAL_END_ADDRESS = PERIPHERAL_START_ADDRESS + PERIPHERAL_SIZE;
   localparam logic[31:0] PERIPHERAL_IDX = 32'd${int(ram_numbanks) + 3};
+  localparam int unsigned PERIPHERAL_POSTED_WRITES = ${peripheral_posted_writes};
 
   localparam logic[31:0] EXT_SLAVE_START_ADDRESS = 32'h${ext_slave_start_address};
   localparam logic[31:0] EXT_SLAVE_SIZE = 32'h${ext_slave_size_address};
   localparam logic[31:0] EXT_SLAVE_END_ADDRESS = EXT_SLAVE_START_ADDRESS + EXT_SLAVE_SIZE;
   localparam logic[31:0] EXT_SLAVE_IDX = 32'd${int(ram_numbanks) + 4};
+  localparam int unsigned EXT_SLAVE_POSTED_WRITES = ${ext_slave_posted_writes};
+  localparam logic EXT_SLAVE_AXI = 1'b${int(ext_slave_axi)};
+  localparam int unsigned EXT_SLAVE_AXI_DATA_WIDTH = ${ext_slave_axi_data_width};
+
+  // AXI4 external slave port, used when EXT_SLAVE_AXI is set
+  typedef logic [31:0] ext_axi_addr_t;
+  typedef logic [EXT_SLAVE_AXI_DATA_WIDTH-1:0] ext_axi_data_t;
+  typedef logic [EXT_SLAVE_AXI_DATA_WIDTH/8-1:0] ext_axi_strb_t;
+  typedef logic [0:0] ext_axi_id_t;
+  typedef logic [0:0] ext_axi_user_t;
+  `AXI_TYPEDEF_ALL(ext_axi, ext_axi_addr_t, ext_axi_id_t, ext_axi_data_t, ext_axi_strb_t, ext_axi_user_t)
 
   localparam logic[31:0] FLASH_MEM_START_ADDRESS = 32'h${flash_mem_start_address};
   localparam logic[31:0] FLASH_MEM_SIZE = 32'h${flash_mem_size_address};
   localparam logic[31:0] FLASH_MEM_END_ADDRESS = FLASH_MEM_START_ADDRESS + FLASH_MEM_SIZE;
   localparam logic[31:0] FLASH_MEM_IDX = 32'd${int(ram_numbanks) + 5};
+  localparam int unsigned FLASH_CACHE_SIZE = ${flash_cache_size};
+  localparam int unsigned FLASH_CACHE_LINE_SIZE = ${flash_cache_line_size};
+  localparam int unsigned FLASH_CACHE_WAYS = ${flash_cache_ways};
 
   localparam addr_map_rule_t [SYSTEM_XBAR_NSLAVE-1:0] XBAR_ADDR_RULES = '{
       '{ idx: ERROR_IDX, start_addr: ERROR_START_ADDRESS, end_addr: ERROR_END_ADDRESS },
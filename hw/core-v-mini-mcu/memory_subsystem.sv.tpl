@@ -22,26 +22,31 @@ module memory_subsystem
     input logic [core_v_mini_mcu_pkg::NUM_BANKS-1:0] set_retentive_i
 );
 
-  localparam int NumWords = 32 * 1024 / 4;
-  localparam int AddrWidth = $clog2(32 * 1024);
-
   logic [NUM_BANKS-1:0] ram_valid_q;
   // Clock-gating
   logic [NUM_BANKS-1:0] clk_cg;
-% if ram_numbanks_il != 0:
-  logic [NUM_BANKS-1:0][AddrWidth-3:0] ram_req_addr;
 
-  for (genvar i = 0; i < NUM_BANKS; i++) begin : gen_addr_napot
-    if (i >= NUM_BANKS - ${ram_numbanks_il}) begin
-      assign ram_req_addr[i] = {${log_ram_numbanks_il}'h0, ram_req_i[i].addr[AddrWidth-1:${2+log_ram_numbanks_il}]};
-    end else begin
-      assign ram_req_addr[i] = ram_req_i[i].addr[AddrWidth-1:2];
+  for (genvar i = 0; i < NUM_BANKS; i++) begin : gen_sram
+
+    localparam int unsigned NumWords = core_v_mini_mcu_pkg::BANK_SIZE[i] / 4;
+    localparam int unsigned AddrWidth = $clog2(core_v_mini_mcu_pkg::BANK_SIZE[i]);
+
+    // Offset within the bank, banks of different sizes are not aligned to their size
+    logic [31:0] bank_addr;
+    logic [AddrWidth-3:0] ram_req_addr;
+
+    assign bank_addr = ram_req_i[i].addr - core_v_mini_mcu_pkg::BANK_START_ADDRESS[i];
+
+% if ram_numbanks_il != 0:
+    if (i >= NUM_BANKS - ${ram_numbanks_il}) begin : gen_addr_il
+      assign ram_req_addr = bank_addr[AddrWidth-1+${log_ram_numbanks_il}:${2+log_ram_numbanks_il}];
+    end else begin : gen_addr_cont
+      assign ram_req_addr = bank_addr[AddrWidth-1:2];
     end
-  end
+% else:
+    assign ram_req_addr = bank_addr[AddrWidth-1:2];
 % endif
 
-  for (genvar i = 0; i < NUM_BANKS; i++) begin : gen_sram
-
     tc_clk_gating clk_gating_cell_i (
         .clk_i,
         .en_i(~clk_gate_en_i[i]),
@@ -60,7 +65,6 @@ module memory_subsystem
     assign ram_resp_o[i].gnt = ram_req_i[i].req;
     assign ram_resp_o[i].rvalid = ram_valid_q[i];
 
-    //Fixed to 8KWords per bank (32KB)
     sram_wrapper #(
         .NumWords (NumWords),
         .DataWidth(32'd32)
@@ -69,11 +73,7 @@ module memory_subsystem
         .rst_ni(rst_ni),
         .req_i(ram_req_i[i].req),
         .we_i(ram_req_i[i].we),
-% if ram_numbanks_il == 0:
-        .addr_i(ram_req_i[i].addr[AddrWidth-1:2]),
-% else:      
-        .addr_i(ram_req_addr[i]),
-% endif        
+        .addr_i(ram_req_addr),
         .wdata_i(ram_req_i[i].wdata),
         .be_i(ram_req_i[i].be),
         .set_retentive_i(set_retentive_i[i]),
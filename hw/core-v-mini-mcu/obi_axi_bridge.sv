@@ -0,0 +1,249 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// OBI to AXI4 bridge for the external slave port.
+// Writes are posted as in obi_posted_write_buffer: they are granted and answered as soon as they are
+// stored in a buffer of DEPTH words. When a burst starts, the stored words at consecutive addresses
+// (within a 4KB page) are sent as one AXI INCR burst, packed in the lanes of AXI_DATA_WIDTH-bit beats.
+// Reads are sent one at a time as single beat bursts, once all the stored writes are answered by the
+// slave, so a read still sees the writes done before it. Write errors are not reported, the writes
+// being already answered.
+
+module obi_axi_bridge
+  import obi_pkg::*;
+#(
+    parameter int unsigned DEPTH = 4,
+    parameter int unsigned AXI_DATA_WIDTH = 32,
+    parameter type axi_req_t = logic,
+    parameter type axi_resp_t = logic
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  obi_req_t  slave_req_i,
+    output obi_resp_t slave_resp_o,
+
+    output axi_req_t  axi_req_o,
+    input  axi_resp_t axi_resp_i
+);
+
+  localparam int unsigned WORDS_PER_BEAT = AXI_DATA_WIDTH / 32;
+  localparam int unsigned BEAT_OFFSET = $clog2(AXI_DATA_WIDTH / 8);
+  localparam int unsigned LANE_WIDTH = WORDS_PER_BEAT > 1 ? $clog2(WORDS_PER_BEAT) : 1;
+  localparam int unsigned PTR_WIDTH = DEPTH > 1 ? $clog2(DEPTH) : 1;
+  localparam int unsigned CNT_WIDTH = $clog2(DEPTH + 1);
+
+  typedef enum logic [1:0] {
+    IDLE,
+    AW,
+    W
+  } burst_fsm_e;
+
+  burst_fsm_e state_q, state_d;
+
+  //write buffer
+  logic [31:0] buf_addr_q[DEPTH];
+  logic [31:0] buf_wdata_q[DEPTH];
+  logic [3:0] buf_be_q[DEPTH];
+  logic [PTR_WIDTH-1:0] head_q, tail_q;
+  logic [CNT_WIDTH-1:0] count_q;
+  logic push, pop;
+
+  //current burst
+  logic [CNT_WIDTH-1:0] run_words;
+  logic [CNT_WIDTH-1:0] words_left_q;
+  logic [CNT_WIDTH-1:0] beats_left_q;
+  logic [31:0] aw_addr_q;
+  logic [7:0] aw_len_q;
+  logic [AXI_DATA_WIDTH-1:0] w_data_q;
+  logic [AXI_DATA_WIDTH/8-1:0] w_strb_q;
+  logic w_valid_q;
+  logic w_fire;
+  logic [LANE_WIDTH-1:0] pop_lane;
+  //bursts sent and not answered yet
+  logic [CNT_WIDTH:0] b_pending_q;
+
+  //read
+  logic read_req;
+  logic read_pending_q;
+  logic ar_valid_q;
+  logic [31:0] ar_addr_q;
+  logic write_rvalid_q;
+
+  function automatic logic [PTR_WIDTH-1:0] buf_idx(logic [PTR_WIDTH-1:0] ptr, int unsigned i);
+    int unsigned idx;
+    idx = int'(ptr) + i;
+    return PTR_WIDTH'(idx >= DEPTH ? idx - DEPTH : idx);
+  endfunction
+
+  //a write is stored when no read is waiting for its data, so that the responses stay in order
+  assign push = slave_req_i.req && slave_req_i.we && count_q != CNT_WIDTH'(DEPTH) && !read_pending_q;
+  assign read_req = slave_req_i.req && !slave_req_i.we && count_q == '0 && state_q == IDLE &&
+                    b_pending_q == '0 && !read_pending_q;
+
+  //number of words stored at consecutive addresses from the head of the buffer
+  always_comb begin : proc_run
+    logic [31:0] head_addr;
+    logic [31:0] addr;
+    head_addr = {buf_addr_q[head_q][31:2], 2'b00};
+    run_words = CNT_WIDTH'(1);
+    for (int unsigned i = 1; i < DEPTH; i++) begin
+      addr = {buf_addr_q[buf_idx(head_q, i)][31:2], 2'b00};
+      if (run_words == CNT_WIDTH'(i) && count_q > CNT_WIDTH'(i) && addr == head_addr + 32'(4 * i) &&
+          addr[31:12] == head_addr[31:12]) begin
+        run_words = CNT_WIDTH'(i + 1);
+      end
+    end
+  end
+
+  assign w_fire = w_valid_q && axi_resp_i.w_ready;
+  assign pop = state_q == W && words_left_q != '0 && (!w_valid_q || w_fire);
+  if (WORDS_PER_BEAT > 1) begin : gen_pop_lane
+    assign pop_lane = buf_addr_q[head_q][BEAT_OFFSET-1:2];
+  end else begin : gen_pop_word
+    assign pop_lane = '0;
+  end
+
+  always_comb begin
+    state_d = state_q;
+    unique case (state_q)
+      IDLE: begin
+        if (count_q != '0 && b_pending_q != '1 && !read_pending_q) begin
+          state_d = AW;
+        end
+      end
+      AW: begin
+        if (axi_resp_i.aw_ready) begin
+          state_d = W;
+        end
+      end
+      W: begin
+        if (w_fire && beats_left_q == CNT_WIDTH'(1)) begin
+          state_d = IDLE;
+        end
+      end
+      default: state_d = IDLE;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_buffer
+    if (~rst_ni) begin
+      head_q  <= '0;
+      tail_q  <= '0;
+      count_q <= '0;
+      for (int unsigned i = 0; i < DEPTH; i++) begin
+        buf_addr_q[i]  <= '0;
+        buf_wdata_q[i] <= '0;
+        buf_be_q[i]    <= '0;
+      end
+    end else begin
+      if (push) begin
+        buf_addr_q[tail_q]  <= slave_req_i.addr;
+        buf_wdata_q[tail_q] <= slave_req_i.wdata;
+        buf_be_q[tail_q]    <= slave_req_i.be;
+        tail_q              <= buf_idx(tail_q, 1);
+      end
+      if (pop) begin
+        head_q <= buf_idx(head_q, 1);
+      end
+      count_q <= count_q + CNT_WIDTH'(push) - CNT_WIDTH'(pop);
+    end
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_burst
+    if (~rst_ni) begin
+      state_q      <= IDLE;
+      words_left_q <= '0;
+      beats_left_q <= '0;
+      aw_addr_q    <= '0;
+      aw_len_q     <= '0;
+      w_data_q     <= '0;
+      w_strb_q     <= '0;
+      w_valid_q    <= 1'b0;
+      b_pending_q  <= '0;
+    end else begin
+      state_q <= state_d;
+      if (state_q == IDLE && state_d == AW) begin
+        aw_addr_q <= {buf_addr_q[head_q][31:BEAT_OFFSET], BEAT_OFFSET'(0)};
+        //the first word may not be in the first lane of its beat
+        aw_len_q <= 8'((32'(pop_lane) + 32'(run_words) - 1) / WORDS_PER_BEAT);
+        beats_left_q <= CNT_WIDTH'((32'(pop_lane) + 32'(run_words) - 1) / WORDS_PER_BEAT + 1);
+        words_left_q <= run_words;
+      end
+      if (w_fire) begin
+        w_valid_q    <= 1'b0;
+        w_strb_q     <= '0;
+        beats_left_q <= beats_left_q - CNT_WIDTH'(1);
+      end
+      if (pop) begin
+        w_data_q[32*pop_lane+:32] <= buf_wdata_q[head_q];
+        if (w_fire) begin
+          w_strb_q <= '0;
+        end
+        w_strb_q[4*pop_lane+:4] <= buf_be_q[head_q];
+        //the beat is sent once its last lane or the last word of the burst is filled
+        w_valid_q <= words_left_q == CNT_WIDTH'(1) || 32'(pop_lane) == WORDS_PER_BEAT - 1;
+        words_left_q <= words_left_q - CNT_WIDTH'(1);
+      end
+      b_pending_q <= b_pending_q + (CNT_WIDTH + 1)'(state_q == AW && axi_resp_i.aw_ready) -
+                     (CNT_WIDTH + 1)'(axi_resp_i.b_valid && b_pending_q != '0);
+    end
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_read
+    if (~rst_ni) begin
+      read_pending_q <= 1'b0;
+      ar_valid_q     <= 1'b0;
+      ar_addr_q      <= '0;
+      write_rvalid_q <= 1'b0;
+    end else begin
+      write_rvalid_q <= push;
+      if (read_req) begin
+        read_pending_q <= 1'b1;
+        ar_valid_q     <= 1'b1;
+        ar_addr_q      <= {slave_req_i.addr[31:2], 2'b00};
+      end
+      if (ar_valid_q && axi_resp_i.ar_ready) begin
+        ar_valid_q <= 1'b0;
+      end
+      if (read_pending_q && !ar_valid_q && axi_resp_i.r_valid) begin
+        read_pending_q <= 1'b0;
+      end
+    end
+  end
+
+  always_comb begin
+    axi_req_o = '0;
+
+    axi_req_o.aw.addr = aw_addr_q;
+    axi_req_o.aw.len = aw_len_q;
+    axi_req_o.aw.size = axi_pkg::size_t'(BEAT_OFFSET);
+    axi_req_o.aw.burst = axi_pkg::BURST_INCR;
+    axi_req_o.aw.cache = axi_pkg::CACHE_BUFFERABLE;
+    axi_req_o.aw_valid = state_q == AW;
+
+    axi_req_o.w.data = w_data_q;
+    axi_req_o.w.strb = w_strb_q;
+    axi_req_o.w.last = beats_left_q == CNT_WIDTH'(1);
+    axi_req_o.w_valid = w_valid_q;
+
+    axi_req_o.b_ready = 1'b1;
+
+    axi_req_o.ar.addr = ar_addr_q;
+    axi_req_o.ar.size = axi_pkg::size_t'(2);
+    axi_req_o.ar.burst = axi_pkg::BURST_INCR;
+    axi_req_o.ar_valid = ar_valid_q;
+
+    axi_req_o.r_ready = 1'b1;
+  end
+
+  assign slave_resp_o.gnt = push || read_req;
+  assign slave_resp_o.rvalid = write_rvalid_q || (read_pending_q && !ar_valid_q && axi_resp_i.r_valid);
+  if (WORDS_PER_BEAT > 1) begin : gen_read_lane
+    assign slave_resp_o.rdata = axi_resp_i.r.data[32*ar_addr_q[BEAT_OFFSET-1:2]+:32];
+  end else begin : gen_read_word
+    assign slave_resp_o.rdata = axi_resp_i.r.data[31:0];
+  end
+
+endmodule : obi_axi_bridge
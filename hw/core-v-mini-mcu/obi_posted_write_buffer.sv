@@ -0,0 +1,111 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Posted write buffer for an OBI slave port.
+// Writes are granted and answered as soon as they are stored, then sent to the slave in order
+// while the master goes on. Reads wait until all the stored writes are answered by the slave,
+// so a read still sees the writes done before it. Software which needs a write to have taken
+// effect (e.g. before a wfi) reads back a register of the same slave.
+
+module obi_posted_write_buffer
+  import obi_pkg::*;
+#(
+    parameter int unsigned DEPTH = 2
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input  obi_req_t  slave_req_i,
+    output obi_resp_t slave_resp_o,
+
+    output obi_req_t  master_req_o,
+    input  obi_resp_t master_resp_i
+);
+
+  //BE + ADDR + WDATA
+  localparam int unsigned FIFO_DATA_WIDTH = 4 + 32 + 32;
+
+  logic fifo_full, fifo_empty;
+  logic fifo_push, fifo_pop;
+  logic [FIFO_DATA_WIDTH-1:0] fifo_data_in, fifo_data_out;
+
+  //writes sent to the slave and not answered yet
+  logic [3:0] drain_cnt_q, drain_cnt_d;
+  logic read_pending_q, read_pending_d;
+  logic write_rvalid_q;
+  logic drain_req, read_req;
+
+  fifo_v3 #(
+      .DATA_WIDTH(FIFO_DATA_WIDTH),
+      .DEPTH(DEPTH)
+  ) fifo_i (
+      .clk_i,
+      .rst_ni,
+      .flush_i(1'b0),
+      .testmode_i(1'b0),
+      .full_o(fifo_full),
+      .empty_o(fifo_empty),
+      .usage_o(),
+      .data_i(fifo_data_in),
+      .push_i(fifo_push),
+      .data_o(fifo_data_out),
+      .pop_i(fifo_pop)
+  );
+
+  assign fifo_data_in = {slave_req_i.be, slave_req_i.addr, slave_req_i.wdata};
+
+  //a write is stored once the pending read, if any, is answered so that the responses stay in order
+  assign fifo_push = slave_req_i.req && slave_req_i.we && !fifo_full &&
+                     (!read_pending_q || master_resp_i.rvalid);
+  assign drain_req = !fifo_empty && drain_cnt_q != '1;
+  assign fifo_pop = drain_req && master_resp_i.gnt;
+  assign read_req = slave_req_i.req && !slave_req_i.we && fifo_empty && drain_cnt_q == '0 &&
+                    !read_pending_q;
+
+  always_comb begin
+    master_req_o = slave_req_i;
+    master_req_o.req = read_req;
+    if (!fifo_empty) begin
+      master_req_o.req = drain_req;
+      master_req_o.we  = 1'b1;
+      {master_req_o.be, master_req_o.addr, master_req_o.wdata} = fifo_data_out;
+    end
+  end
+
+  always_comb begin
+    drain_cnt_d = drain_cnt_q;
+    if (fifo_pop) begin
+      drain_cnt_d = drain_cnt_d + 4'd1;
+    end
+    //the slave only answers writes while some are in flight, reads are sent once they are all answered
+    if (drain_cnt_q != '0 && master_resp_i.rvalid) begin
+      drain_cnt_d = drain_cnt_d - 4'd1;
+    end
+
+    read_pending_d = read_pending_q;
+    if (read_pending_q && master_resp_i.rvalid) begin
+      read_pending_d = 1'b0;
+    end
+    if (read_req && master_resp_i.gnt) begin
+      read_pending_d = 1'b1;
+    end
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_posted_write
+    if (~rst_ni) begin
+      drain_cnt_q    <= '0;
+      read_pending_q <= 1'b0;
+      write_rvalid_q <= 1'b0;
+    end else begin
+      drain_cnt_q    <= drain_cnt_d;
+      read_pending_q <= read_pending_d;
+      write_rvalid_q <= fifo_push;
+    end
+  end
+
+  assign slave_resp_o.gnt = fifo_push || (read_req && master_resp_i.gnt);
+  assign slave_resp_o.rvalid = write_rvalid_q || (read_pending_q && master_resp_i.rvalid);
+  assign slave_resp_o.rdata = master_resp_i.rdata;
+
+endmodule : obi_posted_write_buffer
@@ -84,6 +84,9 @@ module peripheral_subsystem
   reg_pkg::reg_req_t peripheral_req;
   reg_pkg::reg_rsp_t peripheral_rsp;
 
+  obi_req_t periph_to_reg_req;
+  obi_resp_t periph_to_reg_resp;
+
   reg_pkg::reg_req_t [core_v_mini_mcu_pkg::PERIPHERALS-1:0] peripheral_slv_req;
   reg_pkg::reg_rsp_t [core_v_mini_mcu_pkg::PERIPHERALS-1:0] peripheral_slv_rsp;
 
@@ -175,6 +178,22 @@ module peripheral_subsystem
       .clk_o(clk_cg)
   );
 
+  if (core_v_mini_mcu_pkg::PERIPHERAL_POSTED_WRITES != 0) begin : gen_posted_write_buffer
+    obi_posted_write_buffer #(
+        .DEPTH(core_v_mini_mcu_pkg::PERIPHERAL_POSTED_WRITES)
+    ) obi_posted_write_buffer_i (
+        .clk_i(clk_cg),
+        .rst_ni,
+        .slave_req_i,
+        .slave_resp_o,
+        .master_req_o (periph_to_reg_req),
+        .master_resp_i(periph_to_reg_resp)
+    );
+  end else begin : gen_no_posted_write_buffer
+    assign periph_to_reg_req = slave_req_i;
+    assign slave_resp_o = periph_to_reg_resp;
+  end
+
   periph_to_reg #(
       .req_t(reg_pkg::reg_req_t),
       .rsp_t(reg_pkg::reg_rsp_t),
@@ -182,17 +201,17 @@ module peripheral_subsystem
   ) periph_to_reg_i (
       .clk_i(clk_cg),
       .rst_ni,
-      .req_i(slave_req_i.req),
-      .add_i(slave_req_i.addr),
-      .wen_i(~slave_req_i.we),
-      .wdata_i(slave_req_i.wdata),
-      .be_i(slave_req_i.be),
+      .req_i(periph_to_reg_req.req),
+      .add_i(periph_to_reg_req.addr),
+      .wen_i(~periph_to_reg_req.we),
+      .wdata_i(periph_to_reg_req.wdata),
+      .be_i(periph_to_reg_req.be),
       .id_i('0),
-      .gnt_o(slave_resp_o.gnt),
-      .r_rdata_o(slave_resp_o.rdata),
+      .gnt_o(periph_to_reg_resp.gnt),
+      .r_rdata_o(periph_to_reg_resp.rdata),
       .r_opc_o(),
       .r_id_o(),
-      .r_valid_o(slave_resp_o.rvalid),
+      .r_valid_o(periph_to_reg_resp.rvalid),
       .reg_req_o(peripheral_req),
       .reg_rsp_i(peripheral_rsp)
   );
@@ -340,7 +359,11 @@ module peripheral_subsystem
       .tl_i(rv_timer_tl_h2d),
       .tl_o(rv_timer_tl_d2h),
       .intr_timer_expired_0_0_o(rv_timer_2_intr_o),
-      .intr_timer_expired_1_0_o(rv_timer_3_intr_o)
+      .intr_timer_expired_1_0_o(rv_timer_3_intr_o),
+      .tick_0_o(),
+      .tick_1_o(),
+      .hold_0_i(1'b0),
+      .hold_1_i(1'b0)
   );
 
   spi_host #(
@@ -98,7 +98,11 @@ module spi_subsystem
   assign yo_spi_csb_en = 2'b01;
   assign yo_spi_csb[1] = 1'b1;
 
-  obi_spimemio obi_spimemio_i (
+  obi_spimemio #(
+      .CACHE_SIZE(core_v_mini_mcu_pkg::FLASH_CACHE_SIZE),
+      .CACHE_LINE_SIZE(core_v_mini_mcu_pkg::FLASH_CACHE_LINE_SIZE),
+      .CACHE_WAYS(core_v_mini_mcu_pkg::FLASH_CACHE_WAYS)
+  ) obi_spimemio_i (
       .clk_i,
       .rst_ni,
       .flash_csb_o(yo_spi_csb[0]),
@@ -62,7 +62,14 @@ module system_bus
     input  obi_resp_t flash_mem_slave_resp_i,
 
     output obi_req_t  ext_xbar_slave_req_o,
-    input  obi_resp_t ext_xbar_slave_resp_i
+    input  obi_resp_t ext_xbar_slave_resp_i,
+
+    output core_v_mini_mcu_pkg::ext_axi_req_t  ext_axi_slave_req_o,
+    input  core_v_mini_mcu_pkg::ext_axi_resp_t ext_axi_slave_resp_i,
+
+    //Bus QoS
+    input logic bus_qos_override_i,
+    input logic [core_v_mini_mcu_pkg::SYSTEM_XBAR_NMASTER-1:0][1:0] bus_qos_priority_i
 );
 
   import core_v_mini_mcu_pkg::*;
@@ -116,7 +123,6 @@ module system_bus
   assign ao_peripheral_slave_req_o = slave_req[core_v_mini_mcu_pkg::AO_PERIPHERAL_IDX];
   assign peripheral_slave_req_o = slave_req[core_v_mini_mcu_pkg::PERIPHERAL_IDX];
   assign flash_mem_slave_req_o = slave_req[core_v_mini_mcu_pkg::FLASH_MEM_IDX];
-  assign ext_xbar_slave_req_o = slave_req[core_v_mini_mcu_pkg::EXT_SLAVE_IDX];
 
   //slave resp
   assign slave_resp[core_v_mini_mcu_pkg::ERROR_IDX] = error_slave_resp;
@@ -127,7 +133,41 @@ module system_bus
   assign slave_resp[core_v_mini_mcu_pkg::AO_PERIPHERAL_IDX] = ao_peripheral_slave_resp_i;
   assign slave_resp[core_v_mini_mcu_pkg::PERIPHERAL_IDX] = peripheral_slave_resp_i;
   assign slave_resp[core_v_mini_mcu_pkg::FLASH_MEM_IDX] = flash_mem_slave_resp_i;
-  assign slave_resp[core_v_mini_mcu_pkg::EXT_SLAVE_IDX] = ext_xbar_slave_resp_i;
+
+  if (core_v_mini_mcu_pkg::EXT_SLAVE_AXI) begin : gen_ext_slave_axi
+    obi_axi_bridge #(
+        .DEPTH(core_v_mini_mcu_pkg::EXT_SLAVE_POSTED_WRITES != 0 ? core_v_mini_mcu_pkg::EXT_SLAVE_POSTED_WRITES : 1),
+        .AXI_DATA_WIDTH(core_v_mini_mcu_pkg::EXT_SLAVE_AXI_DATA_WIDTH),
+        .axi_req_t(core_v_mini_mcu_pkg::ext_axi_req_t),
+        .axi_resp_t(core_v_mini_mcu_pkg::ext_axi_resp_t)
+    ) obi_axi_bridge_i (
+        .clk_i,
+        .rst_ni,
+        .slave_req_i (slave_req[core_v_mini_mcu_pkg::EXT_SLAVE_IDX]),
+        .slave_resp_o(slave_resp[core_v_mini_mcu_pkg::EXT_SLAVE_IDX]),
+        .axi_req_o   (ext_axi_slave_req_o),
+        .axi_resp_i  (ext_axi_slave_resp_i)
+    );
+    assign ext_xbar_slave_req_o = '0;
+  end else if (core_v_mini_mcu_pkg::EXT_SLAVE_POSTED_WRITES != 0) begin : gen_ext_slave_posted_write_buffer
+    obi_posted_write_buffer #(
+        .DEPTH(core_v_mini_mcu_pkg::EXT_SLAVE_POSTED_WRITES)
+    ) obi_posted_write_buffer_i (
+        .clk_i,
+        .rst_ni,
+        .slave_req_i  (slave_req[core_v_mini_mcu_pkg::EXT_SLAVE_IDX]),
+        .slave_resp_o (slave_resp[core_v_mini_mcu_pkg::EXT_SLAVE_IDX]),
+        .master_req_o (ext_xbar_slave_req_o),
+        .master_resp_i(ext_xbar_slave_resp_i)
+    );
+  end else begin : gen_ext_slave
+    assign ext_xbar_slave_req_o = slave_req[core_v_mini_mcu_pkg::EXT_SLAVE_IDX];
+    assign slave_resp[core_v_mini_mcu_pkg::EXT_SLAVE_IDX] = ext_xbar_slave_resp_i;
+  end
+
+  if (!core_v_mini_mcu_pkg::EXT_SLAVE_AXI) begin : gen_no_ext_slave_axi
+    assign ext_axi_slave_req_o = '0;
+  end
 
 `ifndef SYNTHESIS
   always_ff @(posedge clk_i, negedge rst_ni) begin : check_out_of_bound
@@ -155,7 +195,9 @@ module system_bus
       .master_req_i(master_req),
       .master_resp_o(master_resp),
       .slave_req_o(slave_req),
-      .slave_resp_i(slave_resp)
+      .slave_resp_i(slave_resp),
+      .qos_override_i(bus_qos_override_i),
+      .qos_priority_i(bus_qos_priority_i)
   );
 
 endmodule
@@ -18,7 +18,11 @@ module system_xbar
     output obi_resp_t [XBAR_NMASTER-1:0] master_resp_o,
 
     output obi_req_t  [XBAR_NSLAVE-1:0] slave_req_o,
-    input  obi_resp_t [XBAR_NSLAVE-1:0] slave_resp_i
+    input  obi_resp_t [XBAR_NSLAVE-1:0] slave_resp_i,
+
+    //Runtime priorities of the system masters, used instead of BUS_QOS_PRIORITY when qos_override_i is set
+    input logic qos_override_i,
+    input logic [SYSTEM_XBAR_NMASTER-1:0][1:0] qos_priority_i
 
 );
 
@@ -61,6 +65,18 @@ module system_xbar
   logic [XBAR_NMASTER-1:0][REQ_AGG_DATA_WIDTH-1:0] master_req_out_data;
   logic [XBAR_NSLAVE-1:0][REQ_AGG_DATA_WIDTH-1:0] slave_req_out_data;
 
+  //Bus QoS, one arbiter per slave with NtoM, a single one in front of the slaves with onetoM
+  localparam int unsigned QOS_NUM_OUT = BUS_TYPE == NtoM ? XBAR_NSLAVE : 1;
+
+  logic [XBAR_NMASTER-1:0][1:0] master_priority;
+  logic [XBAR_NMASTER-1:0][15:0] master_budget;
+  logic [XBAR_NMASTER-1:0] master_over_budget;
+  logic [QOS_NUM_OUT-1:0] qos_out_req;
+  logic [QOS_NUM_OUT-1:0] qos_out_gnt;
+  logic [QOS_NUM_OUT-1:0][LOG_XBAR_NMASTER-1:0] qos_sel;
+  logic [15:0] qos_window_q;
+  logic qos_window_end;
+
   if (BUS_TYPE == NtoM) begin : gen_addr_decoders_NtoM
     for (genvar i = 0; i < XBAR_NMASTER; i++) begin : gen_addr_decoders
       addr_decode #(
@@ -126,11 +142,106 @@ module system_xbar
   end
 
 
+  //Bus QoS
+  //The arbiters of xbar_varlat use external priorities: rr_i gives the index of the master to grant,
+  //which is the requesting master with the highest priority, the ties being broken round-robin.
+  //A master which used its budget of grants in the current window falls to the lowest priority,
+  //so it is still granted when no other master is requesting.
+  assign qos_window_end = qos_window_q == 16'(BUS_QOS_WINDOW - 1);
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_qos_window
+    if (~rst_ni) begin
+      qos_window_q <= '0;
+    end else if (qos_window_end) begin
+      qos_window_q <= '0;
+    end else begin
+      qos_window_q <= qos_window_q + 16'd1;
+    end
+  end
+
+  for (genvar i = 0; i < XBAR_NMASTER; i++) begin : gen_qos_master
+    logic [15:0] grant_cnt_q;
+
+    if (i < SYSTEM_XBAR_NMASTER) begin : gen_system_master
+      assign master_priority[i] = qos_override_i ? qos_priority_i[i] : BUS_QOS_PRIORITY[i];
+      assign master_budget[i]   = 16'(BUS_QOS_BUDGET[i]);
+    end else begin : gen_ext_master
+      assign master_priority[i] = BUS_QOS_EXT_PRIORITY;
+      assign master_budget[i]   = 16'(BUS_QOS_EXT_BUDGET);
+    end
+
+    assign master_over_budget[i] = master_budget[i] != '0 && grant_cnt_q >= master_budget[i];
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin : proc_grant_cnt
+      if (~rst_ni) begin
+        grant_cnt_q <= '0;
+      end else if (qos_window_end) begin
+        grant_cnt_q <= '0;
+      end else if (master_req_req[i] && master_resp_gnt[i] && !master_over_budget[i]) begin
+        grant_cnt_q <= grant_cnt_q + 16'd1;
+      end
+    end
+  end
+
+  for (genvar o = 0; o < QOS_NUM_OUT; o++) begin : gen_qos_arbiter
+    logic [XBAR_NMASTER-1:0] out_master_req;
+    logic [LOG_XBAR_NMASTER-1:0] rr_q;
+    logic [LOG_XBAR_NMASTER-1:0] sel;
+    logic [1:0] best_priority;
+    logic [1:0] eff_priority;
+    logic found;
+    int unsigned idx;
+
+    if (BUS_TYPE == NtoM) begin : gen_NtoM
+      for (genvar i = 0; i < XBAR_NMASTER; i++) begin : gen_out_master_req
+        assign out_master_req[i] = master_req_req[i] && port_sel[i] == LOG_XBAR_NSLAVE'(o);
+      end
+      assign qos_out_req[o] = slave_req_req[o];
+      assign qos_out_gnt[o] = slave_resp_gnt[o];
+    end else begin : gen_1toM
+      assign out_master_req = master_req_req;
+      assign qos_out_req[o] = neck_req_req[o];
+      assign qos_out_gnt[o] = neck_resp_gnt[o];
+    end
+
+    always_comb begin
+      sel = rr_q;
+      best_priority = '0;
+      eff_priority = '0;
+      found = 1'b0;
+      idx = 0;
+      for (int unsigned d = 0; d < XBAR_NMASTER; d++) begin
+        idx = rr_q + d;
+        if (idx >= XBAR_NMASTER) begin
+          idx = idx - XBAR_NMASTER;
+        end
+        eff_priority = master_over_budget[idx] ? 2'd0 : master_priority[idx];
+        if (out_master_req[idx] && (!found || eff_priority > best_priority)) begin
+          found = 1'b1;
+          best_priority = eff_priority;
+          sel = idx[LOG_XBAR_NMASTER-1:0];
+        end
+      end
+    end
+
+    assign qos_sel[o] = sel;
+
+    //the master after the granted one is the first served among equal priorities next time
+    always_ff @(posedge clk_i or negedge rst_ni) begin : proc_rr
+      if (~rst_ni) begin
+        rr_q <= '0;
+      end else if (qos_out_req[o] && qos_out_gnt[o]) begin
+        rr_q <= sel == LOG_XBAR_NMASTER'(XBAR_NMASTER - 1) ? '0 : sel + 1'b1;
+      end
+    end
+  end
+
   if (BUS_TYPE == NtoM) begin : gen_xbar_NtoM
 
     //Crossbar instantiation
     xbar_varlat #(
         .AggregateGnt(1),
+        .ExtPrio(1'b1),
         .NumIn(XBAR_NMASTER),
         .NumOut(XBAR_NSLAVE),
         .ReqDataWidth(REQ_AGG_DATA_WIDTH),
@@ -143,7 +254,7 @@ module system_xbar
         .wdata_i(master_req_out_data),
         .gnt_o  (master_resp_gnt),
         .rdata_o(master_resp_rdata),
-        .rr_i   ('0),
+        .rr_i   (qos_sel),
         .vld_o  (master_resp_rvalid),
         .gnt_i  (slave_resp_gnt),
         .req_o  (slave_req_req),
@@ -156,6 +267,7 @@ module system_xbar
 
     // Nto1 Crossbar instantiation
     xbar_varlat #(
+        .ExtPrio(1'b1),
         .NumIn(XBAR_NMASTER),
         .NumOut(1),
         .ReqDataWidth(REQ_AGG_DATA_WIDTH),
@@ -168,7 +280,7 @@ module system_xbar
         .wdata_i(master_req_out_data),
         .gnt_o  (master_resp_gnt),
         .rdata_o(master_resp_rdata),
-        .rr_i   ('0),
+        .rr_i   (qos_sel),
         .vld_o  (master_resp_rvalid),
         .gnt_i  (neck_resp_gnt),
         .req_o  (neck_req_req),
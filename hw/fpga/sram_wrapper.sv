@@ -27,14 +27,59 @@ module sram_wrapper #(
     output logic [31:0] rdata_o
 );
 
-  xilinx_mem_gen_0 tc_ram_i (
-      .clka (clk_i),
-      .ena  (req_i),
-      .wea  ({4{req_i & we_i}} & be_i),
-      .addra(addr_i),
-      .dina (wdata_i),
-      // output ports
-      .douta(rdata_o)
-  );
+  // xilinx_mem_gen_0 is 8KWords deep (see scripts/generate_sram.tcl), larger banks
+  // are made of several of them and smaller banks only use the lower part of one.
+  localparam int unsigned IpNumWords = 32'd8192;
+  localparam int unsigned IpAddrWidth = $clog2(IpNumWords);
+
+  if (NumWords <= IpNumWords) begin : gen_single_ip
+
+    logic [IpAddrWidth-1:0] ip_addr;
+
+    assign ip_addr = IpAddrWidth'(addr_i);
+
+    xilinx_mem_gen_0 tc_ram_i (
+        .clka (clk_i),
+        .ena  (req_i),
+        .wea  ({4{req_i & we_i}} & be_i),
+        .addra(ip_addr),
+        .dina (wdata_i),
+        // output ports
+        .douta(rdata_o)
+    );
+
+  end else begin : gen_multi_ip
+
+    localparam int unsigned NumIps = NumWords / IpNumWords;
+    localparam int unsigned IpSelWidth = AddrWidth - IpAddrWidth;
+
+    logic [IpSelWidth-1:0] ip_sel, ip_sel_q;
+    logic [NumIps-1:0][31:0] ip_rdata;
+
+    assign ip_sel = addr_i[AddrWidth-1:IpAddrWidth];
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+      if (!rst_ni) begin
+        ip_sel_q <= '0;
+      end else if (req_i) begin
+        ip_sel_q <= ip_sel;
+      end
+    end
+
+    for (genvar i = 0; i < NumIps; i++) begin : gen_ip
+      xilinx_mem_gen_0 tc_ram_i (
+          .clka (clk_i),
+          .ena  (req_i && ip_sel == i),
+          .wea  ({4{req_i & we_i}} & be_i),
+          .addra(addr_i[IpAddrWidth-1:0]),
+          .dina (wdata_i),
+          // output ports
+          .douta(ip_rdata[i])
+      );
+    end
+
+    assign rdata_o = ip_rdata[ip_sel_q];
+
+  end
 
 endmodule
@@ -115,6 +115,8 @@ module xilinx_core_v_mini_mcu_wrapper
       .ext_xbar_master_resp_o(),
       .ext_xbar_slave_req_o(),
       .ext_xbar_slave_resp_i('0),
+      .ext_axi_slave_req_o(),
+      .ext_axi_slave_resp_i('0),
       .ext_peripheral_slave_req_o(),
       .ext_peripheral_slave_resp_i('0),
       .external_subsystem_powergate_switch_o(),
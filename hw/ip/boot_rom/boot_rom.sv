@@ -22,66 +22,124 @@ module boot_rom
 );
   import core_v_mini_mcu_pkg::*;
 
-  localparam int unsigned RomSize = 59;
+  localparam int unsigned RomSize = 117;
 
   logic [RomSize-1:0][31:0] mem;
   assign mem = {
     32'h00009602,
     32'h49902000,
-    32'h05b7f2e9,
-    32'hf0068693,
-    32'hff7493e3,
-    32'hfec49be3,
-    32'h04910114,
-    32'ha0230285,
-    32'ha8830204,
-    32'h8613dfed,
-    32'h8b8583d1,
-    32'h49dc1004,
-    32'h8b93fe07,
-    32'hdfe349dc,
-    32'h00010355,
-    32'ha2230ff4,
-    32'h0a930800,
-    32'h043700db,
-    32'h46630ff4,
-    32'h0a930900,
-    32'h04371000,
-    32'h0b134481,
-    32'h40000693,
-    32'hfe07dfe3,
-    32'h49dc0001,
+    32'h05b7bf41,
+    32'hfe0319e3,
+    32'h137d0605,
+    32'h0f8501e6,
+    32'h0023000f,
+    32'hcf030311,
+    32'hffdf0ce3,
+    32'h937a0505,
+    32'h00054f03,
+    32'h00731863,
+    32'h00f2f313,
+    32'h41e60fb3,
+    32'h01ff6f33,
+    32'h0fa20509,
+    32'h00154f83,
+    32'h00054f03,
+    32'h04b57163,
+    32'hfe0319e3,
+    32'h137d0605,
+    32'h050501e6,
+    32'h00230005,
+    32'h4f030003,
+    32'h0b63ffdf,
+    32'h0ce3937a,
+    32'h05050005,
+    32'h4f030073,
+    32'h18630042,
+    32'hd3130505,
+    32'h00054283,
+    32'h0ff00e93,
+    32'h43bd4601,
+    32'h010e05b3,
+    32'h8572080e,
+    32'h0263c258,
+    32'h47212007,
+    32'h06370006,
+    32'h2c23ca18,
+    32'h4711df7d,
+    32'h4658d1d8,
+    32'h177d9736,
+    32'h08000737,
+    32'hfe075fe3,
+    32'h49d80001,
     32'hd1d8070d,
     32'h11000737,
     32'hfe075fe3,
     32'h49d80001,
-    32'hd5d8470d,
-    32'hfe075fe3,
-    32'h49d8d1d8,
-    32'h070d1000,
-    32'h0737d5d8,
-    32'h0ab00713,
-    32'hc9980087,
-    32'h6713f007,
-    32'h77134998,
-    32'hd1884501,
-    32'hcd980705,
-    32'h0fff0737,
-    32'hc9988f49,
-    32'h4998a000,
-    32'h05372002,
-    32'h05b79582,
-    32'h18058593,
-    32'h400005b7,
+    32'h0315a623,
+    32'hc614ce18,
+    32'h47110006,
+    32'h282301c6,
+    32'h2223c218,
+    32'h02858713,
+    32'h20060637,
+    32'h088d7c01,
+    32'h08b79af1,
+    32'h00380693,
+    32'hffce7e13,
+    32'h00378e13,
+    32'h00a71c63,
+    32'h54850513,
+    32'h5a454537,
+    32'ha00d9af1,
+    32'h00378693,
+    32'h00a71663,
+    32'h0285a803,
+    32'hfe084de3,
+    32'h081e0145,
+    32'ha803559c,
+    32'hfe07cee3,
+    32'h079e49dc,
+    32'h5598fe07,
+    32'hcee3079e,
+    32'h49dc5485,
+    32'h05135045,
+    32'h45374e01,
+    32'h488d4000,
+    32'h0693d1d8,
+    32'h072d0800,
+    32'h0737fe07,
+    32'h5fe349d8,
+    32'h0001d1d8,
+    32'h070d1100,
+    32'h0737fe07,
+    32'h5fe349d8,
+    32'h0001d5d8,
+    32'h070d7001,
+    32'h0737fe07,
+    32'h5fe349d8,
+    32'hd1d8070d,
+    32'h10000737,
+    32'hd5d80ab0,
+    32'h0713d188,
+    32'h4501cd98,
+    32'h07050fff,
+    32'h0737c998,
+    32'h8f494998,
+    32'ha0000537,
+    32'h200205b7,
+    32'h95821805,
+    32'h85934000,
+    32'h05b7cdc8,
     32'hc1884505,
     32'h200285b7,
-    32'hc9110145,
+    32'hc9190145,
     32'hc5039582,
-    32'h498cd175,
+    32'h498cd165,
     32'h00c5c503,
     32'he5110085,
     32'hc5032000,
-    32'h05b79502,
+    32'h05b73200,
+    32'h50739502,
     32'h41c8c119,
     32'h0005c503,
     32'h200405b7
@@ -26,6 +26,11 @@ module dma #(
 
     input logic [SLOT_NUM-1:0] trigger_slot_i,
 
+    // Start from the hardware (e.g. an event system), of ext_size_i bytes, ignored when busy
+    // or when not enabled in EXT_START
+    input logic        ext_start_i,
+    input logic [31:0] ext_size_i,
+
     output dma_intr_o
 );
 
@@ -43,6 +48,7 @@ module dma #(
   logic        [               31:0] dma_cnt;
   logic        [               31:0] dma_cnt_dec;
   logic                              dma_start;
+  logic        [               31:0] dma_size;
   logic                              dma_done;
 
   logic        [Addr_Fifo_Depth-1:0] fifo_usage;
@@ -73,12 +79,50 @@ module dma #(
   logic                              wait_for_tx;
 
   logic        [                1:0] data_type;
-
+  logic        [                1:0] dst_data_type;
+  logic                              extend_en;
+  logic                              sign_ext;
+  logic                              fill_en;
+  logic        [               31:0] fill_data;
+
+  logic        [                2:0] src_data_bytes;
+  logic        [                2:0] dst_data_bytes;
+  logic        [                1:0] src_data_shift;
+  logic        [                1:0] dst_data_shift;
+
+  logic        [               31:0] read_cnt_valid;
+  logic        [               31:0] write_cnt;
+  logic        [               31:0] write_cnt_init;
+  logic        [                2:0] write_bytes;
+
+  logic        [               31:0] data_in_shifted;
+  logic        [               31:0] data_in_elem;
+
+  logic                              pack_en;
+  logic                              pack_last;
+  logic        [               31:0] pack_data;
+  logic        [                1:0] pack_offset;
+
+  logic                              unpack_en;
+  logic                              unpack_last;
+  logic        [                1:0] unpack_offset;
+
+  logic                              fifo_push;
+  logic                              fifo_pop;
   logic        [               31:0] fifo_input;
   logic        [               31:0] fifo_output;
+  logic        [               31:0] fifo_output_sel;
 
   logic        [                3:0] byte_enable_out;
 
+  logic                              stat_clear;
+  logic                              slot_stall;
+  logic        [               31:0] stat_bytes;
+  logic        [               31:0] stat_busy;
+  logic        [               31:0] stat_slot_stall;
+  logic        [               31:0] stat_read_stall;
+  logic        [               31:0] stat_write_stall;
+
   enum logic {
     DMA_READ_FSM_IDLE,
     DMA_READ_FSM_ON
@@ -113,6 +157,10 @@ module dma #(
 
   assign dma_intr_o = dma_done;
   assign data_type = reg2hw.data_type.q;
+  assign dst_data_type = reg2hw.dst_data_type.q;
+  assign extend_en = reg2hw.extend.en.q;
+  assign sign_ext = reg2hw.extend.sign_ext.q;
+  assign fill_en = reg2hw.fill.q;
 
   assign hw2reg.done.de = dma_done | dma_start;
   assign hw2reg.done.d = dma_done == 1'b1 ? 1'b1 : 1'b0;
@@ -125,15 +173,71 @@ module dma #(
 
   assign fifo_alm_full = (fifo_usage == LastFifoUsage[Addr_Fifo_Depth-1:0]);
 
-  // DMA pulse start when dma_start register is written
+  assign hw2reg.stat_bytes.d = stat_bytes;
+  assign hw2reg.stat_busy.d = stat_busy;
+  assign hw2reg.stat_slot_stall.d = stat_slot_stall;
+  assign hw2reg.stat_read_stall.d = stat_read_stall;
+  assign hw2reg.stat_write_stall.d = stat_write_stall;
+
+  assign stat_clear = reg2hw.stat_clear.qe & reg2hw.stat_clear.q;
+
+  // A master has something to transfer but its trigger slot is not ready
+  assign slot_stall = (dma_read_fsm_state == DMA_READ_FSM_ON && |dma_cnt == 1'b1 &&
+                       fifo_full == 1'b0 && fifo_alm_full == 1'b0 && wait_for_rx == 1'b1) ||
+                      (dma_write_fsm_state == DMA_WRITE_FSM_ON && wait_for_tx == 1'b1 &&
+                       (fill_en == 1'b1 ? |write_cnt : ~fifo_empty));
+
+  // Performance counters, they keep counting across transfers until cleared
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_stat_reg
+    if (~rst_ni) begin
+      stat_bytes       <= '0;
+      stat_busy        <= '0;
+      stat_slot_stall  <= '0;
+      stat_read_stall  <= '0;
+      stat_write_stall <= '0;
+    end else begin
+      if (stat_clear == 1'b1) begin
+        stat_bytes       <= '0;
+        stat_busy        <= '0;
+        stat_slot_stall  <= '0;
+        stat_read_stall  <= '0;
+        stat_write_stall <= '0;
+      end else begin
+        if (data_out_gnt == 1'b1) begin
+          stat_bytes <= stat_bytes + {29'h0, write_bytes};
+        end
+        if (dma_read_fsm_state == DMA_READ_FSM_ON || dma_write_fsm_state == DMA_WRITE_FSM_ON) begin
+          stat_busy <= stat_busy + 32'h1;
+        end
+        if (slot_stall == 1'b1) begin
+          stat_slot_stall <= stat_slot_stall + 32'h1;
+        end
+        if (data_in_req == 1'b1 && data_in_gnt == 1'b0) begin
+          stat_read_stall <= stat_read_stall + 32'h1;
+        end
+        if (data_out_req == 1'b1 && data_out_gnt == 1'b0) begin
+          stat_write_stall <= stat_write_stall + 32'h1;
+        end
+      end
+    end
+  end
+
+  // DMA pulse start when dma_start register is written, or on the external start when enabled and idle
   always_ff @(posedge clk_i or negedge rst_ni) begin : proc_dma_start
     if (~rst_ni) begin
       dma_start <= 1'b0;
+      dma_size  <= '0;
     end else begin
       if (dma_start == 1'b1) begin
         dma_start <= 1'b0;
-      end else begin
-        dma_start <= |reg2hw.dma_start.q;
+      end else if (|reg2hw.dma_start.q == 1'b1) begin
+        dma_start <= 1'b1;
+        dma_size  <= reg2hw.dma_start.q;
+      end else if (reg2hw.ext_start.q == 1'b1 && ext_start_i == 1'b1 && |ext_size_i == 1'b1 &&
+                   dma_read_fsm_state == DMA_READ_FSM_IDLE &&
+                   dma_write_fsm_state == DMA_WRITE_FSM_IDLE) begin
+        dma_start <= 1'b1;
+        dma_size  <= ext_size_i;
       end
     end
   end
@@ -183,88 +287,161 @@ module dma #(
       dma_cnt <= '0;
     end else begin
       if (dma_start == 1'b1) begin
-        dma_cnt <= reg2hw.dma_start.q;
+        dma_cnt <= fill_en ? '0 : dma_size;
       end else if (data_in_gnt == 1'b1) begin
         dma_cnt <= dma_cnt - dma_cnt_dec;
       end
     end
   end
 
+  // Store the number of bytes still expected from the read master (decremented on rvalid)
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_read_cnt_valid_reg
+    if (~rst_ni) begin
+      read_cnt_valid <= '0;
+    end else begin
+      if (dma_start == 1'b1) begin
+        read_cnt_valid <= fill_en ? '0 : dma_size;
+      end else if (data_in_rvalid == 1'b1) begin
+        read_cnt_valid <= read_cnt_valid - dma_cnt_dec;
+      end
+    end
+  end
+
+  // Store the number of bytes to be written and decrement it everytime write request is granted
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_write_cnt_reg
+    if (~rst_ni) begin
+      write_cnt <= '0;
+    end else begin
+      if (dma_start == 1'b1) begin
+        write_cnt <= write_cnt_init;
+      end else if (data_out_gnt == 1'b1) begin
+        write_cnt <= write_cnt - {29'h0, write_bytes};
+      end
+    end
+  end
+
+  // Data type 00 Word, 01 Half word, 11,10 byte
   always_comb begin
     case (data_type)
-      2'b00: dma_cnt_dec = 32'h4;
-      2'b01: dma_cnt_dec = 32'h2;
-      2'b10, 2'b11: dma_cnt_dec = 32'h1;
+      2'b00: src_data_shift = 2'd2;
+      2'b01: src_data_shift = 2'd1;
+      2'b10, 2'b11: src_data_shift = 2'd0;
     endcase
   end
 
-  always_comb begin : proc_byte_enable_out
-    case (data_type)  // Data type 00 Word, 01 Half word, 11,10 byte
-      2'b00: byte_enable_out = 4'b1111;  // Writing a word (32 bits)
-
-      2'b01: begin  // Writing a half-word (16 bits)
-        case (write_ptr_reg[1])
-          1'b0: byte_enable_out = 4'b0011;
-          1'b1: byte_enable_out = 4'b1100;
-        endcase
-        ;  // case(write_ptr_reg[1:0])
-      end
-
-      2'b10, 2'b11: begin  // Writing a byte (8 bits)
-        case (write_ptr_reg[1:0])
-          2'b00: byte_enable_out = 4'b0001;
-          2'b01: byte_enable_out = 4'b0010;
-          2'b10: byte_enable_out = 4'b0100;
-          2'b11: byte_enable_out = 4'b1000;
-        endcase
-        ;  // case(write_ptr_reg[1:0])
-      end
+  always_comb begin
+    case (dst_data_type)
+      2'b00: dst_data_shift = 2'd2;
+      2'b01: dst_data_shift = 2'd1;
+      2'b10, 2'b11: dst_data_shift = 2'd0;
     endcase
-    ;  // case (data_type)
   end
 
-  // Output data shift
-  always_comb begin : proc_output_data
+  assign src_data_bytes = 3'b001 << src_data_shift;
+  assign dst_data_bytes = 3'b001 << dst_data_shift;
 
-    data_out_wdata[7:0]   = fifo_output[7:0];
-    data_out_wdata[15:8]  = fifo_output[15:8];
-    data_out_wdata[23:16] = fifo_output[23:16];
-    data_out_wdata[31:24] = fifo_output[31:24];
+  assign dma_cnt_dec = {29'h0, src_data_bytes};
 
-    case (write_ptr_reg[1:0])
-      2'b00: ;
+  // In extend mode every source element becomes one destination element,
+  // otherwise the same number of bytes is read and written (or filled)
+  assign write_cnt_init = (extend_en & ~fill_en) ?
+      ((dma_size >> src_data_shift) << dst_data_shift) : dma_size;
 
-      2'b01: data_out_wdata[15:8] = fifo_output[7:0];
+  // Pack narrow source elements into wider destination elements
+  assign pack_en = ~extend_en & (src_data_bytes < dst_data_bytes);
+  // Unpack wide source elements into narrower destination elements
+  assign unpack_en = ~extend_en & (dst_data_bytes < src_data_bytes);
 
-      2'b10: begin
-        data_out_wdata[23:16] = fifo_output[7:0];
-        data_out_wdata[31:24] = fifo_output[15:8];
-      end
+  // Last source element of a destination element (or of the whole transfer)
+  assign pack_last = ({1'b0, pack_offset} + src_data_bytes == dst_data_bytes) ||
+                     (read_cnt_valid <= dma_cnt_dec);
+  // Last destination element of a source element (or of the whole transfer)
+  assign unpack_last = ({1'b0, unpack_offset} + dst_data_bytes == src_data_bytes) ||
+                       (write_cnt <= {29'h0, dst_data_bytes});
+
+  assign fifo_push = data_in_rvalid & (~pack_en | pack_last);
+  assign fifo_pop = data_out_gnt & ~fill_en & (~unpack_en | unpack_last);
+
+  // Bytes written by the current request (less than the destination type only at the end)
+  assign write_bytes = (write_cnt < {29'h0, dst_data_bytes}) ? write_cnt[2:0] : dst_data_bytes;
+
+  always_comb begin : proc_byte_enable_out
+    case (write_bytes)
+      3'd1: byte_enable_out = 4'b0001;
+      3'd2: byte_enable_out = 4'b0011;
+      3'd3: byte_enable_out = 4'b0111;
+      default: byte_enable_out = 4'b1111;
+    endcase
+    // Half words and bytes are placed on their lane
+    if (write_bytes != 3'd4) begin
+      byte_enable_out = byte_enable_out << write_ptr_reg[1:0];
+    end
+  end
 
-      2'b11: data_out_wdata[31:24] = fifo_output[7:0];
+  // Output data shift: select the element to write and move it to its byte lane
+  assign fifo_output_sel = fifo_output >> {unpack_offset, 3'b000};
+  assign data_out_wdata = fill_en ? fill_data : fifo_output_sel << {write_ptr_reg[1:0], 3'b000};
+
+  // Fill pattern replicated on all the byte lanes, the byte enable selects the ones written
+  always_comb begin : proc_fill_data
+    case (dst_data_type)
+      2'b00: fill_data = reg2hw.fill_pattern.q;
+      2'b01: fill_data = {2{reg2hw.fill_pattern.q[15:0]}};
+      2'b10, 2'b11: fill_data = {4{reg2hw.fill_pattern.q[7:0]}};
     endcase
   end
 
   // Input data shift: shift the input data to be on the LSB of the fifo
-  always_comb begin : proc_input_data
+  assign data_in_shifted = data_in_rdata >> {read_ptr_valid_reg[1:0], 3'b000};
 
-    fifo_input[7:0]   = data_in_rdata[7:0];
-    fifo_input[15:8]  = data_in_rdata[15:8];
-    fifo_input[23:16] = data_in_rdata[23:16];
-    fifo_input[31:24] = data_in_rdata[31:24];
-
-    case (read_ptr_valid_reg[1:0])
+  // Keep only the source element and extend it if required
+  always_comb begin : proc_input_data
+    data_in_elem = data_in_shifted;
+    case (data_type)
       2'b00: ;
+      2'b01: data_in_elem[31:16] = {16{extend_en & sign_ext & data_in_shifted[15]}};
+      2'b10, 2'b11: data_in_elem[31:8] = {24{extend_en & sign_ext & data_in_shifted[7]}};
+    endcase
+  end
 
-      2'b01: fifo_input[7:0] = data_in_rdata[15:8];
+  assign fifo_input = pack_en ? pack_data | (data_in_elem << {pack_offset, 3'b000}) : data_in_elem;
 
-      2'b10: begin
-        fifo_input[7:0]  = data_in_rdata[23:16];
-        fifo_input[15:8] = data_in_rdata[31:24];
+  // Gather source elements until a destination element is complete
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_pack_reg
+    if (~rst_ni) begin
+      pack_data   <= '0;
+      pack_offset <= '0;
+    end else begin
+      if (dma_start == 1'b1) begin
+        pack_data   <= '0;
+        pack_offset <= '0;
+      end else if (data_in_rvalid == 1'b1 && pack_en == 1'b1) begin
+        if (pack_last == 1'b1) begin
+          pack_data   <= '0;
+          pack_offset <= '0;
+        end else begin
+          pack_data   <= fifo_input;
+          pack_offset <= pack_offset + src_data_bytes[1:0];
+        end
       end
+    end
+  end
 
-      2'b11: fifo_input[7:0] = data_in_rdata[31:24];
-    endcase
+  // Track which part of the current fifo element is written
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_unpack_reg
+    if (~rst_ni) begin
+      unpack_offset <= '0;
+    end else begin
+      if (dma_start == 1'b1) begin
+        unpack_offset <= '0;
+      end else if (data_out_gnt == 1'b1 && unpack_en == 1'b1) begin
+        if (unpack_last == 1'b1) begin
+          unpack_offset <= '0;
+        end else begin
+          unpack_offset <= unpack_offset + dst_data_bytes[1:0];
+        end
+      end
+    end
   end
 
   // FSM state update
@@ -294,7 +471,8 @@ module dma #(
 
       DMA_READ_FSM_IDLE: begin
         // Wait for start signal
-        if (dma_start == 1'b1) begin
+        // Nothing to read in fill mode
+        if (dma_start == 1'b1 && fill_en == 1'b0) begin
           dma_read_fsm_n_state = DMA_READ_FSM_ON;
           fifo_flush = 1'b1;
         end else begin
@@ -343,14 +521,16 @@ module dma #(
       end
       // Read one word
       DMA_WRITE_FSM_ON: begin
-        // If all input data read exit
-        if (fifo_empty == 1'b1 && dma_read_fsm_state == DMA_READ_FSM_IDLE) begin
+        // If all input data read and written exit (all the pattern written in fill mode)
+        if (fill_en == 1'b1 ? |write_cnt == 1'b0 :
+            (fifo_empty == 1'b1 && dma_read_fsm_state == DMA_READ_FSM_IDLE &&
+             |read_cnt_valid == 1'b0)) begin
           dma_write_fsm_n_state = DMA_WRITE_FSM_IDLE;
           dma_done = 1'b1;
         end else begin
           dma_write_fsm_n_state = DMA_WRITE_FSM_ON;
           // Wait if fifo is empty or if the SPI TX is not ready for new data (only in SPI mode 2).
-          if (fifo_empty == 1'b0 && wait_for_tx == 1'b0) begin
+          if ((fifo_empty == 1'b0 || fill_en == 1'b1) && wait_for_tx == 1'b0) begin
             data_out_req  = 1'b1;
             data_out_we   = 1'b1;
             data_out_be   = byte_enable_out;
@@ -374,10 +554,10 @@ module dma #(
       .usage_o(fifo_usage),
       // as long as the queue is not full we can push new data
       .data_i(fifo_input),
-      .push_i(data_in_rvalid),
+      .push_i(fifo_push),
       // as long as the queue is not empty we can pop new elements
       .data_o(fifo_output),
-      .pop_i(data_out_gnt)
+      .pop_i(fifo_pop)
   );
 
   dma_reg_top #(
@@ -7,7 +7,7 @@
 package dma_reg_pkg;
 
   // Address widths within the block
-  parameter int BlockAw = 5;
+  parameter int BlockAw = 7;
 
   ////////////////////////////
   // Typedefs for registers //
@@ -30,6 +30,24 @@ package dma_reg_pkg;
 
   typedef struct packed {logic [1:0] q;} dma_reg2hw_data_type_reg_t;
 
+  typedef struct packed {logic [1:0] q;} dma_reg2hw_dst_data_type_reg_t;
+
+  typedef struct packed {
+    struct packed {logic q;} en;
+    struct packed {logic q;} sign_ext;
+  } dma_reg2hw_extend_reg_t;
+
+  typedef struct packed {logic q;} dma_reg2hw_fill_reg_t;
+
+  typedef struct packed {logic [31:0] q;} dma_reg2hw_fill_pattern_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic qe;
+  } dma_reg2hw_stat_clear_reg_t;
+
+  typedef struct packed {logic q;} dma_reg2hw_ext_start_reg_t;
+
   typedef struct packed {
     logic [31:0] d;
     logic        de;
@@ -40,32 +58,71 @@ package dma_reg_pkg;
     logic de;
   } dma_hw2reg_done_reg_t;
 
+  typedef struct packed {logic [31:0] d;} dma_hw2reg_stat_bytes_reg_t;
+
+  typedef struct packed {logic [31:0] d;} dma_hw2reg_stat_busy_reg_t;
+
+  typedef struct packed {logic [31:0] d;} dma_hw2reg_stat_slot_stall_reg_t;
+
+  typedef struct packed {logic [31:0] d;} dma_hw2reg_stat_read_stall_reg_t;
+
+  typedef struct packed {logic [31:0] d;} dma_hw2reg_stat_write_stall_reg_t;
+
   // Register -> HW type
   typedef struct packed {
-    dma_reg2hw_ptr_in_reg_t ptr_in;  // [193:162]
-    dma_reg2hw_ptr_out_reg_t ptr_out;  // [161:130]
-    dma_reg2hw_dma_start_reg_t dma_start;  // [129:98]
-    dma_reg2hw_src_ptr_inc_reg_t src_ptr_inc;  // [97:66]
-    dma_reg2hw_dst_ptr_inc_reg_t dst_ptr_inc;  // [65:34]
-    dma_reg2hw_slot_reg_t slot;  // [33:2]
-    dma_reg2hw_data_type_reg_t data_type;  // [1:0]
+    dma_reg2hw_ptr_in_reg_t ptr_in;  // [233:202]
+    dma_reg2hw_ptr_out_reg_t ptr_out;  // [201:170]
+    dma_reg2hw_dma_start_reg_t dma_start;  // [169:138]
+    dma_reg2hw_src_ptr_inc_reg_t src_ptr_inc;  // [137:106]
+    dma_reg2hw_dst_ptr_inc_reg_t dst_ptr_inc;  // [105:74]
+    dma_reg2hw_slot_reg_t slot;  // [73:42]
+    dma_reg2hw_data_type_reg_t data_type;  // [41:40]
+    dma_reg2hw_dst_data_type_reg_t dst_data_type;  // [39:38]
+    dma_reg2hw_extend_reg_t extend;  // [37:36]
+    dma_reg2hw_fill_reg_t fill;  // [35:35]
+    dma_reg2hw_fill_pattern_reg_t fill_pattern;  // [34:3]
+    dma_reg2hw_stat_clear_reg_t stat_clear;  // [2:1]
+    dma_reg2hw_ext_start_reg_t ext_start;  // [0:0]
   } dma_reg2hw_t;
 
   // HW -> register type
   typedef struct packed {
-    dma_hw2reg_dma_start_reg_t dma_start;  // [34:2]
-    dma_hw2reg_done_reg_t done;  // [1:0]
+    dma_hw2reg_dma_start_reg_t dma_start;  // [194:162]
+    dma_hw2reg_done_reg_t done;  // [161:160]
+    dma_hw2reg_stat_bytes_reg_t stat_bytes;  // [159:128]
+    dma_hw2reg_stat_busy_reg_t stat_busy;  // [127:96]
+    dma_hw2reg_stat_slot_stall_reg_t stat_slot_stall;  // [95:64]
+    dma_hw2reg_stat_read_stall_reg_t stat_read_stall;  // [63:32]
+    dma_hw2reg_stat_write_stall_reg_t stat_write_stall;  // [31:0]
   } dma_hw2reg_t;
 
   // Register offsets
-  parameter logic [BlockAw-1:0] DMA_PTR_IN_OFFSET = 5'h0;
-  parameter logic [BlockAw-1:0] DMA_PTR_OUT_OFFSET = 5'h4;
-  parameter logic [BlockAw-1:0] DMA_DMA_START_OFFSET = 5'h8;
-  parameter logic [BlockAw-1:0] DMA_DONE_OFFSET = 5'hc;
-  parameter logic [BlockAw-1:0] DMA_SRC_PTR_INC_OFFSET = 5'h10;
-  parameter logic [BlockAw-1:0] DMA_DST_PTR_INC_OFFSET = 5'h14;
-  parameter logic [BlockAw-1:0] DMA_SLOT_OFFSET = 5'h18;
-  parameter logic [BlockAw-1:0] DMA_DATA_TYPE_OFFSET = 5'h1c;
+  parameter logic [BlockAw-1:0] DMA_PTR_IN_OFFSET = 7'h0;
+  parameter logic [BlockAw-1:0] DMA_PTR_OUT_OFFSET = 7'h4;
+  parameter logic [BlockAw-1:0] DMA_DMA_START_OFFSET = 7'h8;
+  parameter logic [BlockAw-1:0] DMA_DONE_OFFSET = 7'hc;
+  parameter logic [BlockAw-1:0] DMA_SRC_PTR_INC_OFFSET = 7'h10;
+  parameter logic [BlockAw-1:0] DMA_DST_PTR_INC_OFFSET = 7'h14;
+  parameter logic [BlockAw-1:0] DMA_SLOT_OFFSET = 7'h18;
+  parameter logic [BlockAw-1:0] DMA_DATA_TYPE_OFFSET = 7'h1c;
+  parameter logic [BlockAw-1:0] DMA_DST_DATA_TYPE_OFFSET = 7'h20;
+  parameter logic [BlockAw-1:0] DMA_EXTEND_OFFSET = 7'h24;
+  parameter logic [BlockAw-1:0] DMA_FILL_OFFSET = 7'h28;
+  parameter logic [BlockAw-1:0] DMA_FILL_PATTERN_OFFSET = 7'h2c;
+  parameter logic [BlockAw-1:0] DMA_STAT_BYTES_OFFSET = 7'h30;
+  parameter logic [BlockAw-1:0] DMA_STAT_BUSY_OFFSET = 7'h34;
+  parameter logic [BlockAw-1:0] DMA_STAT_SLOT_STALL_OFFSET = 7'h38;
+  parameter logic [BlockAw-1:0] DMA_STAT_READ_STALL_OFFSET = 7'h3c;
+  parameter logic [BlockAw-1:0] DMA_STAT_WRITE_STALL_OFFSET = 7'h40;
+  parameter logic [BlockAw-1:0] DMA_STAT_CLEAR_OFFSET = 7'h44;
+  parameter logic [BlockAw-1:0] DMA_EXT_START_OFFSET = 7'h48;
+
+  // Reset values for hwext registers and their fields
+  parameter logic [31:0] DMA_STAT_BYTES_RESVAL = 32'h0;
+  parameter logic [31:0] DMA_STAT_BUSY_RESVAL = 32'h0;
+  parameter logic [31:0] DMA_STAT_SLOT_STALL_RESVAL = 32'h0;
+  parameter logic [31:0] DMA_STAT_READ_STALL_RESVAL = 32'h0;
+  parameter logic [31:0] DMA_STAT_WRITE_STALL_RESVAL = 32'h0;
 
   // Register index
   typedef enum int {
@@ -76,19 +133,41 @@ package dma_reg_pkg;
     DMA_SRC_PTR_INC,
     DMA_DST_PTR_INC,
     DMA_SLOT,
-    DMA_DATA_TYPE
+    DMA_DATA_TYPE,
+    DMA_DST_DATA_TYPE,
+    DMA_EXTEND,
+    DMA_FILL,
+    DMA_FILL_PATTERN,
+    DMA_STAT_BYTES,
+    DMA_STAT_BUSY,
+    DMA_STAT_SLOT_STALL,
+    DMA_STAT_READ_STALL,
+    DMA_STAT_WRITE_STALL,
+    DMA_STAT_CLEAR,
+    DMA_EXT_START
   } dma_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] DMA_PERMIT[8] = '{
-      4'b1111,  // index[0] DMA_PTR_IN
-      4'b1111,  // index[1] DMA_PTR_OUT
-      4'b1111,  // index[2] DMA_DMA_START
-      4'b0001,  // index[3] DMA_DONE
-      4'b1111,  // index[4] DMA_SRC_PTR_INC
-      4'b1111,  // index[5] DMA_DST_PTR_INC
-      4'b1111,  // index[6] DMA_SLOT
-      4'b0001  // index[7] DMA_DATA_TYPE
+  parameter logic [3:0] DMA_PERMIT[19] = '{
+      4'b1111,  // index[ 0] DMA_PTR_IN
+      4'b1111,  // index[ 1] DMA_PTR_OUT
+      4'b1111,  // index[ 2] DMA_DMA_START
+      4'b0001,  // index[ 3] DMA_DONE
+      4'b1111,  // index[ 4] DMA_SRC_PTR_INC
+      4'b1111,  // index[ 5] DMA_DST_PTR_INC
+      4'b1111,  // index[ 6] DMA_SLOT
+      4'b0001,  // index[ 7] DMA_DATA_TYPE
+      4'b0001,  // index[ 8] DMA_DST_DATA_TYPE
+      4'b0001,  // index[ 9] DMA_EXTEND
+      4'b0001,  // index[10] DMA_FILL
+      4'b1111,  // index[11] DMA_FILL_PATTERN
+      4'b1111,  // index[12] DMA_STAT_BYTES
+      4'b1111,  // index[13] DMA_STAT_BUSY
+      4'b1111,  // index[14] DMA_STAT_SLOT_STALL
+      4'b1111,  // index[15] DMA_STAT_READ_STALL
+      4'b1111,  // index[16] DMA_STAT_WRITE_STALL
+      4'b0001,  // index[17] DMA_STAT_CLEAR
+      4'b0001  // index[18] DMA_EXT_START
   };
 
 endpackage
@@ -10,7 +10,7 @@
 module dma_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 5
+    parameter int AW = 7
 ) (
     input logic clk_i,
     input logic rst_ni,
@@ -93,6 +93,36 @@ module dma_reg_top #(
   logic [1:0] data_type_qs;
   logic [1:0] data_type_wd;
   logic data_type_we;
+  logic [1:0] dst_data_type_qs;
+  logic [1:0] dst_data_type_wd;
+  logic dst_data_type_we;
+  logic extend_en_qs;
+  logic extend_en_wd;
+  logic extend_en_we;
+  logic extend_sign_ext_qs;
+  logic extend_sign_ext_wd;
+  logic extend_sign_ext_we;
+  logic fill_qs;
+  logic fill_wd;
+  logic fill_we;
+  logic [31:0] fill_pattern_qs;
+  logic [31:0] fill_pattern_wd;
+  logic fill_pattern_we;
+  logic [31:0] stat_bytes_qs;
+  logic stat_bytes_re;
+  logic [31:0] stat_busy_qs;
+  logic stat_busy_re;
+  logic [31:0] stat_slot_stall_qs;
+  logic stat_slot_stall_re;
+  logic [31:0] stat_read_stall_qs;
+  logic stat_read_stall_re;
+  logic [31:0] stat_write_stall_qs;
+  logic stat_write_stall_re;
+  logic stat_clear_wd;
+  logic stat_clear_we;
+  logic ext_start_qs;
+  logic ext_start_wd;
+  logic ext_start_we;
 
   // Register instances
   // R[ptr_in]: V(False)
@@ -337,9 +367,277 @@ module dma_reg_top #(
   );
 
 
+  // R[dst_data_type]: V(False)
+
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_dst_data_type (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(dst_data_type_we),
+      .wd(dst_data_type_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.dst_data_type.q),
+
+      // to register interface (read)
+      .qs(dst_data_type_qs)
+  );
+
+
+  // R[extend]: V(False)
+
+  //   F[en]: 0:0
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_extend_en (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(extend_en_we),
+      .wd(extend_en_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.extend.en.q),
+
+      // to register interface (read)
+      .qs(extend_en_qs)
+  );
+
+
+  //   F[sign_ext]: 1:1
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_extend_sign_ext (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(extend_sign_ext_we),
+      .wd(extend_sign_ext_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.extend.sign_ext.q),
+
+      // to register interface (read)
+      .qs(extend_sign_ext_qs)
+  );
+
+
+  // R[fill]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_fill (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fill_we),
+      .wd(fill_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fill.q),
+
+      // to register interface (read)
+      .qs(fill_qs)
+  );
+
+
+  // R[fill_pattern]: V(False)
+
+  prim_subreg #(
+      .DW      (32),
+      .SWACCESS("RW"),
+      .RESVAL  (32'h0)
+  ) u_fill_pattern (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(fill_pattern_we),
+      .wd(fill_pattern_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.fill_pattern.q),
+
+      // to register interface (read)
+      .qs(fill_pattern_qs)
+  );
+
+
+  // R[stat_bytes]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_stat_bytes (
+      .re (stat_bytes_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.stat_bytes.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (stat_bytes_qs)
+  );
+
+
+  // R[stat_busy]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_stat_busy (
+      .re (stat_busy_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.stat_busy.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (stat_busy_qs)
+  );
+
+
+  // R[stat_slot_stall]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_stat_slot_stall (
+      .re (stat_slot_stall_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.stat_slot_stall.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (stat_slot_stall_qs)
+  );
+
+
+  // R[stat_read_stall]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_stat_read_stall (
+      .re (stat_read_stall_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.stat_read_stall.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (stat_read_stall_qs)
+  );
+
+
+  // R[stat_write_stall]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_stat_write_stall (
+      .re (stat_write_stall_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.stat_write_stall.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (stat_write_stall_qs)
+  );
+
+
+  // R[stat_clear]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("WO"),
+      .RESVAL  (1'h0)
+  ) u_stat_clear (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(stat_clear_we),
+      .wd(stat_clear_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.stat_clear.qe),
+      .q (reg2hw.stat_clear.q),
+
+      .qs()
+  );
+
+
+  // R[ext_start]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_ext_start (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(ext_start_we),
+      .wd(ext_start_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.ext_start.q),
+
+      // to register interface (read)
+      .qs(ext_start_qs)
+  );
 
 
-  logic [7:0] addr_hit;
+
+
+  logic [18:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == DMA_PTR_IN_OFFSET);
@@ -350,6 +648,17 @@ module dma_reg_top #(
     addr_hit[5] = (reg_addr == DMA_DST_PTR_INC_OFFSET);
     addr_hit[6] = (reg_addr == DMA_SLOT_OFFSET);
     addr_hit[7] = (reg_addr == DMA_DATA_TYPE_OFFSET);
+    addr_hit[8] = (reg_addr == DMA_DST_DATA_TYPE_OFFSET);
+    addr_hit[9] = (reg_addr == DMA_EXTEND_OFFSET);
+    addr_hit[10] = (reg_addr == DMA_FILL_OFFSET);
+    addr_hit[11] = (reg_addr == DMA_FILL_PATTERN_OFFSET);
+    addr_hit[12] = (reg_addr == DMA_STAT_BYTES_OFFSET);
+    addr_hit[13] = (reg_addr == DMA_STAT_BUSY_OFFSET);
+    addr_hit[14] = (reg_addr == DMA_STAT_SLOT_STALL_OFFSET);
+    addr_hit[15] = (reg_addr == DMA_STAT_READ_STALL_OFFSET);
+    addr_hit[16] = (reg_addr == DMA_STAT_WRITE_STALL_OFFSET);
+    addr_hit[17] = (reg_addr == DMA_STAT_CLEAR_OFFSET);
+    addr_hit[18] = (reg_addr == DMA_EXT_START_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -357,14 +666,25 @@ module dma_reg_top #(
   // Check sub-word write is permitted
   always_comb begin
     wr_err = (reg_we &
-              ((addr_hit[0] & (|(DMA_PERMIT[0] & ~reg_be))) |
-               (addr_hit[1] & (|(DMA_PERMIT[1] & ~reg_be))) |
-               (addr_hit[2] & (|(DMA_PERMIT[2] & ~reg_be))) |
-               (addr_hit[3] & (|(DMA_PERMIT[3] & ~reg_be))) |
-               (addr_hit[4] & (|(DMA_PERMIT[4] & ~reg_be))) |
-               (addr_hit[5] & (|(DMA_PERMIT[5] & ~reg_be))) |
-               (addr_hit[6] & (|(DMA_PERMIT[6] & ~reg_be))) |
-               (addr_hit[7] & (|(DMA_PERMIT[7] & ~reg_be)))));
+              ((addr_hit[0] & (|(DMA_PERMIT[ 0] & ~reg_be))) |
+               (addr_hit[1] & (|(DMA_PERMIT[ 1] & ~reg_be))) |
+               (addr_hit[2] & (|(DMA_PERMIT[ 2] & ~reg_be))) |
+               (addr_hit[3] & (|(DMA_PERMIT[ 3] & ~reg_be))) |
+               (addr_hit[4] & (|(DMA_PERMIT[ 4] & ~reg_be))) |
+               (addr_hit[5] & (|(DMA_PERMIT[ 5] & ~reg_be))) |
+               (addr_hit[6] & (|(DMA_PERMIT[ 6] & ~reg_be))) |
+               (addr_hit[7] & (|(DMA_PERMIT[ 7] & ~reg_be))) |
+               (addr_hit[8] & (|(DMA_PERMIT[ 8] & ~reg_be))) |
+               (addr_hit[9] & (|(DMA_PERMIT[ 9] & ~reg_be))) |
+               (addr_hit[10] & (|(DMA_PERMIT[10] & ~reg_be))) |
+               (addr_hit[11] & (|(DMA_PERMIT[11] & ~reg_be))) |
+               (addr_hit[12] & (|(DMA_PERMIT[12] & ~reg_be))) |
+               (addr_hit[13] & (|(DMA_PERMIT[13] & ~reg_be))) |
+               (addr_hit[14] & (|(DMA_PERMIT[14] & ~reg_be))) |
+               (addr_hit[15] & (|(DMA_PERMIT[15] & ~reg_be))) |
+               (addr_hit[16] & (|(DMA_PERMIT[16] & ~reg_be))) |
+               (addr_hit[17] & (|(DMA_PERMIT[17] & ~reg_be))) |
+               (addr_hit[18] & (|(DMA_PERMIT[18] & ~reg_be)))));
   end
 
   assign ptr_in_we = addr_hit[0] & reg_we & !reg_error;
@@ -391,6 +711,37 @@ module dma_reg_top #(
   assign data_type_we = addr_hit[7] & reg_we & !reg_error;
   assign data_type_wd = reg_wdata[1:0];
 
+  assign dst_data_type_we = addr_hit[8] & reg_we & !reg_error;
+  assign dst_data_type_wd = reg_wdata[1:0];
+
+  assign extend_en_we = addr_hit[9] & reg_we & !reg_error;
+  assign extend_en_wd = reg_wdata[0];
+
+  assign extend_sign_ext_we = addr_hit[9] & reg_we & !reg_error;
+  assign extend_sign_ext_wd = reg_wdata[1];
+
+  assign fill_we = addr_hit[10] & reg_we & !reg_error;
+  assign fill_wd = reg_wdata[0];
+
+  assign fill_pattern_we = addr_hit[11] & reg_we & !reg_error;
+  assign fill_pattern_wd = reg_wdata[31:0];
+
+  assign stat_bytes_re = addr_hit[12] & reg_re & !reg_error;
+
+  assign stat_busy_re = addr_hit[13] & reg_re & !reg_error;
+
+  assign stat_slot_stall_re = addr_hit[14] & reg_re & !reg_error;
+
+  assign stat_read_stall_re = addr_hit[15] & reg_re & !reg_error;
+
+  assign stat_write_stall_re = addr_hit[16] & reg_re & !reg_error;
+
+  assign stat_clear_we = addr_hit[17] & reg_we & !reg_error;
+  assign stat_clear_wd = reg_wdata[0];
+
+  assign ext_start_we = addr_hit[18] & reg_we & !reg_error;
+  assign ext_start_wd = reg_wdata[0];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -428,6 +779,51 @@ module dma_reg_top #(
         reg_rdata_next[1:0] = data_type_qs;
       end
 
+      addr_hit[8]: begin
+        reg_rdata_next[1:0] = dst_data_type_qs;
+      end
+
+      addr_hit[9]: begin
+        reg_rdata_next[0] = extend_en_qs;
+        reg_rdata_next[1] = extend_sign_ext_qs;
+      end
+
+      addr_hit[10]: begin
+        reg_rdata_next[0] = fill_qs;
+      end
+
+      addr_hit[11]: begin
+        reg_rdata_next[31:0] = fill_pattern_qs;
+      end
+
+      addr_hit[12]: begin
+        reg_rdata_next[31:0] = stat_bytes_qs;
+      end
+
+      addr_hit[13]: begin
+        reg_rdata_next[31:0] = stat_busy_qs;
+      end
+
+      addr_hit[14]: begin
+        reg_rdata_next[31:0] = stat_slot_stall_qs;
+      end
+
+      addr_hit[15]: begin
+        reg_rdata_next[31:0] = stat_read_stall_qs;
+      end
+
+      addr_hit[16]: begin
+        reg_rdata_next[31:0] = stat_write_stall_qs;
+      end
+
+      addr_hit[17]: begin
+        reg_rdata_next[0] = '0;
+      end
+
+      addr_hit[18]: begin
+        reg_rdata_next[0] = ext_start_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
@@ -0,0 +1,112 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+{ name: "event_matrix",
+  clock_primary: "clk_i",
+  bus_interfaces: [
+    { protocol: "reg_iface", direction: "device" }
+  ],
+  param_list: [
+    { name:    "NumChannels",
+      desc:    "Number of event channels",
+      type:    "int",
+      default: "${event_matrix_channels}",
+      local:   "true"
+    }
+  ],
+  regwidth: "32",
+  registers: [
+    { multireg: {
+        name:     "CHANNEL",
+        desc:     "Event channel: an edge of the source fires the action on the target",
+        count:    "NumChannels",
+        cname:    "CHANNEL",
+        swaccess: "rw",
+        hwaccess: "hro",
+        fields: [
+          { bits: "5:0", name: "SOURCE", desc: "Source event (see ao_peripheral_subsystem.sv)", resval: "0" }
+          { bits: "9:8", name: "EDGE_SEL", desc: "Edge of the source: 0 none (TRIGGER only), 1 rising, 2 falling, 3 both", resval: "0" }
+          { bits: "14:12", name: "ACTION", desc: "Action: 0 DMA start, 1 timer start, 2 timer stop, 3 GPIO toggle, 4 GPIO set, 5 GPIO clear", resval: "0" }
+          { bits: "18:16", name: "TARGET", desc: "Timer hart or GPIO pin of the action", resval: "0" }
+        ]
+      }
+    }
+
+    { multireg: {
+        name:     "FIRED",
+        desc:     "The channel fired since last cleared",
+        count:    "NumChannels",
+        cname:    "CHANNEL",
+        swaccess: "rw1c",
+        hwaccess: "hrw",
+        fields: [
+          { bits: "0", name: "FIRED", desc: "Channel fired, write 1 to clear", resval: "0" }
+        ]
+      }
+    }
+
+    { multireg: {
+        name:     "TRIGGER",
+        desc:     "Fire the channel from software",
+        count:    "NumChannels",
+        cname:    "CHANNEL",
+        swaccess: "wo",
+        hwaccess: "hro",
+        hwqe:     "true",
+        fields: [
+          { bits: "0", name: "TRIGGER", desc: "Write 1 to fire the channel", resval: "0" }
+        ]
+      }
+    }
+
+    { name:     "DMA_SIZE",
+      desc:     "Size in bytes of the transfers started by the DMA start action",
+      resval:   "0x00000000"
+      swaccess: "rw",
+      hwaccess: "hro",
+      fields: [
+        { bits: "31:0", name: "DMA_SIZE", desc: "Transfer size, 0 for none" }
+      ]
+    }
+
+    { name:     "TIMER_GATE",
+      desc:     "Always-on rv_timer harts counting only while TIMER_RUN is set",
+      resval:   "0x00000000"
+      swaccess: "rw",
+      hwaccess: "hro",
+      fields: [
+        { bits: "1:0", name: "TIMER_GATE", desc: "One bit per hart" }
+      ]
+    }
+
+    { name:     "TIMER_RUN",
+      desc:     "Run state of the gated timer harts, set by the timer start and cleared by the timer stop actions",
+      resval:   "0x00000000"
+      swaccess: "rw",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "1:0", name: "TIMER_RUN", desc: "One bit per hart" }
+      ]
+    }
+
+    { name:     "GPIO_SEL",
+      desc:     "Always-on GPIO pins driven by GPIO_OUT instead of the GPIO peripheral",
+      resval:   "0x00000000"
+      swaccess: "rw",
+      hwaccess: "hro",
+      fields: [
+        { bits: "7:0", name: "GPIO_SEL", desc: "One bit per pin" }
+      ]
+    }
+
+    { name:     "GPIO_OUT",
+      desc:     "Value of the selected GPIO pins, changed by the GPIO actions",
+      resval:   "0x00000000"
+      swaccess: "rw",
+      hwaccess: "hrw",
+      fields: [
+        { bits: "7:0", name: "GPIO_OUT", desc: "One bit per pin" }
+      ]
+    }
+   ]
+}
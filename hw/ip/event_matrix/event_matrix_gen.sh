@@ -0,0 +1,4 @@
+echo "Generating RTL"
+${PYTHON} ../../vendor/pulp_platform_register_interface/vendor/lowrisc_opentitan/util/regtool.py -r -t rtl ./data/event_matrix.hjson
+echo "Generating SW"
+${PYTHON} ../../vendor/pulp_platform_register_interface/vendor/lowrisc_opentitan/util/regtool.py --cdefines -o ../../../sw/device/lib/drivers/event_matrix/event_matrix_regs.h ./data/event_matrix.hjson
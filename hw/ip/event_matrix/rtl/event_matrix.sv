@@ -0,0 +1,146 @@
+// Copyright EPFL contributors.
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// Event system: each channel fires an action (DMA start, timer start/stop,
+// GPIO toggle/set/clear) on an edge of one of the source events, without the CPU
+
+module event_matrix #(
+    parameter type reg_req_t = logic,
+    parameter type reg_rsp_t = logic
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    // Bus Interface
+    input  reg_req_t reg_req_i,
+    output reg_rsp_t reg_rsp_o,
+
+    // Source events, selected by the SOURCE field of the channels
+    input logic [63:0] event_i,
+
+    // DMA start
+    output logic        dma_start_o,
+    output logic [31:0] dma_size_o,
+
+    // Always-on timer harts stopped by the event system
+    output logic [1:0] timer_hold_o,
+
+    // Always-on GPIOs driven by the event system
+    output logic [7:0] gpio_sel_o,
+    output logic [7:0] gpio_o
+);
+
+  import event_matrix_reg_pkg::*;
+
+  localparam logic [2:0] ActionDmaStart = 3'd0;
+  localparam logic [2:0] ActionTimerStart = 3'd1;
+  localparam logic [2:0] ActionTimerStop = 3'd2;
+  localparam logic [2:0] ActionGpioToggle = 3'd3;
+  localparam logic [2:0] ActionGpioSet = 3'd4;
+  localparam logic [2:0] ActionGpioClear = 3'd5;
+
+  event_matrix_reg2hw_t reg2hw;
+  event_matrix_hw2reg_t hw2reg;
+
+  logic [63:0] event_q;
+  logic [63:0] event_rise;
+  logic [63:0] event_fall;
+
+  logic [NumChannels-1:0] fire;
+
+  logic dma_start;
+  logic [1:0] timer_start;
+  logic [1:0] timer_stop;
+  logic [7:0] gpio_toggle;
+  logic [7:0] gpio_set;
+  logic [7:0] gpio_clear;
+
+  event_matrix_reg_top #(
+      .reg_req_t(reg_req_t),
+      .reg_rsp_t(reg_rsp_t)
+  ) event_matrix_reg_top_i (
+      .clk_i,
+      .rst_ni,
+      .reg_req_i,
+      .reg_rsp_o,
+      .reg2hw,
+      .hw2reg,
+      .devmode_i(1'b1)
+  );
+
+  // Previous level of the sources for the edge detection
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_event_q
+    if (~rst_ni) begin
+      event_q <= '0;
+    end else begin
+      event_q <= event_i;
+    end
+  end
+
+  assign event_rise = event_i & ~event_q;
+  assign event_fall = ~event_i & event_q;
+
+  for (genvar i = 0; i < NumChannels; i++) begin : gen_channel
+    assign fire[i] = (reg2hw.channel[i].edge_sel.q[0] & event_rise[reg2hw.channel[i].source.q]) |
+                     (reg2hw.channel[i].edge_sel.q[1] & event_fall[reg2hw.channel[i].source.q]) |
+                     (reg2hw.trigger[i].q & reg2hw.trigger[i].qe);
+
+    assign hw2reg.fired[i].de = fire[i];
+    assign hw2reg.fired[i].d = 1'b1;
+  end
+
+  // Actions of the channels fired in this cycle, stop and clear win over start and set
+  always_comb begin : proc_actions
+    dma_start   = 1'b0;
+    timer_start = '0;
+    timer_stop  = '0;
+    gpio_toggle = '0;
+    gpio_set    = '0;
+    gpio_clear  = '0;
+    for (int unsigned i = 0; i < NumChannels; i++) begin
+      if (fire[i] == 1'b1) begin
+        unique case (reg2hw.channel[i].action.q)
+          ActionDmaStart: dma_start = 1'b1;
+          ActionTimerStart: begin
+            if (reg2hw.channel[i].target.q < 3'd2) begin
+              timer_start[reg2hw.channel[i].target.q[0]] = 1'b1;
+            end
+          end
+          ActionTimerStop: begin
+            if (reg2hw.channel[i].target.q < 3'd2) begin
+              timer_stop[reg2hw.channel[i].target.q[0]] = 1'b1;
+            end
+          end
+          ActionGpioToggle: gpio_toggle[reg2hw.channel[i].target.q] = 1'b1;
+          ActionGpioSet: gpio_set[reg2hw.channel[i].target.q] = 1'b1;
+          ActionGpioClear: gpio_clear[reg2hw.channel[i].target.q] = 1'b1;
+          default: ;
+        endcase
+      end
+    end
+  end
+
+  // The DMA ignores the start while it is busy
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_dma_start
+    if (~rst_ni) begin
+      dma_start_o <= 1'b0;
+    end else begin
+      dma_start_o <= dma_start;
+    end
+  end
+
+  assign dma_size_o = reg2hw.dma_size.q;
+
+  assign hw2reg.timer_run.de = |timer_start | |timer_stop;
+  assign hw2reg.timer_run.d = (reg2hw.timer_run.q | timer_start) & ~timer_stop;
+
+  assign timer_hold_o = reg2hw.timer_gate.q & ~reg2hw.timer_run.q;
+
+  assign hw2reg.gpio_out.de = |gpio_toggle | |gpio_set | |gpio_clear;
+  assign hw2reg.gpio_out.d = ((reg2hw.gpio_out.q ^ gpio_toggle) | gpio_set) & ~gpio_clear;
+
+  assign gpio_sel_o = reg2hw.gpio_sel.q;
+  assign gpio_o = reg2hw.gpio_out.q;
+
+endmodule : event_matrix
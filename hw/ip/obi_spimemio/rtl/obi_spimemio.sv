@@ -7,7 +7,12 @@
 module obi_spimemio
   import obi_pkg::*;
   import reg_pkg::*;
-(
+#(
+    // flash cache, in bytes, 0 for no cache
+    parameter int unsigned CACHE_SIZE      = 0,
+    parameter int unsigned CACHE_LINE_SIZE = 16,
+    parameter int unsigned CACHE_WAYS      = 2
+) (
     input  logic clk_i,
     input  logic rst_ni,
     output logic flash_csb_o,
@@ -47,14 +52,45 @@ module obi_spimemio
   logic cfgreg_we, cfgreg_rd;
 
   obi_spimemio_reg2hw_t reg2hw;
+  obi_spimemio_hw2reg_t hw2reg;
+
+  obi_req_t  flash_req;
+  obi_resp_t flash_resp;
+
+  if (CACHE_SIZE != 0) begin : gen_cache
+    obi_spimemio_cache #(
+        .CACHE_SIZE(CACHE_SIZE),
+        .LINE_SIZE (CACHE_LINE_SIZE),
+        .WAYS      (CACHE_WAYS)
+    ) obi_spimemio_cache_i (
+        .clk_i,
+        .rst_ni,
+        .enable_i(reg2hw.cache_enable.q),
+        .flush_i(reg2hw.cache_flush.qe & reg2hw.cache_flush.q),
+        .clear_stats_i(reg2hw.cache_stat_clear.qe & reg2hw.cache_stat_clear.q),
+        .hits_o(hw2reg.cache_hits.d),
+        .misses_o(hw2reg.cache_misses.d),
+        .slave_req_i(spimemio_req_i),
+        .slave_resp_o(spimemio_resp_o),
+        .master_req_o(flash_req),
+        .master_resp_i(flash_resp)
+    );
+  end else begin : gen_no_cache
+    assign flash_req = spimemio_req_i;
+    assign spimemio_resp_o = flash_resp;
+    assign hw2reg.cache_hits.d = '0;
+    assign hw2reg.cache_misses.d = '0;
+  end
 
   obi_to_picorv32 obi_to_picorv32_i (
       .clk_i(clk_i),
       .rst_ni(rst_ni),
+      .prefetch_en_i(reg2hw.prefetch_enable.q),
+      .prefetch_flush_i(cfgreg_we | (reg2hw.cache_flush.qe & reg2hw.cache_flush.q)),
       .picorv32_req_o(picorv32_req),
       .picorv32_resp_i(picorv32_resp),
-      .obi_req_i(spimemio_req_i),
-      .obi_resp_o(spimemio_resp_o)
+      .obi_req_i(flash_req),
+      .obi_resp_o(flash_resp)
   );
 
   obi_spimemio_reg_top #(
@@ -66,6 +102,7 @@ module obi_spimemio
       .reg_req_i,
       .reg_rsp_o(reg_rsp_reg),
       .reg2hw,
+      .hw2reg,
       .devmode_i(1'b1)
   );
 
@@ -0,0 +1,227 @@
+/*
+*  Copyright 2022 EPFL
+*  Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+*  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+*/
+
+// Read cache in front of the memory mapped flash, used when executing from flash.
+// Set associative, with round-robin replacement in each set. A miss fetches the whole line
+// from the flash before answering. Writes, and all accesses while the cache is disabled,
+// go straight to the flash. The lines are kept in flip-flops, which is fine for the few KB
+// used here.
+
+module obi_spimemio_cache
+  import obi_pkg::*;
+#(
+    parameter int unsigned CACHE_SIZE = 1024,  // in bytes
+    parameter int unsigned LINE_SIZE  = 16,    // in bytes, power of 2
+    parameter int unsigned WAYS       = 2
+) (
+    input logic clk_i,
+    input logic rst_ni,
+
+    input logic enable_i,
+    input logic flush_i,
+    input logic clear_stats_i,
+
+    output logic [31:0] hits_o,
+    output logic [31:0] misses_o,
+
+    input  obi_req_t  slave_req_i,
+    output obi_resp_t slave_resp_o,
+
+    output obi_req_t  master_req_o,
+    input  obi_resp_t master_resp_i
+);
+
+  localparam int unsigned WORDS = LINE_SIZE / 4;
+  localparam int unsigned SETS = CACHE_SIZE / (LINE_SIZE * WAYS);
+  localparam int unsigned OFFSET_W = $clog2(LINE_SIZE);
+  localparam int unsigned WORD_W = WORDS > 1 ? $clog2(WORDS) : 1;
+  localparam int unsigned SET_W = SETS > 1 ? $clog2(SETS) : 1;
+  localparam int unsigned WAY_W = WAYS > 1 ? $clog2(WAYS) : 1;
+  localparam int unsigned TAG_W = 32 - OFFSET_W - (SETS > 1 ? $clog2(SETS) : 0);
+
+  typedef enum logic [2:0] {
+    IDLE,
+    FILL_REQ,
+    FILL_WAIT,
+    BYPASS_REQ,
+    BYPASS_WAIT
+  } cache_state_e;
+
+  cache_state_e state_q, state_d;
+
+  logic [SETS-1:0][WAYS-1:0] valid_q;
+  logic [TAG_W-1:0] tag_q[SETS][WAYS];
+  logic [31:0] data_q[SETS][WAYS][WORDS];
+  logic [WAY_W-1:0] victim_q[SETS];
+
+  obi_req_t req_q;
+  logic [WAY_W-1:0] fill_way_q;
+  logic [WORD_W-1:0] fill_cnt_q;
+  logic fill_flushed_q;
+  logic rvalid_q;
+  logic [31:0] rdata_q;
+
+  logic [SET_W-1:0] req_set, fill_set;
+  logic [WORD_W-1:0] req_word, fill_word;
+  logic [TAG_W-1:0] req_tag;
+  logic hit;
+  logic [WAY_W-1:0] hit_way;
+  logic lookup, fill_done;
+
+  function automatic logic [SET_W-1:0] set_of(logic [31:0] addr);
+    return SETS > 1 ? addr[OFFSET_W+:SET_W] : '0;
+  endfunction
+
+  function automatic logic [WORD_W-1:0] word_of(logic [31:0] addr);
+    return WORDS > 1 ? addr[2+:WORD_W] : '0;
+  endfunction
+
+  assign req_set   = set_of(slave_req_i.addr);
+  assign req_word  = word_of(slave_req_i.addr);
+  assign req_tag   = slave_req_i.addr[31-:TAG_W];
+  assign fill_set  = set_of(req_q.addr);
+  assign fill_word = word_of(req_q.addr);
+
+  always_comb begin : proc_lookup
+    hit = 1'b0;
+    hit_way = '0;
+    for (int unsigned w = 0; w < WAYS; w++) begin
+      if (valid_q[req_set][w] && tag_q[req_set][w] == req_tag) begin
+        hit = 1'b1;
+        hit_way = w[WAY_W-1:0];
+      end
+    end
+  end
+
+  // a new request is accepted in IDLE, a read hit is answered in the next cycle
+  assign lookup = state_q == IDLE && slave_req_i.req && !slave_req_i.we && enable_i;
+  assign fill_done = state_q == FILL_WAIT && master_resp_i.rvalid &&
+                     fill_cnt_q == WORD_W'(WORDS - 1);
+
+  always_comb begin : proc_fsm
+    state_d = state_q;
+    master_req_o = req_q;
+    master_req_o.req = 1'b0;
+    slave_resp_o.gnt = 1'b0;
+
+    case (state_q)
+      IDLE: begin
+        slave_resp_o.gnt = slave_req_i.req;
+        if (slave_req_i.req) begin
+          if (!lookup) begin
+            state_d = BYPASS_REQ;
+          end else if (!hit) begin
+            state_d = FILL_REQ;
+          end
+        end
+      end
+      FILL_REQ: begin
+        master_req_o.req  = 1'b1;
+        master_req_o.we   = 1'b0;
+        master_req_o.be   = 4'hf;
+        master_req_o.addr = {req_q.addr[31:OFFSET_W], {OFFSET_W{1'b0}}} | {fill_cnt_q, 2'b00};
+        if (master_resp_i.gnt) begin
+          state_d = FILL_WAIT;
+        end
+      end
+      FILL_WAIT: begin
+        if (master_resp_i.rvalid) begin
+          state_d = fill_done ? IDLE : FILL_REQ;
+        end
+      end
+      BYPASS_REQ: begin
+        master_req_o.req = 1'b1;
+        if (master_resp_i.gnt) begin
+          state_d = BYPASS_WAIT;
+        end
+      end
+      BYPASS_WAIT: begin
+        if (master_resp_i.rvalid) begin
+          state_d = IDLE;
+        end
+      end
+      default: begin
+        state_d = IDLE;
+      end
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_ctrl
+    if (~rst_ni) begin
+      state_q        <= IDLE;
+      req_q          <= '0;
+      fill_way_q     <= '0;
+      fill_cnt_q     <= '0;
+      fill_flushed_q <= 1'b0;
+      rvalid_q       <= 1'b0;
+      rdata_q        <= '0;
+      valid_q        <= '0;
+      hits_o         <= '0;
+      misses_o       <= '0;
+      for (int unsigned s = 0; s < SETS; s++) begin
+        victim_q[s] <= '0;
+      end
+    end else begin
+      state_q  <= state_d;
+      rvalid_q <= 1'b0;
+
+      if (state_q == IDLE && slave_req_i.req) begin
+        req_q <= slave_req_i;
+        if (lookup && hit) begin
+          rvalid_q <= 1'b1;
+          rdata_q  <= data_q[req_set][hit_way][req_word];
+        end else if (lookup) begin
+          // the victim line is invalid until it is filled again
+          fill_way_q <= victim_q[req_set];
+          fill_cnt_q <= '0;
+          fill_flushed_q <= 1'b0;
+          valid_q[req_set][victim_q[req_set]] <= 1'b0;
+        end
+      end
+
+      if (state_q == FILL_WAIT && master_resp_i.rvalid) begin
+        fill_cnt_q <= fill_cnt_q + 1'b1;
+        if (fill_done) begin
+          valid_q[fill_set][fill_way_q] <= !fill_flushed_q && !flush_i;
+          victim_q[fill_set] <= fill_way_q == WAY_W'(WAYS - 1) ? '0 : fill_way_q + 1'b1;
+          rvalid_q <= 1'b1;
+          rdata_q <= fill_word == fill_cnt_q ? master_resp_i.rdata : data_q[fill_set][fill_way_q][fill_word];
+        end
+      end
+
+      if (state_q == BYPASS_WAIT && master_resp_i.rvalid) begin
+        rvalid_q <= 1'b1;
+        rdata_q  <= master_resp_i.rdata;
+      end
+
+      if (flush_i) begin
+        valid_q <= '0;
+        fill_flushed_q <= 1'b1;
+      end
+
+      if (clear_stats_i) begin
+        hits_o   <= '0;
+        misses_o <= '0;
+      end else if (lookup) begin
+        hits_o   <= hits_o + {31'h0, hit};
+        misses_o <= misses_o + {31'h0, !hit};
+      end
+    end
+  end
+
+  always_ff @(posedge clk_i) begin : proc_lines
+    if (lookup && !hit) begin
+      tag_q[req_set][victim_q[req_set]] <= req_tag;
+    end
+    if (state_q == FILL_WAIT && master_resp_i.rvalid) begin
+      data_q[fill_set][fill_way_q][fill_cnt_q] <= master_resp_i.rdata;
+    end
+  end
+
+  assign slave_resp_o.rvalid = rvalid_q;
+  assign slave_resp_o.rdata  = rdata_q;
+
+endmodule : obi_spimemio_cache
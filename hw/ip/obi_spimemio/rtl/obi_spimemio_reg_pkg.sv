@@ -7,7 +7,7 @@
 package obi_spimemio_reg_pkg;
 
   // Address widths within the block
-  parameter int BlockAw = 3;
+  parameter int BlockAw = 5;
 
   ////////////////////////////
   // Typedefs for registers //
@@ -15,25 +15,75 @@ package obi_spimemio_reg_pkg;
 
   typedef struct packed {logic q;} obi_spimemio_reg2hw_start_spimem_reg_t;
 
+  typedef struct packed {logic q;} obi_spimemio_reg2hw_cache_enable_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic qe;
+  } obi_spimemio_reg2hw_cache_flush_reg_t;
+
+  typedef struct packed {
+    logic q;
+    logic qe;
+  } obi_spimemio_reg2hw_cache_stat_clear_reg_t;
+
+  typedef struct packed {logic q;} obi_spimemio_reg2hw_prefetch_enable_reg_t;
+
+  typedef struct packed {logic [31:0] d;} obi_spimemio_hw2reg_cache_hits_reg_t;
+
+  typedef struct packed {logic [31:0] d;} obi_spimemio_hw2reg_cache_misses_reg_t;
+
   // Register -> HW type
   typedef struct packed {
-    obi_spimemio_reg2hw_start_spimem_reg_t start_spimem;  // [0:0]
+    obi_spimemio_reg2hw_start_spimem_reg_t start_spimem;  // [6:6]
+    obi_spimemio_reg2hw_cache_enable_reg_t cache_enable;  // [5:5]
+    obi_spimemio_reg2hw_cache_flush_reg_t cache_flush;  // [4:3]
+    obi_spimemio_reg2hw_cache_stat_clear_reg_t cache_stat_clear;  // [2:1]
+    obi_spimemio_reg2hw_prefetch_enable_reg_t prefetch_enable;  // [0:0]
   } obi_spimemio_reg2hw_t;
 
+  // HW -> register type
+  typedef struct packed {
+    obi_spimemio_hw2reg_cache_hits_reg_t cache_hits;  // [63:32]
+    obi_spimemio_hw2reg_cache_misses_reg_t cache_misses;  // [31:0]
+  } obi_spimemio_hw2reg_t;
+
   // Register offsets
-  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_START_SPIMEM_OFFSET = 3'h0;
-  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_CFG_SPIMEM_OFFSET = 3'h4;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_START_SPIMEM_OFFSET = 5'h0;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_CFG_SPIMEM_OFFSET = 5'h4;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_CACHE_ENABLE_OFFSET = 5'h8;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_CACHE_FLUSH_OFFSET = 5'hc;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_CACHE_HITS_OFFSET = 5'h10;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_CACHE_MISSES_OFFSET = 5'h14;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_CACHE_STAT_CLEAR_OFFSET = 5'h18;
+  parameter logic [BlockAw-1:0] OBI_SPIMEMIO_PREFETCH_ENABLE_OFFSET = 5'h1c;
+
+  // Reset values for hwext registers and their fields
+  parameter logic [31:0] OBI_SPIMEMIO_CACHE_HITS_RESVAL = 32'h0;
+  parameter logic [31:0] OBI_SPIMEMIO_CACHE_MISSES_RESVAL = 32'h0;
 
   // Register index
   typedef enum int {
     OBI_SPIMEMIO_START_SPIMEM,
-    OBI_SPIMEMIO_CFG_SPIMEM
+    OBI_SPIMEMIO_CFG_SPIMEM,
+    OBI_SPIMEMIO_CACHE_ENABLE,
+    OBI_SPIMEMIO_CACHE_FLUSH,
+    OBI_SPIMEMIO_CACHE_HITS,
+    OBI_SPIMEMIO_CACHE_MISSES,
+    OBI_SPIMEMIO_CACHE_STAT_CLEAR,
+    OBI_SPIMEMIO_PREFETCH_ENABLE
   } obi_spimemio_id_e;
 
   // Register width information to check illegal writes
-  parameter logic [3:0] OBI_SPIMEMIO_PERMIT[2] = '{
+  parameter logic [3:0] OBI_SPIMEMIO_PERMIT[8] = '{
       4'b0001,  // index[0] OBI_SPIMEMIO_START_SPIMEM
-      4'b1111  // index[1] OBI_SPIMEMIO_CFG_SPIMEM
+      4'b1111,  // index[1] OBI_SPIMEMIO_CFG_SPIMEM
+      4'b0001,  // index[2] OBI_SPIMEMIO_CACHE_ENABLE
+      4'b0001,  // index[3] OBI_SPIMEMIO_CACHE_FLUSH
+      4'b1111,  // index[4] OBI_SPIMEMIO_CACHE_HITS
+      4'b1111,  // index[5] OBI_SPIMEMIO_CACHE_MISSES
+      4'b0001,  // index[6] OBI_SPIMEMIO_CACHE_STAT_CLEAR
+      4'b0001  // index[7] OBI_SPIMEMIO_PREFETCH_ENABLE
   };
 
 endpackage
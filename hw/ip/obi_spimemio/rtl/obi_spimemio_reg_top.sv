@@ -10,7 +10,7 @@
 module obi_spimemio_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 3
+    parameter int AW = 5
 ) (
     input clk_i,
     input rst_ni,
@@ -18,6 +18,7 @@ module obi_spimemio_reg_top #(
     output reg_rsp_t reg_rsp_o,
     // To HW
     output obi_spimemio_reg_pkg::obi_spimemio_reg2hw_t reg2hw,  // Write
+    input obi_spimemio_reg_pkg::obi_spimemio_hw2reg_t hw2reg,  // Read
 
 
     // Config
@@ -70,6 +71,20 @@ module obi_spimemio_reg_top #(
   logic start_spimem_qs;
   logic start_spimem_wd;
   logic start_spimem_we;
+  logic cache_enable_qs;
+  logic cache_enable_wd;
+  logic cache_enable_we;
+  logic cache_flush_wd;
+  logic cache_flush_we;
+  logic [31:0] cache_hits_qs;
+  logic cache_hits_re;
+  logic [31:0] cache_misses_qs;
+  logic cache_misses_re;
+  logic cache_stat_clear_wd;
+  logic cache_stat_clear_we;
+  logic prefetch_enable_qs;
+  logic prefetch_enable_wd;
+  logic prefetch_enable_we;
 
   // Register instances
   // R[start_spimem]: V(False)
@@ -124,13 +139,157 @@ module obi_spimemio_reg_top #(
   );
 
 
+  // R[cache_enable]: V(False)
 
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h1)
+  ) u_cache_enable (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(cache_enable_we),
+      .wd(cache_enable_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.cache_enable.q),
+
+      // to register interface (read)
+      .qs(cache_enable_qs)
+  );
+
+
+  // R[cache_flush]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("WO"),
+      .RESVAL  (1'h0)
+  ) u_cache_flush (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(cache_flush_we),
+      .wd(cache_flush_wd),
 
-  logic [1:0] addr_hit;
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.cache_flush.qe),
+      .q (reg2hw.cache_flush.q),
+
+      .qs()
+  );
+
+
+  // R[cache_hits]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_cache_hits (
+      .re (cache_hits_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.cache_hits.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (cache_hits_qs)
+  );
+
+
+  // R[cache_misses]: V(True)
+
+  prim_subreg_ext #(
+      .DW(32)
+  ) u_cache_misses (
+      .re (cache_misses_re),
+      .we (1'b0),
+      .wd ('0),
+      .d  (hw2reg.cache_misses.d),
+      .qre(),
+      .qe (),
+      .q  (),
+      .qs (cache_misses_qs)
+  );
+
+
+  // R[cache_stat_clear]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("WO"),
+      .RESVAL  (1'h0)
+  ) u_cache_stat_clear (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(cache_stat_clear_we),
+      .wd(cache_stat_clear_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(reg2hw.cache_stat_clear.qe),
+      .q (reg2hw.cache_stat_clear.q),
+
+      .qs()
+  );
+
+
+  // R[prefetch_enable]: V(False)
+
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_prefetch_enable (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(prefetch_enable_we),
+      .wd(prefetch_enable_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.prefetch_enable.q),
+
+      // to register interface (read)
+      .qs(prefetch_enable_qs)
+  );
+
+
+
+
+  logic [7:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == OBI_SPIMEMIO_START_SPIMEM_OFFSET);
     addr_hit[1] = (reg_addr == OBI_SPIMEMIO_CFG_SPIMEM_OFFSET);
+    addr_hit[2] = (reg_addr == OBI_SPIMEMIO_CACHE_ENABLE_OFFSET);
+    addr_hit[3] = (reg_addr == OBI_SPIMEMIO_CACHE_FLUSH_OFFSET);
+    addr_hit[4] = (reg_addr == OBI_SPIMEMIO_CACHE_HITS_OFFSET);
+    addr_hit[5] = (reg_addr == OBI_SPIMEMIO_CACHE_MISSES_OFFSET);
+    addr_hit[6] = (reg_addr == OBI_SPIMEMIO_CACHE_STAT_CLEAR_OFFSET);
+    addr_hit[7] = (reg_addr == OBI_SPIMEMIO_PREFETCH_ENABLE_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -139,12 +298,34 @@ module obi_spimemio_reg_top #(
   always_comb begin
     wr_err = (reg_we &
               ((addr_hit[0] & (|(OBI_SPIMEMIO_PERMIT[0] & ~reg_be))) |
-               (addr_hit[1] & (|(OBI_SPIMEMIO_PERMIT[1] & ~reg_be)))));
+               (addr_hit[1] & (|(OBI_SPIMEMIO_PERMIT[1] & ~reg_be))) |
+               (addr_hit[2] & (|(OBI_SPIMEMIO_PERMIT[2] & ~reg_be))) |
+               (addr_hit[3] & (|(OBI_SPIMEMIO_PERMIT[3] & ~reg_be))) |
+               (addr_hit[4] & (|(OBI_SPIMEMIO_PERMIT[4] & ~reg_be))) |
+               (addr_hit[5] & (|(OBI_SPIMEMIO_PERMIT[5] & ~reg_be))) |
+               (addr_hit[6] & (|(OBI_SPIMEMIO_PERMIT[6] & ~reg_be))) |
+               (addr_hit[7] & (|(OBI_SPIMEMIO_PERMIT[7] & ~reg_be)))));
   end
 
   assign start_spimem_we = addr_hit[0] & reg_we & !reg_error;
   assign start_spimem_wd = reg_wdata[0];
 
+  assign cache_enable_we = addr_hit[2] & reg_we & !reg_error;
+  assign cache_enable_wd = reg_wdata[0];
+
+  assign cache_flush_we = addr_hit[3] & reg_we & !reg_error;
+  assign cache_flush_wd = reg_wdata[0];
+
+  assign cache_hits_re = addr_hit[4] & reg_re & !reg_error;
+
+  assign cache_misses_re = addr_hit[5] & reg_re & !reg_error;
+
+  assign cache_stat_clear_we = addr_hit[6] & reg_we & !reg_error;
+  assign cache_stat_clear_wd = reg_wdata[0];
+
+  assign prefetch_enable_we = addr_hit[7] & reg_we & !reg_error;
+  assign prefetch_enable_wd = reg_wdata[0];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -157,6 +338,30 @@ module obi_spimemio_reg_top #(
         reg_rdata_next[31:0] = '0;
       end
 
+      addr_hit[2]: begin
+        reg_rdata_next[0] = cache_enable_qs;
+      end
+
+      addr_hit[3]: begin
+        reg_rdata_next[0] = '0;
+      end
+
+      addr_hit[4]: begin
+        reg_rdata_next[31:0] = cache_hits_qs;
+      end
+
+      addr_hit[5]: begin
+        reg_rdata_next[31:0] = cache_misses_qs;
+      end
+
+      addr_hit[6]: begin
+        reg_rdata_next[0] = '0;
+      end
+
+      addr_hit[7]: begin
+        reg_rdata_next[0] = prefetch_enable_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
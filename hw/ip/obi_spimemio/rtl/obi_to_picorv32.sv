@@ -4,6 +4,11 @@
 *  SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
 */
 
+// When prefetch_en_i is set, the word after each read is requested right away: spimemio keeps
+// the flash selected and goes on shifting in sequential words, so the next read of a straight
+// line code or data stream is answered from the prefetch buffer without a new flash command.
+// A read to any other address makes spimemio restart the transfer as before.
+
 module obi_to_picorv32
   import obi_pkg::*;
   import picorv32_pkg::*;
@@ -11,6 +16,9 @@ module obi_to_picorv32
     input logic clk_i,
     input logic rst_ni,
 
+    input logic prefetch_en_i,
+    input logic prefetch_flush_i,
+
     input  obi_req_t  obi_req_i,
     output obi_resp_t obi_resp_o,
 
@@ -29,27 +37,41 @@ module obi_to_picorv32
     WRITE_BYTE_0 = 4'b0001
   } picorv_request_e;
 
-  enum logic [1:0] {
+  enum logic [2:0] {
     IDLE,
     READ,
     WRITE,
-    GIVE_VALID
+    GIVE_VALID,
+    PREFETCH
   }
       state, state_next;
 
 
   logic [31:0] addr_buf, addr_buf_next, rdata_buf, rdata_buf_next;
 
+  // prefetched word
+  logic [31:0] pf_addr, pf_addr_next, pf_data, pf_data_next;
+  logic pf_valid, pf_valid_next;
+  logic pf_hit;
+
+  assign pf_hit = pf_valid && obi_req_i.addr == pf_addr;
+
 
   always_ff @(posedge clk_i or negedge rst_ni) begin : ram_valid_q
     if (!rst_ni) begin
       state <= IDLE;
       addr_buf <= '0;
       rdata_buf <= '0;
+      pf_addr <= '0;
+      pf_data <= '0;
+      pf_valid <= 1'b0;
     end else begin
       state <= state_next;
       addr_buf <= addr_buf_next;
       rdata_buf <= rdata_buf_next;
+      pf_addr <= pf_addr_next;
+      pf_data <= pf_data_next;
+      pf_valid <= pf_valid_next && prefetch_en_i && !prefetch_flush_i;
     end
   end
 
@@ -66,6 +88,9 @@ module obi_to_picorv32
     obi_resp_o.rvalid = 1'b0;
     obi_resp_o.rdata = rdata_buf;
     rdata_buf_next = picorv32_resp_i.rdata;
+    pf_addr_next = pf_addr;
+    pf_data_next = pf_data;
+    pf_valid_next = pf_valid;
     // fsm
     case (state)
       IDLE: begin
@@ -73,6 +98,13 @@ module obi_to_picorv32
           if (obi_req_i.we == 1'b1) begin
             state_next = WRITE;
             obi_resp_o.gnt = 1'b1;
+          end else if (pf_hit) begin
+            // answered from the prefetch buffer, the following word is prefetched after it
+            state_next = GIVE_VALID;
+            addr_buf_next = obi_req_i.addr;
+            rdata_buf_next = pf_data;
+            pf_valid_next = 1'b0;
+            obi_resp_o.gnt = 1'b1;
           end else begin
             state_next = READ;
             addr_buf_next = obi_req_i.addr;
@@ -86,7 +118,27 @@ module obi_to_picorv32
         if (picorv32_resp_i.ready) begin
           state_next = GIVE_VALID;
         end
-        // Todo: add contineous read w/o idle
+      end
+      PREFETCH: begin
+        picorv32_req_o.addr  = addr_buf;
+        picorv32_req_o.valid = 1'b1;
+        if (obi_req_i.req) begin
+          // a new request takes over the prefetch, spimemio jumps if the address differs
+          obi_resp_o.gnt = 1'b1;
+          addr_buf_next = obi_req_i.addr;
+          if (obi_req_i.we == 1'b1) begin
+            state_next = WRITE;
+          end else if (picorv32_resp_i.ready && obi_req_i.addr == addr_buf) begin
+            state_next = GIVE_VALID;
+          end else begin
+            state_next = READ;
+          end
+        end else if (picorv32_resp_i.ready) begin
+          state_next = IDLE;
+          pf_addr_next = addr_buf;
+          pf_data_next = picorv32_resp_i.rdata;
+          pf_valid_next = 1'b1;
+        end
       end
       WRITE: begin
         state_next = IDLE;
@@ -96,6 +148,10 @@ module obi_to_picorv32
       GIVE_VALID: begin
         state_next = IDLE;
         obi_resp_o.rvalid = 1'b1;
+        if (prefetch_en_i) begin
+          state_next = PREFETCH;
+          addr_buf_next = addr_buf + 32'h4;
+        end
       end
 
       default: begin
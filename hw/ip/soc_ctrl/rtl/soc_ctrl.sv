@@ -20,7 +20,11 @@ module soc_ctrl #(
     output logic use_spimemio_o,
 
     output logic        exit_valid_o,
-    output logic [31:0] exit_value_o
+    output logic [31:0] exit_value_o,
+
+    // System bus priorities of core instr, core data, debug, dma read and dma write
+    output logic            bus_qos_override_o,
+    output logic [4:0][1:0] bus_qos_priority_o
 );
 
   import soc_ctrl_reg_pkg::*;
@@ -71,4 +75,13 @@ module soc_ctrl #(
   assign use_spimemio_o = reg2hw.use_spimemio.q;
   assign enable_spi_sel = reg2hw.enable_spi_sel.q;
 
+  assign bus_qos_override_o = reg2hw.bus_qos.override.q;
+  assign bus_qos_priority_o = {
+    reg2hw.bus_qos.dma_write.q,
+    reg2hw.bus_qos.dma_read.q,
+    reg2hw.bus_qos.debug.q,
+    reg2hw.bus_qos.core_data.q,
+    reg2hw.bus_qos.core_instr.q
+  };
+
 endmodule : soc_ctrl
@@ -10,7 +10,7 @@
 module soc_ctrl_reg_top #(
     parameter type reg_req_t = logic,
     parameter type reg_rsp_t = logic,
-    parameter int AW = 5
+    parameter int AW = 6
 ) (
     input clk_i,
     input rst_ni,
@@ -90,6 +90,24 @@ module soc_ctrl_reg_top #(
   logic [31:0] system_frequency_hz_qs;
   logic [31:0] system_frequency_hz_wd;
   logic system_frequency_hz_we;
+  logic [1:0] bus_qos_core_instr_qs;
+  logic [1:0] bus_qos_core_instr_wd;
+  logic bus_qos_core_instr_we;
+  logic [1:0] bus_qos_core_data_qs;
+  logic [1:0] bus_qos_core_data_wd;
+  logic bus_qos_core_data_we;
+  logic [1:0] bus_qos_debug_qs;
+  logic [1:0] bus_qos_debug_wd;
+  logic bus_qos_debug_we;
+  logic [1:0] bus_qos_dma_read_qs;
+  logic [1:0] bus_qos_dma_read_wd;
+  logic bus_qos_dma_read_we;
+  logic [1:0] bus_qos_dma_write_qs;
+  logic [1:0] bus_qos_dma_write_wd;
+  logic bus_qos_dma_write_we;
+  logic bus_qos_override_qs;
+  logic bus_qos_override_wd;
+  logic bus_qos_override_we;
 
   // Register instances
   // R[exit_valid]: V(False)
@@ -307,9 +325,167 @@ module soc_ctrl_reg_top #(
   );
 
 
+  // R[bus_qos]: V(False)
 
+  //   F[core_instr]: 1:0
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_bus_qos_core_instr (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_core_instr_we),
+      .wd(bus_qos_core_instr_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.core_instr.q),
+
+      // to register interface (read)
+      .qs(bus_qos_core_instr_qs)
+  );
+
+
+  //   F[core_data]: 3:2
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_bus_qos_core_data (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_core_data_we),
+      .wd(bus_qos_core_data_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.core_data.q),
+
+      // to register interface (read)
+      .qs(bus_qos_core_data_qs)
+  );
+
+
+  //   F[debug]: 5:4
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_bus_qos_debug (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_debug_we),
+      .wd(bus_qos_debug_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.debug.q),
+
+      // to register interface (read)
+      .qs(bus_qos_debug_qs)
+  );
+
+
+  //   F[dma_read]: 7:6
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_bus_qos_dma_read (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_dma_read_we),
+      .wd(bus_qos_dma_read_wd),
 
-  logic [7:0] addr_hit;
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.dma_read.q),
+
+      // to register interface (read)
+      .qs(bus_qos_dma_read_qs)
+  );
+
+
+  //   F[dma_write]: 9:8
+  prim_subreg #(
+      .DW      (2),
+      .SWACCESS("RW"),
+      .RESVAL  (2'h0)
+  ) u_bus_qos_dma_write (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_dma_write_we),
+      .wd(bus_qos_dma_write_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.dma_write.q),
+
+      // to register interface (read)
+      .qs(bus_qos_dma_write_qs)
+  );
+
+
+  //   F[override]: 16:16
+  prim_subreg #(
+      .DW      (1),
+      .SWACCESS("RW"),
+      .RESVAL  (1'h0)
+  ) u_bus_qos_override (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
+
+      // from register interface
+      .we(bus_qos_override_we),
+      .wd(bus_qos_override_wd),
+
+      // from internal hardware
+      .de(1'b0),
+      .d ('0),
+
+      // to internal hardware
+      .qe(),
+      .q (reg2hw.bus_qos.override.q),
+
+      // to register interface (read)
+      .qs(bus_qos_override_qs)
+  );
+
+
+
+
+  logic [8:0] addr_hit;
   always_comb begin
     addr_hit = '0;
     addr_hit[0] = (reg_addr == SOC_CTRL_EXIT_VALID_OFFSET);
@@ -320,6 +496,7 @@ module soc_ctrl_reg_top #(
     addr_hit[5] = (reg_addr == SOC_CTRL_USE_SPIMEMIO_OFFSET);
     addr_hit[6] = (reg_addr == SOC_CTRL_ENABLE_SPI_SEL_OFFSET);
     addr_hit[7] = (reg_addr == SOC_CTRL_SYSTEM_FREQUENCY_HZ_OFFSET);
+    addr_hit[8] = (reg_addr == SOC_CTRL_BUS_QOS_OFFSET);
   end
 
   assign addrmiss = (reg_re || reg_we) ? ~|addr_hit : 1'b0;
@@ -334,7 +511,8 @@ module soc_ctrl_reg_top #(
                (addr_hit[4] & (|(SOC_CTRL_PERMIT[4] & ~reg_be))) |
                (addr_hit[5] & (|(SOC_CTRL_PERMIT[5] & ~reg_be))) |
                (addr_hit[6] & (|(SOC_CTRL_PERMIT[6] & ~reg_be))) |
-               (addr_hit[7] & (|(SOC_CTRL_PERMIT[7] & ~reg_be)))));
+               (addr_hit[7] & (|(SOC_CTRL_PERMIT[7] & ~reg_be))) |
+               (addr_hit[8] & (|(SOC_CTRL_PERMIT[8] & ~reg_be)))));
   end
 
   assign exit_valid_we = addr_hit[0] & reg_we & !reg_error;
@@ -358,6 +536,24 @@ module soc_ctrl_reg_top #(
   assign system_frequency_hz_we = addr_hit[7] & reg_we & !reg_error;
   assign system_frequency_hz_wd = reg_wdata[31:0];
 
+  assign bus_qos_core_instr_we = addr_hit[8] & reg_we & !reg_error;
+  assign bus_qos_core_instr_wd = reg_wdata[1:0];
+
+  assign bus_qos_core_data_we = addr_hit[8] & reg_we & !reg_error;
+  assign bus_qos_core_data_wd = reg_wdata[3:2];
+
+  assign bus_qos_debug_we = addr_hit[8] & reg_we & !reg_error;
+  assign bus_qos_debug_wd = reg_wdata[5:4];
+
+  assign bus_qos_dma_read_we = addr_hit[8] & reg_we & !reg_error;
+  assign bus_qos_dma_read_wd = reg_wdata[7:6];
+
+  assign bus_qos_dma_write_we = addr_hit[8] & reg_we & !reg_error;
+  assign bus_qos_dma_write_wd = reg_wdata[9:8];
+
+  assign bus_qos_override_we = addr_hit[8] & reg_we & !reg_error;
+  assign bus_qos_override_wd = reg_wdata[16];
+
   // Read data return
   always_comb begin
     reg_rdata_next = '0;
@@ -394,6 +590,15 @@ module soc_ctrl_reg_top #(
         reg_rdata_next[31:0] = system_frequency_hz_qs;
       end
 
+      addr_hit[8]: begin
+        reg_rdata_next[1:0] = bus_qos_core_instr_qs;
+        reg_rdata_next[3:2] = bus_qos_core_data_qs;
+        reg_rdata_next[5:4] = bus_qos_debug_qs;
+        reg_rdata_next[7:6] = bus_qos_dma_read_qs;
+        reg_rdata_next[9:8] = bus_qos_dma_write_qs;
+        reg_rdata_next[16]  = bus_qos_override_qs;
+      end
+
       default: begin
         reg_rdata_next = '1;
       end
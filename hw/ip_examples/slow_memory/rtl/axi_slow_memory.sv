@@ -0,0 +1,150 @@
+// Copyright 2022 OpenHW Group
+// Solderpad Hardware License, Version 2.1, see LICENSE.md for details.
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+
+// AXI4 version of slow_memory, for the external slave port generated with ext_slaves protocol axi.
+// One burst at a time, INCR bursts only, with randomly stalled AW, W and AR channels.
+
+module axi_slow_memory #(
+    parameter int unsigned NumWords = 32'd1024,  // Number of data words
+    parameter int unsigned DataWidth = 32'd32,  // AXI data width
+    parameter type axi_req_t = logic,
+    parameter type axi_resp_t = logic,
+    // DEPENDENT PARAMETERS, DO NOT OVERWRITE!
+    parameter int unsigned AddrWidth = (NumWords > 32'd1) ? $clog2(NumWords) : 32'd1
+) (
+    input logic clk_i,  // Clock
+    input logic rst_ni,  // Asynchronous reset active low
+
+    input  axi_req_t  axi_req_i,
+    output axi_resp_t axi_resp_o
+);
+
+  localparam int unsigned BEAT_OFFSET = $clog2(DataWidth / 8);
+
+  typedef enum logic [2:0] {
+    IDLE,
+    WRITE,
+    WRITE_RESP,
+    READ,
+    READ_RESP
+  } axi_slow_memory_fsm_e;
+
+  axi_slow_memory_fsm_e state_q, state_n;
+
+  logic [AddrWidth-1:0] addr_q, addr_n;
+  logic [7:0] len_q, len_n;
+  logic [$bits(axi_req_i.aw.id)-1:0] id_q, id_n;
+
+  logic mem_req;
+  logic mem_we;
+  logic [DataWidth-1:0] mem_rdata;
+
+  int random1;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : proc_axi_slow_memory
+    if (~rst_ni) begin
+      state_q <= IDLE;
+      addr_q  <= '0;
+      len_q   <= '0;
+      id_q    <= '0;
+    end else begin
+      random1 <= $random();
+      state_q <= state_n;
+      addr_q  <= addr_n;
+      len_q   <= len_n;
+      id_q    <= id_n;
+    end
+  end
+
+  always_comb begin
+    axi_resp_o = '0;
+    state_n = state_q;
+    addr_n = addr_q;
+    len_n = len_q;
+    id_n = id_q;
+    mem_req = 1'b0;
+    mem_we = 1'b0;
+
+    unique case (state_q)
+
+      IDLE: begin
+        if (axi_req_i.aw_valid) begin
+          axi_resp_o.aw_ready = random1[0];
+          if (axi_resp_o.aw_ready) begin
+            state_n = WRITE;
+            addr_n  = axi_req_i.aw.addr[AddrWidth+BEAT_OFFSET-1:BEAT_OFFSET];
+            len_n   = axi_req_i.aw.len;
+            id_n    = axi_req_i.aw.id;
+          end
+        end else if (axi_req_i.ar_valid) begin
+          axi_resp_o.ar_ready = random1[0];
+          if (axi_resp_o.ar_ready) begin
+            state_n = READ;
+            addr_n  = axi_req_i.ar.addr[AddrWidth+BEAT_OFFSET-1:BEAT_OFFSET];
+            len_n   = axi_req_i.ar.len;
+            id_n    = axi_req_i.ar.id;
+          end
+        end
+      end
+
+      WRITE: begin
+        axi_resp_o.w_ready = random1[1];
+        if (axi_req_i.w_valid && axi_resp_o.w_ready) begin
+          mem_req = 1'b1;
+          mem_we  = 1'b1;
+          addr_n  = addr_q + 1;
+          if (axi_req_i.w.last) begin
+            state_n = WRITE_RESP;
+          end
+        end
+      end
+
+      WRITE_RESP: begin
+        axi_resp_o.b_valid = 1'b1;
+        axi_resp_o.b.id = id_q;
+        axi_resp_o.b.resp = axi_pkg::RESP_OKAY;
+        if (axi_req_i.b_ready) begin
+          state_n = IDLE;
+        end
+      end
+
+      READ: begin
+        mem_req = 1'b1;
+        state_n = READ_RESP;
+      end
+
+      READ_RESP: begin
+        axi_resp_o.r_valid = 1'b1;
+        axi_resp_o.r.data = mem_rdata;
+        axi_resp_o.r.id = id_q;
+        axi_resp_o.r.resp = axi_pkg::RESP_OKAY;
+        axi_resp_o.r.last = len_q == '0;
+        if (axi_req_i.r_ready) begin
+          addr_n  = addr_q + 1;
+          len_n   = len_q - 1;
+          state_n = len_q == '0 ? IDLE : READ;
+        end
+      end
+
+      default: state_n = IDLE;
+    endcase
+  end
+
+  tc_sram #(
+      .NumWords (NumWords),
+      .DataWidth(DataWidth),
+      .NumPorts (32'd1)
+  ) tc_ram_i (
+      .clk_i  (clk_i),
+      .rst_ni (rst_ni),
+      .req_i  (mem_req),
+      .we_i   (mem_we),
+      .addr_i (addr_q),
+      .wdata_i(axi_req_i.w.data),
+      .be_i   (axi_req_i.w.strb),
+      // output ports
+      .rdata_o(mem_rdata)
+  );
+
+endmodule
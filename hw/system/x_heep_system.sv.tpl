@@ -26,6 +26,9 @@ module x_heep_system
     output obi_req_t  ext_xbar_slave_req_o,
     input  obi_resp_t ext_xbar_slave_resp_i,
 
+    output core_v_mini_mcu_pkg::ext_axi_req_t  ext_axi_slave_req_o,
+    input  core_v_mini_mcu_pkg::ext_axi_resp_t ext_axi_slave_resp_i,
+
     output reg_req_t ext_peripheral_slave_req_o,
     input  reg_rsp_t ext_peripheral_slave_resp_i,
 
@@ -104,6 +107,8 @@ ${pad.core_v_mini_mcu_bonding}
     .ext_xbar_master_resp_o,
     .ext_xbar_slave_req_o,
     .ext_xbar_slave_resp_i,
+    .ext_axi_slave_req_o,
+    .ext_axi_slave_resp_i,
     .ext_peripheral_slave_req_o,
     .ext_peripheral_slave_resp_i,
     .cpu_subsystem_powergate_switch_o(cpu_subsystem_powergate_switch),
@@ -0,0 +1,164 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Average and worst case cycles of one allocation and one free with newlib
+// malloc, a fixed size pool (with and without lock) and an arena, for a
+// packet-like pattern: a few objects allocated, then freed out of order.
+// The arena has no per-object free, its reset freeing a whole round is
+// reported instead.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "pool.h"
+#include "arena.h"
+#include "alloc_lock.h"
+
+#define OBJ_SIZE 64
+#define NUM_OBJS 16
+#define ROUNDS 8
+
+POOL_DEFINE(bench_pool, OBJ_SIZE, NUM_OBJS);
+ARENA_DEFINE(bench_arena, OBJ_SIZE * NUM_OBJS);
+
+enum {
+    MALLOC,
+    POOL,
+    POOL_LOCKED,
+    ARENA,
+    NUM_METHODS
+};
+
+static const char *method_names[NUM_METHODS] = {
+    "malloc", "pool", "pool+lock", "arena"
+};
+
+typedef struct {
+    uint32_t total;
+    uint32_t max;
+    uint32_t count;
+} stats_t;
+
+// Lock disabling the machine interrupts, as a FreeRTOS critical section would
+uint32_t irq_lock(void)
+{
+    uint32_t mstatus;
+    CSR_READ(CSR_REG_MSTATUS, &mstatus);
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    return mstatus;
+}
+
+void irq_unlock(uint32_t mstatus)
+{
+    if (mstatus & 0x8) {
+        CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    }
+}
+
+static inline void account(stats_t *stats, uint32_t cycles)
+{
+    stats->total += cycles;
+    stats->count++;
+    if (cycles > stats->max) {
+        stats->max = cycles;
+    }
+}
+
+void * __attribute__ ((noinline)) do_alloc(int method)
+{
+    switch (method) {
+        case MALLOC:
+            return malloc(OBJ_SIZE);
+        case ARENA:
+            return arena_alloc(&bench_arena, OBJ_SIZE);
+        default:
+            return pool_alloc(&bench_pool);
+    }
+}
+
+void __attribute__ ((noinline)) do_free(int method, void *obj)
+{
+    if (method == MALLOC) {
+        free(obj);
+    } else {
+        pool_free(&bench_pool, obj);
+    }
+}
+
+int run(int method, stats_t *alloc_stats, stats_t *free_stats, stats_t *reset_stats)
+{
+    void *objs[NUM_OBJS];
+    uint32_t cycles;
+
+    if (method == POOL_LOCKED) {
+        alloc_set_lock(irq_lock, irq_unlock);
+    } else {
+        alloc_set_lock(NULL, NULL);
+    }
+
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < NUM_OBJS; i++) {
+            CSR_WRITE(CSR_REG_MCYCLE, 0);
+            objs[i] = do_alloc(method);
+            CSR_READ(CSR_REG_MCYCLE, &cycles);
+            if (objs[i] == NULL) {
+                return -1;
+            }
+            account(alloc_stats, cycles);
+            // touch the object
+            ((volatile uint32_t *) objs[i])[0] = i;
+        }
+        if (method == ARENA) {
+            // freed all at once by the reset
+            CSR_WRITE(CSR_REG_MCYCLE, 0);
+            arena_reset(&bench_arena);
+            CSR_READ(CSR_REG_MCYCLE, &cycles);
+            account(reset_stats, cycles);
+            continue;
+        }
+        // free the even objects first, then the odd ones
+        for (int k = 0; k < 2; k++) {
+            for (int i = k; i < NUM_OBJS; i += 2) {
+                CSR_WRITE(CSR_REG_MCYCLE, 0);
+                do_free(method, objs[i]);
+                CSR_READ(CSR_REG_MCYCLE, &cycles);
+                account(free_stats, cycles);
+            }
+        }
+    }
+
+    alloc_set_lock(NULL, NULL);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    printf("--- ALLOC BENCHMARK ---\n");
+    printf("%d objects of %d bytes, %d rounds\n", NUM_OBJS, OBJ_SIZE, ROUNDS);
+    printf("method: alloc avg/max, free avg/max (cycles)\n");
+    printf("(arena: alloc avg/max, reset of %d objects avg/max)\n", NUM_OBJS);
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    for (int method = 0; method < NUM_METHODS; method++) {
+        stats_t alloc_stats = { 0 };
+        stats_t free_stats = { 0 };
+        stats_t reset_stats = { 0 };
+
+        if (run(method, &alloc_stats, &free_stats, &reset_stats) != 0) {
+            printf("%s: out of memory\n", method_names[method]);
+            return EXIT_FAILURE;
+        }
+        stats_t *release = method == ARENA ? &reset_stats : &free_stats;
+        printf("%s: %d/%d, %d/%d\n", method_names[method],
+               alloc_stats.total / alloc_stats.count, alloc_stats.max,
+               release->total / release->count, release->max);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,45 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Cycles from reset to main: boot ROM, copy of the image from the flash and
+// crt0. The boot ROM enables mcycle, which is not reset afterwards.
+// Build it with LINKER=flash_load and run it with boot_sel=1
+// execute_from_flash=0, with the other boot modes the count includes the time
+// waiting for the debugger or for the testbench to load the memories.
+// Build it with and without COMPRESS=1 to compare the boot time of the
+// compressed and uncompressed images.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "spi_flash.h"
+
+int main(int argc, char *argv[])
+{
+    uint32_t cycles;
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+
+#ifdef FLASH_LOAD
+    // boot header in the FLASH, with the SPI flash host as set up by the boot ROM
+    spi_flash_t flash = {
+        .spi = { .base_addr = mmio_region_from_addr((uintptr_t)SPI_FLASH_START_ADDRESS) },
+        .csid = 0,
+        .use_dma = false,
+        .size = FLASH_MEM_SIZE,
+    };
+    uint32_t header[3];
+    spi_flash_read(&flash, FLASH_BOOT_HEADER_ADDRESS, header, sizeof(header), kSpiFlashReadStandard);
+    if (header[0] == FLASH_BOOT_HEADER_MAGIC) {
+        printf("image: %d bytes\n", header[1]);
+    } else if (header[0] == FLASH_BOOT_HEADER_MAGIC_LZ4) {
+        printf("image: %d bytes, LZ4: %d bytes\n", header[1], header[2]);
+    }
+#endif
+    printf("boot: %d cycles\n", cycles);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "dma_async.h"
+
+#define TEST_DATA_SIZE 64
+#define TEST_JOBS 4
+
+uint32_t test_data[TEST_JOBS][TEST_DATA_SIZE] __attribute__ ((aligned (4)));
+uint32_t copied_data[TEST_JOBS][TEST_DATA_SIZE] __attribute__ ((aligned (4))) = { 0 };
+
+volatile uint32_t callbacks_done;
+
+// Called from the DMA interrupt once a job is done
+void copy_done(void *ctx)
+{
+    volatile uint32_t *counter = (volatile uint32_t *) ctx;
+    (*counter)++;
+}
+
+int main(int argc, char *argv[])
+{
+    printf("--- DMA ASYNC EXAMPLE ---\n");
+
+    for (int j = 0; j < TEST_JOBS; j++) {
+        for (int i = 0; i < TEST_DATA_SIZE; i++) {
+            test_data[j][i] = (j << 16) | i;
+        }
+    }
+
+    // dma peripheral structure to access the registers
+    dma_t dma;
+    dma.base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS);
+
+    dma_async_init(&dma);
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    // Queue all the copies, the DMA chains them back to back from its interrupt
+    dma_job_id_t ids[TEST_JOBS];
+    for (int j = 0; j < TEST_JOBS; j++) {
+        dma_job_t job = {
+            .src = (uint32_t) test_data[j],
+            .dst = (uint32_t) copied_data[j],
+            .size = TEST_DATA_SIZE*sizeof(uint32_t),
+            .src_inc = 4,
+            .dst_inc = 4,
+            .src_type = 0,
+            .dst_type = 0,
+        };
+        ids[j] = dma_submit(&job, copy_done, (void *) &callbacks_done);
+        if (ids[j] == DMA_ASYNC_INVALID_JOB) {
+            printf("Job %d not submitted\n", j);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The last job is still waiting in the queue, remove it
+    bool cancelled = dma_cancel(ids[TEST_JOBS - 1]);
+    printf("Last job cancelled: %d\n", cancelled);
+
+    dma_wait_all();
+
+    int32_t errors = 0;
+    uint32_t jobs_copied = cancelled ? TEST_JOBS - 1 : TEST_JOBS;
+    for (int j = 0; j < jobs_copied; j++) {
+        for (int i = 0; i < TEST_DATA_SIZE; i++) {
+            if (copied_data[j][i] != test_data[j][i]) {
+                printf("ERROR COPY [%d][%d]: %08x != %08x\n", j, i, copied_data[j][i], test_data[j][i]);
+                errors++;
+            }
+        }
+    }
+    if (callbacks_done != jobs_copied) {
+        printf("ERROR: %d callbacks for %d jobs\n", callbacks_done, jobs_copied);
+        errors++;
+    }
+
+    if (errors == 0) {
+        printf("DMA async transfers success\n");
+        return EXIT_SUCCESS;
+    } else {
+        printf("DMA async transfers failure: %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -20,6 +20,9 @@
 #define TEST_WORD
 #define TEST_HALF_WORD
 #define TEST_BYTE
+#define TEST_PACKING
+#define TEST_SIGN_EXTENSION
+#define TEST_FILL
 
 #define HALF_WORD_INPUT_OFFSET 0
 #define HALF_WORD_OUTPUT_OFFSET 1 // Applied at begining and end of the output vector, which should not be overwriten.
@@ -38,6 +41,16 @@ uint32_t copied_data_4B[TEST_DATA_SIZE] __attribute__ ((aligned (4))) = { 0 };
 uint16_t copied_data_2B[TEST_DATA_SIZE] __attribute__ ((aligned (2))) = { 0 };
 uint8_t copied_data_1B[TEST_DATA_SIZE] = { 0 };
 
+// 16-bit signed samples to be sign extended into 32-bit words
+int16_t test_data_pcm[TEST_DATA_SIZE] __attribute__ ((aligned (4))) = {
+  0x0123, -1, 0x7fff, -32768, 0x1a2b, -1234, 0x0000, -42, 0x5555, -21846, 0x0001, -2, 0x7abc, -31000, 0x00ff, -256};
+
+uint32_t packed_data_4B[TEST_DATA_SIZE/4] __attribute__ ((aligned (4))) = { 0 };
+int32_t extended_data_4B[TEST_DATA_SIZE] __attribute__ ((aligned (4))) = { 0 };
+
+#define FILL_PATTERN 0xbeef
+uint16_t filled_data_2B[TEST_DATA_SIZE] __attribute__ ((aligned (4))) = { 0 };
+
 int8_t dma_intr_flag;
 
 void fic_irq_dma(void)
@@ -62,6 +75,7 @@ int main(int argc, char *argv[])
     // dma peripheral structure to access the registers
     dma_t dma;
     dma.base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS);
+    dma_clear_stats(&dma);
 
     #ifdef TEST_WORD
         // -- DMA CONFIG -- //
@@ -119,6 +133,66 @@ int main(int argc, char *argv[])
         }
     #endif // TEST_BYTE
 
+    #ifdef TEST_PACKING
+        // -- DMA CONFIG -- //
+        dma_set_read_ptr(&dma, (uint32_t) test_data_1B);
+        dma_set_write_ptr(&dma, (uint32_t) packed_data_4B);
+        dma_set_read_ptr_inc(&dma, (uint32_t) 1);
+        dma_set_write_ptr_inc(&dma, (uint32_t) 4);
+        dma_set_spi_mode(&dma, (uint32_t) 0);
+        dma_set_src_data_type(&dma, (uint32_t) 2);
+        dma_set_dst_data_type(&dma, (uint32_t) 0);
+        dma_set_extend(&dma, false, false);
+        printf("DMA packing transaction launched\n");
+        // Read TEST_DATA_SIZE bytes and write them as TEST_DATA_SIZE/4 words
+        dma_set_cnt_start(&dma, (uint32_t) TEST_DATA_SIZE*sizeof(*test_data_1B));
+        // Wait copy is done
+        dma_intr_flag = 0;
+        while(dma_intr_flag==0) {
+            wait_for_interrupt();
+        }
+    #endif // TEST_PACKING
+
+    #ifdef TEST_SIGN_EXTENSION
+        // -- DMA CONFIG -- //
+        dma_set_read_ptr(&dma, (uint32_t) test_data_pcm);
+        dma_set_write_ptr(&dma, (uint32_t) extended_data_4B);
+        dma_set_read_ptr_inc(&dma, (uint32_t) 2);
+        dma_set_write_ptr_inc(&dma, (uint32_t) 4);
+        dma_set_spi_mode(&dma, (uint32_t) 0);
+        dma_set_src_data_type(&dma, (uint32_t) 1);
+        dma_set_dst_data_type(&dma, (uint32_t) 0);
+        dma_set_extend(&dma, true, true);
+        printf("DMA sign extension transaction launched\n");
+        // The size is given in source bytes
+        dma_set_cnt_start(&dma, (uint32_t) TEST_DATA_SIZE*sizeof(*test_data_pcm));
+        // Wait copy is done
+        dma_intr_flag = 0;
+        while(dma_intr_flag==0) {
+            wait_for_interrupt();
+        }
+        dma_set_extend(&dma, false, false);
+    #endif // TEST_SIGN_EXTENSION
+
+    #ifdef TEST_FILL
+        // -- DMA CONFIG -- //
+        // Leave the first and last half-words untouched
+        dma_set_write_ptr(&dma, (uint32_t) &filled_data_2B[1]);
+        dma_set_write_ptr_inc(&dma, (uint32_t) 2);
+        dma_set_spi_mode(&dma, (uint32_t) 0);
+        dma_set_data_type(&dma, (uint32_t) 1);
+        dma_set_fill(&dma, true, FILL_PATTERN);
+        printf("DMA fill transaction launched\n");
+        // The size is given in destination bytes, nothing is read
+        dma_set_cnt_start(&dma, (uint32_t) (TEST_DATA_SIZE - 2)*sizeof(*filled_data_2B));
+        // Wait copy is done
+        dma_intr_flag = 0;
+        while(dma_intr_flag==0) {
+            wait_for_interrupt();
+        }
+        dma_set_fill(&dma, false, 0);
+    #endif // TEST_FILL
+
     int32_t errors;
 
     #ifdef TEST_WORD
@@ -192,6 +266,60 @@ int main(int argc, char *argv[])
         }
     #endif // TEST_BYTE
 
+    #ifdef TEST_PACKING
+        errors = 0;
+        for (int i=0; i<TEST_DATA_SIZE/4; i++) {
+            if(packed_data_4B[i] != test_data_4B[i]) {
+                printf("ERROR PACK [%d]: %08x != %08x\n", i, packed_data_4B[i], test_data_4B[i]);
+                errors++;
+            }
+        }
+
+        if (errors == 0) {
+            printf("DMA packing transfer success\n");
+        } else {
+            printf("DMA packing transfer failure: %d errors out of %d words checked\n", errors, TEST_DATA_SIZE/4);
+        }
+    #endif // TEST_PACKING
+
+    #ifdef TEST_SIGN_EXTENSION
+        errors = 0;
+        for (int i=0; i<TEST_DATA_SIZE; i++) {
+            if(extended_data_4B[i] != (int32_t) test_data_pcm[i]) {
+                printf("ERROR EXTEND [%d]: %08x != %08x\n", i, extended_data_4B[i], (int32_t) test_data_pcm[i]);
+                errors++;
+            }
+        }
+
+        if (errors == 0) {
+            printf("DMA sign extension transfer success\n");
+        } else {
+            printf("DMA sign extension transfer failure: %d errors out of %d words checked\n", errors, TEST_DATA_SIZE);
+        }
+    #endif // TEST_SIGN_EXTENSION
+
+    #ifdef TEST_FILL
+        errors = 0;
+        for (int i=0; i<TEST_DATA_SIZE; i++) {
+            uint16_t expected = (i == 0 || i == TEST_DATA_SIZE - 1) ? 0 : FILL_PATTERN;
+            if(filled_data_2B[i] != expected) {
+                printf("ERROR FILL [%d]: %04x != %04x\n", i, filled_data_2B[i], expected);
+                errors++;
+            }
+        }
+
+        if (errors == 0) {
+            printf("DMA fill transfer success\n");
+        } else {
+            printf("DMA fill transfer failure: %d errors out of %d half-words checked\n", errors, TEST_DATA_SIZE);
+        }
+    #endif // TEST_FILL
+
+    dma_stats_t stats;
+    dma_get_stats(&dma, &stats);
+    printf("DMA stats: %d bytes, %d busy cycles, %d slot stalls, %d read stalls, %d write stalls\n",
+           stats.bytes, stats.busy_cycles, stats.slot_stall_cycles, stats.read_stall_cycles, stats.write_stall_cycles);
+
     enable_fast_interrupt(kDma_fic_e, false);
 
     return EXIT_SUCCESS;
@@ -0,0 +1,105 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "power_manager.h"
+#include "bank_heap.h"
+
+#define TEST_BUFFERS 8
+#define TEST_BUFFER_SIZE 4096
+
+static power_manager_t power_manager;
+
+static void print_banks(void)
+{
+    bank_heap_bank_info_t info;
+
+    for (uint32_t i = 0; i < bank_heap_num_banks(); i++) {
+        if (bank_heap_bank_info(i, &info)) {
+            printf("bank %d: %d/%d bytes, %d allocations, state %d\n", i, info.used, info.heap_size, info.allocations, info.state);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+
+#if MEMORY_BANKS > 2
+    // Setup power_manager
+    mmio_region_t power_manager_reg = mmio_region_from_addr(POWER_MANAGER_START_ADDRESS);
+    power_manager.base_addr = power_manager_reg;
+
+    power_manager_counters_t power_manager_ram_blocks_counters;
+
+    // Init ram blocks counters
+    if (power_gate_counters_init(&power_manager_ram_blocks_counters, 30, 30, 30, 30, 30, 30, 0, 0) != kPowerManagerOk_e)
+    {
+        printf("Error: power manager fail. Check the reset and powergate counters value\n");
+        return EXIT_FAILURE;
+    }
+
+    bank_heap_init(&power_manager, &power_manager_ram_blocks_counters);
+
+    // Allocate from the lowest banks first
+    uint8_t *buffers[TEST_BUFFERS];
+    uint32_t allocated = 0;
+    for (uint32_t i = 0; i < TEST_BUFFERS; i++) {
+        buffers[i] = bank_heap_alloc(TEST_BUFFER_SIZE);
+        if (buffers[i] == NULL) {
+            break;
+        }
+        memset(buffers[i], i, TEST_BUFFER_SIZE);
+        allocated++;
+    }
+    printf("%d buffers allocated\n", allocated);
+    print_banks();
+
+    // Keep only the first buffer, the banks left empty can be switched off
+    for (uint32_t i = 1; i < allocated; i++) {
+        bank_heap_free(buffers[i]);
+    }
+    uint32_t released = bank_heap_compact_and_release(kOff_e);
+    printf("%d banks switched off\n", released);
+    print_banks();
+
+    // The banks are switched back on when needed
+    for (uint32_t i = 1; i < allocated; i++) {
+        buffers[i] = bank_heap_alloc(TEST_BUFFER_SIZE);
+        if (buffers[i] == NULL) {
+            printf("Error: allocation %d failed after release\n", i);
+            return EXIT_FAILURE;
+        }
+        memset(buffers[i], i, TEST_BUFFER_SIZE);
+    }
+
+    int32_t errors = 0;
+    for (uint32_t i = 0; i < allocated; i++) {
+        for (uint32_t j = 0; j < TEST_BUFFER_SIZE; j++) {
+            if (buffers[i][j] != (uint8_t) i) {
+                errors++;
+                break;
+            }
+        }
+        bank_heap_free(buffers[i]);
+    }
+    bank_heap_compact_and_release(kOff_e);
+
+    if (errors == 0) {
+        printf("Success.\n");
+        return EXIT_SUCCESS;
+    } else {
+        printf("Failure: %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+
+#else
+    #pragma message ( "this application can run only when MEMORY_BANKS > 2" )
+    return EXIT_FAILURE;
+#endif
+
+}
@@ -0,0 +1,66 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Cycles taken by printf and by the deferred logs of dlog.h.
+// The output is decoded with:
+//   util/dlog_decode.py sw/build/main.elf uart0.log
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+#include "uart.h"
+#include "dlog.h"
+#include "x-heep.h"
+
+#define NUM_STEPS 8
+#define LOG_WORDS 128
+
+static uint32_t log_buffer[LOG_WORDS];
+
+static const char *state_names[] = {"idle", "ramp", "hold"};
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    uart_t uart;
+    uart.base_addr   = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    uart.baudrate    = UART_BAUDRATE;
+    uart.clk_freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
+
+    uint32_t start, end, printf_cycles, dlog_cycles;
+    int32_t setpoint = 100;
+    int32_t speed = 0;
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dlog_init(log_buffer, LOG_WORDS);
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    printf("step %d: speed %d, error %d, state %s\n", 0, speed, setpoint - speed, state_names[0]);
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    printf_cycles = end - start;
+
+    // Control loop, logged without slowing it down
+    for (int32_t step = 1; step <= NUM_STEPS; step++) {
+        speed += (setpoint - speed) / 2;
+        CSR_READ(CSR_REG_MCYCLE, &start);
+        DLOG("step %d: speed %d, error %d, state %s\n", step, speed, setpoint - speed,
+             state_names[step < NUM_STEPS ? 1 : 2]);
+        CSR_READ(CSR_REG_MCYCLE, &end);
+        dlog_cycles = end - start;
+    }
+
+    DLOG("printf: %u cycles, DLOG: %u cycles\n", printf_cycles, dlog_cycles);
+    dlog_drain(&uart);
+
+    printf("success\n");
+    return EXIT_SUCCESS;
+}
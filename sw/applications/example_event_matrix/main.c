@@ -0,0 +1,164 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Sense-and-transfer sequence run by the event matrix while the core is
+// power-gated: a tick of the always-on rv_timer 1 starts the DMA, the end of
+// the DMA stops the timer and toggles the always-on GPIO 0. The core only
+// starts the timer (from software) and wakes up on the DMA interrupt.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "event_matrix.h"
+#include "fast_intr_ctrl.h"
+#include "gpio.h"
+#include "hart.h"
+#include "power_manager.h"
+#include "rv_timer.h"
+
+// Clock cycles before the transfer
+#define TIMER_PERIOD 1000
+#define NUM_SAMPLES 16
+#define GPIO_EVENT 0
+
+#define TIMER_HART 1
+
+// Event matrix channels
+#define CH_TICK_DMA 0
+#define CH_DONE_TIMER 1
+#define CH_DONE_GPIO 2
+#define CH_SW_TIMER 3
+
+static uint32_t samples[NUM_SAMPLES];
+static uint32_t copy[NUM_SAMPLES];
+
+static power_manager_t power_manager;
+
+static volatile int8_t dma_intr_flag;
+
+void fic_irq_dma(void)
+{
+    dma_intr_flag = 1;
+}
+
+int main(int argc, char *argv[])
+{
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        samples[i] = i * 0x01010101;
+        copy[i] = 0;
+    }
+
+    event_matrix_t em;
+    em.base_addr = mmio_region_from_addr((uintptr_t)EVENT_MATRIX_START_ADDRESS);
+
+    // The transfer, started by the event matrix
+    dma_t dma;
+    dma.base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS);
+    dma_set_read_ptr_inc(&dma, 4);
+    dma_set_write_ptr_inc(&dma, 4);
+    dma_set_read_ptr(&dma, (uint32_t)samples);
+    dma_set_write_ptr(&dma, (uint32_t)copy);
+    dma_set_data_type(&dma, 0);
+    dma_set_slot(&dma, 0, 0);
+    event_matrix_set_dma_size(&em, NUM_SAMPLES * sizeof(uint32_t));
+    dma_set_ext_start(&dma, true);
+
+    // The always-on GPIO 0 is driven by the event matrix
+    gpio_t gpio;
+    gpio_init((gpio_params_t){.base_addr = mmio_region_from_addr((uintptr_t)GPIO_AO_START_ADDRESS)}, &gpio);
+    gpio_output_set_enabled(&gpio, GPIO_EVENT, true);
+    event_matrix_set_gpio(&em, GPIO_EVENT, true, false);
+
+    // rv_timer 1 is enabled but held until the timer start action
+    rv_timer_t timer;
+    rv_timer_init(mmio_region_from_addr(RV_TIMER_AO_START_ADDRESS),
+                  (rv_timer_config_t){.hart_count = 2, .comparator_count = 1}, &timer);
+    event_matrix_set_timer_gate(&em, TIMER_HART, true, false);
+    rv_timer_set_tick_params(&timer, TIMER_HART,
+                             (rv_timer_tick_params_t){.prescale = TIMER_PERIOD - 1, .tick_step = 1});
+    rv_timer_counter_set_enabled(&timer, TIMER_HART, kRvTimerEnabled);
+
+    if (!event_matrix_connect(&em, CH_TICK_DMA, EVENT_MATRIX_SRC_TIMER_TICK(TIMER_HART),
+                              kEventMatrixEdgeRising, kEventMatrixDmaStart, 0) ||
+        !event_matrix_connect(&em, CH_DONE_TIMER, EVENT_MATRIX_SRC_FAST_INTR(kDma_fic_e),
+                              kEventMatrixEdgeRising, kEventMatrixTimerStop, TIMER_HART) ||
+        !event_matrix_connect(&em, CH_DONE_GPIO, EVENT_MATRIX_SRC_FAST_INTR(kDma_fic_e),
+                              kEventMatrixEdgeRising, kEventMatrixGpioToggle, GPIO_EVENT) ||
+        !event_matrix_connect(&em, CH_SW_TIMER, 0,
+                              kEventMatrixEdgeNone, kEventMatrixTimerStart, TIMER_HART)) {
+        printf("event_matrix_connect failed, at least 4 channels are needed\n");
+        return EXIT_FAILURE;
+    }
+
+    // Setup power_manager
+    power_manager.base_addr = mmio_region_from_addr(POWER_MANAGER_START_ADDRESS);
+    power_manager_counters_t power_manager_cpu_counters;
+    if (power_gate_counters_init(&power_manager_cpu_counters, 30, 30, 30, 30, 30, 30, 0, 0) != kPowerManagerOk_e)
+    {
+        printf("Error: power manager fail. Check the reset and powergate counters value\n");
+        return EXIT_FAILURE;
+    }
+
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    // Set mie.MEIE bit to one to enable machine-level fast dma interrupt
+    const uint32_t mask = 1 << 19;
+    CSR_SET_BITS(CSR_REG_MIE, mask);
+
+    dma_intr_flag = 0;
+    event_matrix_trigger(&em, CH_SW_TIMER);
+
+    // Power gate core and wait for fast DMA interrupt
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    if (dma_intr_flag == 0) {
+        if (power_gate_core(&power_manager, kDma_pm_e, &power_manager_cpu_counters) != kPowerManagerOk_e)
+        {
+            printf("Error: power manager fail.\n");
+            return EXIT_FAILURE;
+        }
+    }
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    while (dma_intr_flag == 0) {
+        wait_for_interrupt();
+    }
+
+    uint32_t errors = 0;
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        if (copy[i] != samples[i]) {
+            errors++;
+        }
+    }
+    if (event_matrix_timer_running(&em, TIMER_HART)) {
+        printf("the timer was not stopped\n");
+        errors++;
+    }
+    if (!event_matrix_get_gpio(&em, GPIO_EVENT)) {
+        printf("the GPIO was not toggled\n");
+        errors++;
+    }
+    for (int ch = 0; ch < 4; ch++) {
+        if (!event_matrix_fired(&em, ch)) {
+            printf("channel %d did not fire\n", ch);
+            errors++;
+        }
+        event_matrix_clear_fired(&em, ch);
+    }
+
+    rv_timer_counter_set_enabled(&timer, TIMER_HART, kRvTimerDisabled);
+    event_matrix_set_timer_gate(&em, TIMER_HART, false, false);
+    dma_set_ext_start(&dma, false);
+
+    if (errors == 0) {
+        printf("success\n");
+    } else {
+        printf("failure, %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
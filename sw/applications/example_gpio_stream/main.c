@@ -0,0 +1,230 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Pattern played on a GPIO by the DMA, one sample per tick of the always-on
+// rv_timer 1, while the CPU timestamps the edges seen on the input pin. Then
+// the input pin captured the same way by the DMA, while the CPU drives a
+// square wave on the output pin. The DMA has one channel, so playing and
+// capturing cannot overlap.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+#include "dma.h"
+#include "dma_async.h"
+#include "gpio.h"
+#include "gpio_stream.h"
+#include "gpio_regs.h"  // Generated.
+#include "pad_control.h"
+#include "pad_control_regs.h"  // Generated.
+
+/*
+Notes:
+ - Ports 30 and 31 are connected in questasim testbench, but in the FPGA version they are connected to the EPFL programmer and should not be used
+ - Connect a cable between the two pins for the applicatio to work
+*/
+
+#ifdef TARGET_PYNQ_Z2
+    #define GPIO_TB_OUT 8
+    #define GPIO_TB_IN  9
+    #pragma message ( "Connect a cable between GPIOs IN and OUT" )
+#else
+    #define GPIO_TB_OUT 30
+    #define GPIO_TB_IN  31
+#endif
+
+// Clock cycles per sample
+#define SAMPLE_PERIOD 200
+// Samples of each level of the played pattern, starting and ending high
+static const uint32_t runs[] = {1, 2, 3, 4, 2, 1, 3};
+#define NUM_RUNS (sizeof(runs) / sizeof(runs[0]))
+// Sum of the runs
+#define NUM_SAMPLES 16
+// Samples of each level of the square wave driven during the capture
+#define CAPTURE_HOLD 3
+
+static uint32_t pattern[NUM_SAMPLES];
+static uint32_t capture[NUM_SAMPLES];
+
+static volatile bool stream_done;
+
+static void stream_callback(void *ctx)
+{
+    (void) ctx;
+    stream_done = true;
+}
+
+static uint32_t check_duration(const char *what, uint32_t cycles)
+{
+    printf("%d samples %s in %u cycles\n", NUM_SAMPLES, what, cycles);
+    // One tick to start, the completion interrupt at the end
+    if (cycles < (NUM_SAMPLES - 1) * SAMPLE_PERIOD || cycles > (NUM_SAMPLES + 4) * SAMPLE_PERIOD) {
+        printf("%s: the samples were not paced\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+static inline uint32_t read_in(const gpio_t *gpio)
+{
+    return (mmio_region_read32(gpio->params.base_addr, GPIO_GPIO_IN_REG_OFFSET) >> GPIO_TB_IN) & 1;
+}
+
+static inline void write_out(const gpio_t *gpio, uint32_t level)
+{
+    mmio_region_write32(gpio->params.base_addr, GPIO_GPIO_OUT_REG_OFFSET, level << GPIO_TB_OUT);
+}
+
+// Play the pattern and compare the time between the edges seen on the input
+// with the runs.
+static uint32_t test_play(const gpio_t *gpio)
+{
+    uint32_t edges[NUM_RUNS];
+    uint32_t num_edges = 0;
+    uint32_t level = 0;
+    uint32_t start, end;
+    uint32_t errors = 0;
+
+    for (uint32_t r = 0, i = 0; r < NUM_RUNS; r++) {
+        for (uint32_t k = 0; k < runs[r]; k++, i++) {
+            pattern[i] = (r & 1) == 0 ? 1 << GPIO_TB_OUT : 0;
+        }
+    }
+
+    write_out(gpio, 0);
+    stream_done = false;
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    if (gpio_stream_play(gpio, pattern, NUM_SAMPLES, stream_callback, NULL) == DMA_ASYNC_INVALID_JOB) {
+        printf("gpio_stream_play failed\n");
+        return 1;
+    }
+    while (!stream_done) {
+        if (read_in(gpio) != level) {
+            if (num_edges < NUM_RUNS) {
+                CSR_READ(CSR_REG_MCYCLE, &edges[num_edges]);
+            }
+            num_edges++;
+            level ^= 1;
+        }
+    }
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    errors += check_duration("played", end - start);
+
+    // Each run starts with an edge, the last one is still high
+    if (num_edges != NUM_RUNS || read_in(gpio) != 1) {
+        printf("play: %d edges instead of %d\n", num_edges, NUM_RUNS);
+        return errors + 1;
+    }
+    for (uint32_t r = 0; r + 1 < NUM_RUNS; r++) {
+        uint32_t samples = (edges[r + 1] - edges[r] + SAMPLE_PERIOD / 2) / SAMPLE_PERIOD;
+        if (samples != runs[r]) {
+            printf("play: run %d of %d samples instead of %d\n", r, samples, runs[r]);
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Capture the input while the output toggles every CAPTURE_HOLD sample
+// periods, the runs captured may be one sample longer or shorter as the
+// toggles are not aligned with the ticks.
+static uint32_t test_capture(const gpio_t *gpio)
+{
+    uint32_t level = 0;
+    uint32_t start, end, next, now;
+    uint32_t num_edges = 0;
+    uint32_t last_edge = 0;
+    uint32_t errors = 0;
+
+    write_out(gpio, 0);
+    stream_done = false;
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    if (gpio_stream_capture(gpio, capture, NUM_SAMPLES, stream_callback, NULL) == DMA_ASYNC_INVALID_JOB) {
+        printf("gpio_stream_capture failed\n");
+        return 1;
+    }
+    next = start + CAPTURE_HOLD * SAMPLE_PERIOD;
+    while (!stream_done) {
+        CSR_READ(CSR_REG_MCYCLE, &now);
+        if ((int32_t)(now - next) >= 0) {
+            level ^= 1;
+            write_out(gpio, level);
+            next += CAPTURE_HOLD * SAMPLE_PERIOD;
+        }
+    }
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    errors += check_duration("captured", end - start);
+
+    level = 0;
+    for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+        if (((capture[i] >> GPIO_TB_IN) & 1) == level) {
+            continue;
+        }
+        if (num_edges != 0 && (i - last_edge < CAPTURE_HOLD - 1 || i - last_edge > CAPTURE_HOLD + 1)) {
+            printf("capture: run of %d samples at %d instead of %d\n", i - last_edge, last_edge, CAPTURE_HOLD);
+            errors++;
+        }
+        num_edges++;
+        last_edge = i;
+        level ^= 1;
+    }
+    // The first edge at most CAPTURE_HOLD + 1 samples after the start
+    if (num_edges < NUM_SAMPLES / CAPTURE_HOLD - 1) {
+        printf("capture: %d edges only\n", num_edges);
+        errors++;
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    uint32_t core_clk = soc_ctrl_get_frequency(&soc_ctrl);
+
+    pad_control_t pad_control;
+    pad_control.base_addr = mmio_region_from_addr((uintptr_t)PAD_CONTROL_START_ADDRESS);
+#if GPIO_TB_OUT == 31 || GPIO_TB_IN == 31
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SCL_REG_OFFSET), 1);
+#endif
+#if GPIO_TB_OUT == 30|| GPIO_TB_IN == 30
+    pad_control_set_mux(&pad_control, (ptrdiff_t)(PAD_CONTROL_PAD_MUX_I2C_SDA_REG_OFFSET), 1);
+#endif
+
+    gpio_t gpio;
+    gpio_init((gpio_params_t){.base_addr = mmio_region_from_addr((uintptr_t)GPIO_START_ADDRESS)}, &gpio);
+    gpio_output_set_enabled(&gpio, GPIO_TB_OUT, true);
+    gpio_input_enabled(&gpio, GPIO_TB_IN, true);
+
+    dma_t dma;
+    dma.base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS);
+    dma_async_init(&dma);
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    if (!gpio_stream_clock_start(core_clk, core_clk / SAMPLE_PERIOD)) {
+        printf("gpio_stream_clock_start failed\n");
+        return EXIT_FAILURE;
+    }
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    uint32_t errors = test_play(&gpio);
+    errors += test_capture(&gpio);
+    gpio_stream_clock_stop();
+
+    if (errors == 0) {
+        printf("success\n");
+    } else {
+        printf("failure, %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Register reads from several I2C targets queued at once and run from the
+// I2C interrupts. Each transaction reports its own status, a missing target
+// NAKs its address without stopping the others.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+#include "i2c.h"
+#include "i2c_async.h"
+
+// 7-bit addresses and first register of the targets polled
+#define NUM_TARGETS 3
+#define READ_BYTES 6
+
+static const uint8_t target_addr[NUM_TARGETS] = {0x68, 0x1E, 0x77};
+static const uint8_t target_reg[NUM_TARGETS] = {0x3B, 0x03, 0xF7};
+
+static const char *status_names[] = {"pending", "ok", "nak", "timeout", "bus error"};
+
+static i2c_async_t i2c_queue;
+static i2c_transaction_t reads[NUM_TARGETS];
+static uint8_t data[NUM_TARGETS][READ_BYTES];
+static volatile uint32_t reads_done;
+
+static void read_done(i2c_transaction_t *transaction)
+{
+    reads_done++;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    uint32_t core_clk = soc_ctrl_get_frequency(&soc_ctrl);
+
+    i2c_t i2c;
+    i2c_init((i2c_params_t){.base_addr = mmio_region_from_addr((uintptr_t)I2C_START_ADDRESS)}, &i2c);
+
+    // 400 kHz
+    i2c_config_t config;
+    i2c_compute_timing((i2c_timing_config_t){
+        .lowest_target_device_speed = kDifI2cSpeedFast,
+        .clock_period_nanos         = 1000000000 / core_clk,
+        .sda_rise_nanos             = 300,
+        .sda_fall_nanos             = 300,
+        .scl_period_nanos           = 2500
+    }, &config);
+    i2c_configure(&i2c, config);
+    i2c_host_set_enabled(&i2c, kDifI2cToggleEnabled);
+
+    // A target may stretch the clock for up to 1 ms
+    i2c_async_init(&i2c_queue, &i2c, core_clk / 1000);
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    reads_done = 0;
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        reads[i].cb = read_done;
+        if (!i2c_async_reg_read(&i2c_queue, &reads[i], target_addr[i], target_reg[i],
+                                data[i], READ_BYTES)) {
+            printf("i2c_async_reg_read failed\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The CPU is free until the last read is done
+    i2c_async_wait(&i2c_queue, &reads[NUM_TARGETS - 1]);
+    printf("%u reads done\n", reads_done);
+
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        printf("0x%02x: %s", target_addr[i], status_names[reads[i].status]);
+        if (reads[i].status == kI2cAsyncOk) {
+            for (int j = 0; j < READ_BYTES; j++) {
+                printf(" %02x", data[i][j]);
+            }
+        }
+        printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
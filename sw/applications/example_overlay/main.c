@@ -0,0 +1,78 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Two code overlays sharing the same RAM window, loaded from the FLASH on
+// demand. Build it with LINKER=flash_load to load them, with the other linker
+// scripts they are resident. The overlays are disabled by default: set
+// linker_script.flash_load_ls.overlays to 2 or more in mcu_cfg.hjson.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "core_v_mini_mcu.h"
+#include "overlay.h"
+
+#if FLASH_LOAD_OVERLAYS < 2
+  #error ( "This app needs 2 code overlays, set linker_script.flash_load_ls.overlays in mcu_cfg.hjson" )
+#endif
+
+#define NUM_SAMPLES 64
+#define NUM_ROUNDS 4
+
+static int32_t samples[NUM_SAMPLES];
+
+// overlay 0: moving average over 4 samples
+__overlay(0) int32_t smooth(int32_t *data, uint32_t len)
+{
+    int32_t sum = 0;
+    for (uint32_t i = 3; i < len; i++) {
+        data[i - 3] = (data[i - 3] + data[i - 2] + data[i - 1] + data[i]) / 4;
+        sum += data[i - 3];
+    }
+    return sum;
+}
+
+// overlay 1: peak value
+__overlay(1) int32_t peak(const int32_t *data, uint32_t len)
+{
+    int32_t max = data[0];
+    for (uint32_t i = 1; i < len; i++) {
+        if (data[i] > max) {
+            max = data[i];
+        }
+    }
+    return max;
+}
+
+int main(int argc, char *argv[])
+{
+    overlay_stats_t stats;
+    int32_t sum = 0, max = 0;
+
+    for (uint32_t i = 0; i < NUM_SAMPLES; i++) {
+        samples[i] = (i * 37) % 101;
+    }
+
+    overlay_clear_stats();
+    for (uint32_t r = 0; r < NUM_ROUNDS; r++) {
+        sum = OVERLAY_CALL(0, smooth, samples, NUM_SAMPLES);
+        max = OVERLAY_CALL(1, peak, samples, NUM_SAMPLES);
+        // no load, overlay 1 is still in the window
+        max = OVERLAY_CALL(1, peak, samples, NUM_SAMPLES - 1);
+    }
+    printf("sum %d, peak %d\n", sum, max);
+
+    for (uint32_t id = 0; id < 2; id++) {
+        overlay_get_stats(id, &stats);
+        printf("overlay %d: %d bytes, %d requests, %d loads, %d cycles\n", id,
+               overlay_get_size(id), stats.requests, stats.loads, stats.cycles);
+    }
+
+    if (overlay_get_loaded() != 1) {
+        printf("overlay 1 should be loaded\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Writes through the posted write buffers (posted_writes in mcu_cfg.hjson) and
+// through the AXI external slave port (ext_slaves protocol axi), each followed
+// by reads which must see them:
+// - the rv_timer compare registers on the peripheral path,
+// - the slow memory example of the testbench on the external slave path,
+//   streamed so that the AXI bridge sends bursts.
+// The cycles of the write streams are printed to compare the configurations.
+// The external slave part needs the testbench external device example
+// (FUSESOC_FLAGS="--flag=use_external_device_example").
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "rv_timer_regs.h"
+
+#ifndef RV_TIMER_IS_INCLUDED
+  #error ( "This app does NOT work as the RV_TIMER peripheral is not included" )
+#endif
+
+#ifdef TARGET_PYNQ_Z2
+  #error ( "This app does NOT work on the FPGA as it relies on the simulator testbench" )
+#endif
+
+#define TIMER_WRITES 16
+// 512 bytes of slow memory in the testbench
+#define EXT_WORDS 128
+
+static inline uint32_t pattern(uint32_t i)
+{
+    return 0x5A000000 ^ (i * 0x01010101) ^ (i << 20);
+}
+
+static int check(const char *what, uint32_t index, uint32_t read, uint32_t expected)
+{
+    if (read != expected) {
+        printf("%s %d: read 0x%08x instead of 0x%08x\n", what, index, read, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int test_peripheral(void)
+{
+    volatile uint32_t *lower = (volatile uint32_t *) (RV_TIMER_START_ADDRESS + RV_TIMER_COMPARE_LOWER0_0_REG_OFFSET);
+    volatile uint32_t *upper = (volatile uint32_t *) (RV_TIMER_START_ADDRESS + RV_TIMER_COMPARE_UPPER0_0_REG_OFFSET);
+    uint32_t cycles;
+    int errors = 0;
+
+    // each read right after the write to the same register
+    for (uint32_t i = 0; i < TIMER_WRITES; i++) {
+        *lower = pattern(i);
+        errors += check("timer write-read", i, *lower, pattern(i));
+    }
+
+    // a stream of writes, the read of the other register waits for all of them
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    for (uint32_t i = 0; i < TIMER_WRITES; i++) {
+        *lower = pattern(i);
+        *upper = ~pattern(i);
+    }
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    errors += check("timer upper", TIMER_WRITES - 1, *upper, ~pattern(TIMER_WRITES - 1));
+    errors += check("timer lower", TIMER_WRITES - 1, *lower, pattern(TIMER_WRITES - 1));
+    printf("peripheral: %d writes in %d cycles\n", 2 * TIMER_WRITES, cycles);
+
+    // do not leave a compare value which could fire
+    *lower = 0xFFFFFFFF;
+    *upper = 0xFFFFFFFF;
+
+    return errors;
+}
+
+int test_ext_slave(void)
+{
+    volatile uint32_t *mem = (volatile uint32_t *) EXT_SLAVE_START_ADDRESS;
+    volatile uint8_t *mem8 = (volatile uint8_t *) EXT_SLAVE_START_ADDRESS;
+    uint32_t cycles;
+    int errors = 0;
+
+    // consecutive words, sent as bursts by the AXI bridge
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    for (uint32_t i = 0; i < EXT_WORDS; i++) {
+        mem[i] = pattern(i);
+    }
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+    // the first read waits for the last buffered writes
+    errors += check("ext stream", EXT_WORDS - 1, mem[EXT_WORDS - 1], pattern(EXT_WORDS - 1));
+    for (uint32_t i = 0; i < EXT_WORDS; i++) {
+        errors += check("ext stream", i, mem[i], pattern(i));
+    }
+    printf("ext slave: %d writes in %d cycles\n", EXT_WORDS, cycles);
+
+    // byte writes merged in one word, read back at once
+    for (uint32_t i = 0; i < 8; i++) {
+        for (uint32_t b = 0; b < 4; b++) {
+            mem8[4 * i + b] = (uint8_t) (i + b);
+        }
+        errors += check("ext bytes", i, mem[i], (i + 0) | (i + 1) << 8 | (i + 2) << 16 | (i + 3) << 24);
+    }
+
+    // non consecutive addresses, written backwards then read in order
+    for (int32_t i = EXT_WORDS - 1; i >= 0; i -= 3) {
+        mem[i] = ~pattern(i);
+    }
+    for (int32_t i = EXT_WORDS - 1; i >= 0; i -= 3) {
+        errors += check("ext backwards", i, mem[i], ~pattern(i));
+    }
+
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int errors;
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    errors = test_peripheral();
+    errors += test_ext_slave();
+
+    if (errors != 0) {
+        printf("FAILURE: %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+    printf("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Interrupt driven RX buffer of the UART driver, with the UART in system
+// loopback (TX looped back to RX inside the UART):
+// - uart_read does not wait when nothing was received,
+// - a message is moved to the RX buffer by the rx_watermark and rx_timeout
+//   interrupts and the idle callback is called, then read back,
+// - with the interrupts disabled, more bytes than the RX FIFO holds are sent:
+//   the first ones are received and the overflow is counted.
+// Nothing is printed while the loopback is enabled.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "csr.h"
+#include "hart.h"
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+#include "rv_plic.h"
+#include "uart.h"
+#include "uart_regs.h"
+#include "x-heep.h"
+
+// Depth of the UART RX FIFO
+#define RX_FIFO_DEPTH 32
+#define MSG_LEN 20
+#define OVERFLOW_LEN (RX_FIFO_DEPTH + 16)
+
+static uint8_t rx_buffer[64];
+static uint8_t tx_data[OVERFLOW_LEN];
+static uint8_t rx_data[OVERFLOW_LEN];
+
+static volatile uint32_t uart_irqs;
+static volatile uint32_t idle_calls;
+
+void handler_irq_uart(void)
+{
+    uart_irqs++;
+}
+
+static void rx_idle(void *ctx)
+{
+    (void) ctx;
+    idle_calls++;
+}
+
+static void set_loopback(const uart_t *uart, bool enable)
+{
+    uint32_t ctrl = mmio_region_read32(uart->base_addr, UART_CTRL_REG_OFFSET);
+    ctrl = bitfield_bit32_write(ctrl, UART_CTRL_SLPBK_BIT, enable);
+    mmio_region_write32(uart->base_addr, UART_CTRL_REG_OFFSET, ctrl);
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    uart_t uart;
+    uart.base_addr   = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    uart.baudrate    = UART_BAUDRATE;
+    uart.clk_freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
+
+    size_t empty_read, msg_read, msg_irqs, msg_idle, msg_overflows;
+    size_t overflow_read, overflows;
+    int errors = 0;
+
+    for (uint32_t i = 0; i < OVERFLOW_LEN; i++) {
+        tx_data[i] = (uint8_t) (0xA0 + i);
+    }
+
+    if (plic_Init() != kPlicOk) {
+        printf("Init PLIC failed\n");
+        return EXIT_FAILURE;
+    }
+    // 40 bit times: the line is idle after 4 characters without a new byte
+    if (uart_rx_buffer_init(&uart, rx_buffer, sizeof(rx_buffer), 40) != kErrorOk) {
+        printf("Init RX buffer failed\n");
+        return EXIT_FAILURE;
+    }
+    uart_rx_set_idle_callback(rx_idle, NULL);
+    // Wait for the output of printf to be sent before looping TX back to RX
+    uart_flush(&uart);
+    set_loopback(&uart, true);
+
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    // Nothing received yet
+    empty_read = uart_read(&uart, rx_data, sizeof(rx_data));
+
+    // A message, received by the interrupts until the line is idle
+    uart_write(&uart, tx_data, MSG_LEN);
+    while (idle_calls == 0) {
+        wait_for_interrupt();
+    }
+    msg_irqs = uart_irqs;
+    msg_idle = idle_calls;
+    msg_read = uart_read(&uart, rx_data, sizeof(rx_data));
+    msg_overflows = uart_rx_overflows();
+    for (uint32_t i = 0; i < msg_read && i < MSG_LEN; i++) {
+        errors += rx_data[i] != tx_data[i];
+    }
+
+    // More than the RX FIFO holds, nobody empties it until the interrupts are enabled again
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, 0x8);
+    uart_write(&uart, tx_data, OVERFLOW_LEN);
+    uart_flush(&uart);
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+    while (uart_rx_overflows() == msg_overflows) {
+        wait_for_interrupt();
+    }
+    overflows = uart_rx_overflows() - msg_overflows;
+    overflow_read = uart_read(&uart, rx_data, sizeof(rx_data));
+    // the bytes sent once the RX FIFO was full are lost
+    for (uint32_t i = 0; i < overflow_read && i < RX_FIFO_DEPTH; i++) {
+        errors += rx_data[i] != tx_data[i];
+    }
+
+    set_loopback(&uart, false);
+
+    printf("empty read: %d bytes\n", empty_read);
+    printf("message: %d bytes read, %d interrupts, %d idle callbacks\n", msg_read, msg_irqs, msg_idle);
+    printf("overflow: %d bytes read, %d overflows\n", overflow_read, overflows);
+
+    if (empty_read != 0 || msg_read != MSG_LEN || msg_irqs == 0 || msg_overflows != 0 ||
+        overflow_read != RX_FIFO_DEPTH || overflows == 0 || errors != 0) {
+        printf("FAILURE: %d wrong bytes\n", errors);
+        return EXIT_FAILURE;
+    }
+    printf("SUCCESS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Cycles taken by printf with the UART written by the CPU, then with the
+// interrupt driven TX buffer of the UART driver.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+#include "rv_plic.h"
+#include "uart.h"
+#include "x-heep.h"
+
+#define NUM_LINES 4
+
+static uint8_t tx_buffer[512];
+
+static uint32_t timed_printf(uint32_t line)
+{
+    uint32_t start, end;
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    printf("line %d of the log, 32 bytes\n", line);
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    return end - start;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    uart_t uart;
+    uart.base_addr   = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    uart.baudrate    = UART_BAUDRATE;
+    uart.clk_freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
+
+    uint32_t cycles[NUM_LINES];
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    for (uint32_t i = 0; i < NUM_LINES; i++) {
+        cycles[i] = timed_printf(i);
+    }
+    for (uint32_t i = 0; i < NUM_LINES; i++) {
+        printf("unbuffered printf %d: %d cycles\n", i, cycles[i]);
+    }
+
+    if (plic_Init() != kPlicOk) {
+        printf("Init PLIC failed\n");
+        return EXIT_FAILURE;
+    }
+    if (uart_tx_buffer_init(&uart, tx_buffer, sizeof(tx_buffer), kUartTxOverflowBlock) != kErrorOk) {
+        printf("Init TX buffer failed\n");
+        return EXIT_FAILURE;
+    }
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    for (uint32_t i = 0; i < NUM_LINES; i++) {
+        cycles[i] = timed_printf(i);
+    }
+    for (uint32_t i = 0; i < NUM_LINES; i++) {
+        printf("buffered printf %d: %d cycles\n", i, cycles[i]);
+    }
+
+    // Wait for the whole log to be sent
+    uart_flush(&uart);
+    if (uart_tx_dropped() != 0) {
+        printf("failure, %d bytes dropped\n", uart_tx_dropped());
+        return EXIT_FAILURE;
+    }
+    printf("success\n");
+    return EXIT_SUCCESS;
+}
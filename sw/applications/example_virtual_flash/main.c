@@ -17,7 +17,9 @@
 #include "gpio.h"
 #include "fast_intr_ctrl_regs.h"
 
-#define REVERT_24b_ADDR(addr) ((((uint32_t)addr & 0xff0000) >> 16) | ((uint32_t)addr & 0xff00) | (((uint32_t)addr & 0xff) << 16))
+// The virtual flash of linux_femu is the SPI to AXI bridge of the FPGA, not a SPI NOR flash:
+// it takes 32-bit addresses, and its own commands (0x11 sets the dummy cycles, 0x02 writes),
+// so it is programmed directly with the SPI host instead of the spi_flash driver.
 #define FLASH_ADDR 0x00000000
 #define FLASH_SIZE 64 * 1024 * 1024
 #define FLASH_CLK_MAX_HZ (133 * 1000 * 1000)
@@ -0,0 +1,121 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Cycles per word read from the memory mapped flash with each read command of
+// the YosysHQ spimemio (standard, dual, quad, quad DDR), with and without the
+// prefetch of the next sequential word, for sequential and strided reads.
+// The data read in each configuration is checked against the data read with
+// standard reads without prefetch. The flash cache, if any, is disabled during
+// the measures, and the spimemio configuration is restored at the end.
+// The quad modes need the quad enable bit of the flash set (e.g. by the boot
+// ROM generated with BOOT_FLASH_QUAD=1), and DUMMY_CYCLES set for the flash.
+// Run it from RAM (LINKER=on_chip or flash_load), otherwise the instruction
+// fetches share the flash with the measured reads.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "mmio.h"
+#include "soc_ctrl.h"
+#include "spi_memio.h"
+
+#define NUM_WORDS 256
+// bytes between two strided reads
+#define STRIDE 64
+// dummy cycles after the mode byte: 8 for the simulation flash model, 4 for the W25Q128JV
+#define DUMMY_CYCLES SPI_MEMIO_DEFAULT_DUMMY_CYCLES
+
+static const char *mode_names[] = {
+    "standard", "dual", "quad", "quad DDR"
+};
+
+uint32_t __attribute__ ((noinline)) read_words(uint32_t offset, uint32_t stride, uint32_t *sum_out)
+{
+    volatile uint32_t *flash = (volatile uint32_t *) (FLASH_MEM_START_ADDRESS + offset);
+    uint32_t sum = 0;
+    uint32_t cycles;
+
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    for (uint32_t i = 0; i < NUM_WORDS; i++) {
+        sum += flash[i * stride / 4];
+    }
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+
+    *sum_out = sum;
+    return cycles;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    spi_memio_t spi_memio;
+    spi_memio.base_addr = mmio_region_from_addr((uintptr_t)SPI_MEMIO_START_ADDRESS);
+
+    printf("--- FLASH READ BENCHMARK ---\n");
+    printf("%d words, cycles per word\n", NUM_WORDS);
+    printf("mode: sequential, sequential+prefetch, stride %d, stride %d+prefetch\n", STRIDE, STRIDE);
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    soc_ctrl_select_spi_memio(&soc_ctrl);
+    mmio_region_write32(spi_memio.base_addr, (ptrdiff_t)(OBI_SPIMEMIO_START_SPIMEM_REG_OFFSET), 0x1);
+    uint32_t boot_cfg = mmio_region_read32(spi_memio.base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET));
+    uint32_t boot_prefetch = mmio_region_read32(spi_memio.base_addr, (ptrdiff_t)(OBI_SPIMEMIO_PREFETCH_ENABLE_REG_OFFSET));
+#if FLASH_CACHE_SIZE != 0
+    spi_memio_cache_enable(&spi_memio, false);
+#endif
+
+    uint32_t cycles[kSpiMemioModeQuadDdr + 1][4];
+    uint32_t sums[4];
+    uint32_t ref_sums[2];
+    int errors = 0;
+
+    // reference data, with the reset configuration
+    spi_memio_set_mode(&spi_memio, kSpiMemioModeStandard, false, SPI_MEMIO_DEFAULT_DUMMY_CYCLES);
+    spi_memio_prefetch_enable(&spi_memio, false);
+    read_words(0, 4, &ref_sums[0]);
+    read_words(0, STRIDE, &ref_sums[1]);
+
+    for (int mode = kSpiMemioModeStandard; mode <= kSpiMemioModeQuadDdr; mode++) {
+        spi_memio_set_mode(&spi_memio, mode, false, DUMMY_CYCLES);
+        for (int prefetch = 0; prefetch < 2; prefetch++) {
+            spi_memio_prefetch_enable(&spi_memio, prefetch);
+            // the first read of each run restarts the flash transfer
+            cycles[mode][prefetch] = read_words(0, 4, &sums[prefetch]);
+            cycles[mode][2 + prefetch] = read_words(0, STRIDE, &sums[2 + prefetch]);
+        }
+        for (int run = 0; run < 4; run++) {
+            if (sums[run] != ref_sums[run / 2]) {
+                printf("%s: wrong data read (run %d)\n", mode_names[mode], run);
+                errors++;
+            }
+        }
+    }
+
+    // back to the boot configuration
+    mmio_region_write32(spi_memio.base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET), boot_cfg);
+    mmio_region_write32(spi_memio.base_addr, (ptrdiff_t)(OBI_SPIMEMIO_PREFETCH_ENABLE_REG_OFFSET), boot_prefetch);
+#if FLASH_CACHE_SIZE != 0
+    spi_memio_cache_enable(&spi_memio, true);
+#endif
+
+    for (int mode = kSpiMemioModeStandard; mode <= kSpiMemioModeQuadDdr; mode++) {
+        printf("%s: %d, %d, %d, %d\n", mode_names[mode],
+               cycles[mode][0] / NUM_WORDS, cycles[mode][1] / NUM_WORDS,
+               cycles[mode][2] / NUM_WORDS, cycles[mode][3] / NUM_WORDS);
+    }
+
+    if (errors != 0) {
+        printf("FAILURE: %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
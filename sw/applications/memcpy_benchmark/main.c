@@ -0,0 +1,149 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Cycles per byte of memcpy/memset (the word-wide versions of
+// device/lib/base/memory.c, not the libc ones), of their DMA versions (DMA
+// above DMA_MEMCPY_THRESHOLD) and of the asynchronous DMA versions, compared
+// to a byte-at-a-time loop, for several sizes and alignments.
+// Regenerate the MCU with the different CPU types (make mcu-gen CPU=...) to
+// compare them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "dma_async.h"
+#include "dma_memcpy.h"
+#include "memory.h"
+
+#ifdef HOST_BUILD
+  #error ( "memcpy and memset of memory.c are not built with HOST_BUILD, the libc ones would be measured" )
+#endif
+
+#define MAX_SIZE 4096
+
+uint8_t src_buf[MAX_SIZE + 4] __attribute__ ((aligned (4)));
+uint8_t dst_buf[MAX_SIZE + 4] __attribute__ ((aligned (4)));
+
+static const uint32_t sizes[] = { 16, 64, 256, 1024, MAX_SIZE };
+// source and destination offsets from a word boundary
+static const uint32_t offsets[][2] = { {0, 0}, {1, 1}, {0, 1} };
+
+enum {
+    BYTE_COPY,
+    MEMCPY,
+    DMA_MEMCPY,
+    DMA_MEMCPY_ASYNC,
+    MEMSET,
+    DMA_MEMSET,
+    DMA_MEMSET_ASYNC,
+    NUM_METHODS
+};
+
+static const char *method_names[NUM_METHODS] = {
+    "byte loop", "memcpy (memory.c)", "dma_memcpy", "dma_memcpy_async",
+    "memset (memory.c)", "dma_memset", "dma_memset_async"
+};
+
+void __attribute__ ((noinline)) byte_copy(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        ((volatile uint8_t *) dst)[i] = src[i];
+    }
+}
+
+uint32_t run(int method, uint8_t *dst, uint8_t *src, uint32_t len)
+{
+    uint32_t cycles;
+
+    CSR_WRITE(CSR_REG_MCYCLE, 0);
+    switch (method) {
+        case BYTE_COPY:
+            byte_copy(dst, src, len);
+            break;
+        case MEMCPY:
+            memcpy(dst, src, len);
+            break;
+        case DMA_MEMCPY:
+            dma_memcpy(dst, src, len);
+            break;
+        case DMA_MEMCPY_ASYNC:
+            dma_wait(dma_memcpy_async(dst, src, len, NULL, NULL));
+            break;
+        case MEMSET:
+            memset(dst, 0x5a, len);
+            break;
+        case DMA_MEMSET:
+            dma_memset(dst, 0x5a, len);
+            break;
+        case DMA_MEMSET_ASYNC:
+            dma_wait(dma_memset_async(dst, 0x5a, len, NULL, NULL));
+            break;
+    }
+    CSR_READ(CSR_REG_MCYCLE, &cycles);
+
+    return cycles;
+}
+
+uint32_t check(int method, uint8_t *dst, uint8_t *src, uint32_t len)
+{
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t expected = (method >= MEMSET) ? 0x5a : src[i];
+        if (dst[i] != expected) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t errors = 0;
+
+    for (int i = 0; i < MAX_SIZE + 4; i++) {
+        src_buf[i] = i * 7 + 1;
+    }
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    dma_t dma;
+    dma.base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS);
+    dma_async_init(&dma);
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    printf("DMA threshold: %d bytes\n", DMA_MEMCPY_THRESHOLD);
+    printf("method, size, src offset, dst offset, cycles, cycles/byte x100\n");
+
+    for (int m = 0; m < NUM_METHODS; m++) {
+        for (int s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++) {
+            for (int o = 0; o < sizeof(offsets)/sizeof(offsets[0]); o++) {
+                uint8_t *src = src_buf + offsets[o][0];
+                uint8_t *dst = dst_buf + offsets[o][1];
+                uint32_t len = sizes[s];
+
+                memset(dst_buf, 0, sizeof(dst_buf));
+
+                uint32_t cycles = run(m, dst, src, len);
+                errors += check(m, dst, src, len);
+
+                printf("%s, %d, %d, %d, %d, %d\n", method_names[m], len,
+                       offsets[o][0], offsets[o][1], cycles, cycles * 100 / len);
+            }
+        }
+    }
+
+    if (errors == 0) {
+        printf("memcpy benchmark success\n");
+        return EXIT_SUCCESS;
+    } else {
+        printf("memcpy benchmark failure: %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Throughput of the spi_flash driver: reads with each read command, the data
+// moved by the CPU or by the DMA, then sector erase and page program on the
+// FPGA (the flash model of the simulation is read only).
+// Run it from RAM (LINKER=on_chip or flash_load), on the FPGA the flash pads
+// are taken from the memory mapped flash.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "csr.h"
+#include "core_v_mini_mcu.h"
+#include "soc_ctrl.h"
+#include "spi_flash.h"
+
+#ifdef TARGET_PYNQ_Z2
+    #define USE_SPI_FLASH
+#endif
+
+#define FLASH_CLK_MAX_HZ (133*1000*1000) // In Hz (133 MHz for the flash w25q128jvsim used in the EPFL Programmer)
+
+#define NUM_BYTES 4096
+// sector erased and programmed, far from the firmware
+#define WRITE_FLASH_ADDR 0x00100000
+
+static const char *mode_names[] = {
+    "standard", "fast", "dual", "quad"
+};
+
+static uint32_t ref_data[NUM_BYTES / 4];
+static uint32_t read_data[NUM_BYTES / 4];
+
+static uint32_t core_clk;
+
+// KB/s from the cycles taken by NUM_BYTES
+static uint32_t kbps(uint32_t cycles)
+{
+    return (uint32_t) ((uint64_t) NUM_BYTES * core_clk / 1024 / (cycles ? cycles : 1));
+}
+
+static uint32_t timed_read(spi_flash_t *flash, uint32_t addr, void *dst, spi_flash_read_mode_t mode)
+{
+    uint32_t start, end;
+
+    CSR_READ(CSR_REG_MCYCLE, &start);
+    spi_flash_read(flash, addr, dst, NUM_BYTES, mode);
+    CSR_READ(CSR_REG_MCYCLE, &end);
+    return end - start;
+}
+
+static uint32_t check(const uint32_t *a, const uint32_t *b)
+{
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < NUM_BYTES / 4; i++) {
+        if (a[i] != b[i]) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    core_clk = soc_ctrl_get_frequency(&soc_ctrl);
+
+    spi_flash_t flash = {
+    #ifdef USE_SPI_FLASH
+        .spi.base_addr = mmio_region_from_addr((uintptr_t)SPI_FLASH_START_ADDRESS),
+    #else
+        .spi.base_addr = mmio_region_from_addr((uintptr_t)SPI_HOST_START_ADDRESS),
+    #endif
+        .csid = 0,
+        .use_dma = false,
+    };
+    spi_flash_jedec_id_t id;
+    uint32_t errors = 0;
+
+    // enable mcycle
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+
+    #ifdef USE_SPI_FLASH
+        // Select SPI host as SPI output
+        soc_ctrl_select_spi_host(&soc_ctrl);
+    #endif
+
+    if (spi_flash_init(&flash, core_clk, FLASH_CLK_MAX_HZ) != kSpiFlashOk) {
+        printf("no flash\n");
+        return EXIT_FAILURE;
+    }
+    spi_flash_read_jedec_id(&flash, &id);
+    printf("--- SPI FLASH BENCHMARK ---\n");
+    printf("flash %02x %02x %02x, %d bytes\n", id.manufacturer, id.memory_type, id.capacity, flash.size);
+    #ifdef USE_SPI_FLASH
+        spi_flash_set_quad_enable(&flash, true);
+    #endif
+
+    printf("%d bytes, cycles and KB/s, CPU then DMA\n", NUM_BYTES);
+    spi_flash_read(&flash, 0, ref_data, NUM_BYTES, kSpiFlashReadStandard);
+
+    for (int mode = kSpiFlashReadStandard; mode <= kSpiFlashReadQuad; mode++) {
+        uint32_t cpu_cycles, dma_cycles;
+
+        flash.use_dma = false;
+        cpu_cycles = timed_read(&flash, 0, read_data, mode);
+        errors += check(ref_data, read_data);
+
+        flash.use_dma = true;
+        dma_cycles = timed_read(&flash, 0, read_data, mode);
+        errors += check(ref_data, read_data);
+
+        printf("%s: %d %d, %d %d\n", mode_names[mode], cpu_cycles, kbps(cpu_cycles),
+               dma_cycles, kbps(dma_cycles));
+    }
+
+    #ifdef USE_SPI_FLASH
+        uint32_t start, end;
+
+        CSR_READ(CSR_REG_MCYCLE, &start);
+        spi_flash_erase(&flash, WRITE_FLASH_ADDR, kSpiFlashErase4K);
+        CSR_READ(CSR_REG_MCYCLE, &end);
+        printf("erase 4K: %d cycles\n", end - start);
+
+        for (uint32_t i = 0; i < NUM_BYTES / 4; i++) {
+            ref_data[i] = i * 0x01020304;
+        }
+        CSR_READ(CSR_REG_MCYCLE, &start);
+        spi_flash_write(&flash, WRITE_FLASH_ADDR, ref_data, NUM_BYTES);
+        CSR_READ(CSR_REG_MCYCLE, &end);
+        printf("program: %d %d\n", end - start, kbps(end - start));
+
+        timed_read(&flash, WRITE_FLASH_ADDR, read_data, kSpiFlashReadQuad);
+        errors += check(ref_data, read_data);
+    #endif
+
+    if (errors != 0) {
+        printf("failure, %d errors\n", errors);
+        return EXIT_FAILURE;
+    }
+    printf("success\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Flash reads queued on the SPI host and run from its interrupt: the first
+// one receives through the DMA, the second one, not word aligned, through
+// the CPU.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "hart.h"
+#include "soc_ctrl.h"
+#include "spi_host.h"
+#include "spi_async.h"
+#include "dma.h"
+#include "dma_async.h"
+
+#ifdef TARGET_PYNQ_Z2
+    #define USE_SPI_FLASH
+#endif
+
+// Number of words to copy
+#define COPY_DATA_NUM 16
+// Bytes read by the CPU, not a multiple of 4
+#define COPY_BYTES_NUM 13
+
+#define FLASH_CLK_MAX_HZ (133*1000*1000) // In Hz (133 MHz for the flash w25q128jvsim used in the EPFL Programmer)
+
+uint32_t flash_data[COPY_DATA_NUM] __attribute__ ((aligned (4))) = {0x76543210,0xfedcba98,0x579a6f90,0x657d5bee,0x758ee41f,0x01234567,0xfedbca98,0x89abcdef,0x679852fe,0xff8252bb,0x763b4521,0x6875adaa,0x09ac65bb,0x666ba334,0x44556677,0x0000ba98};
+uint32_t copy_data[COPY_DATA_NUM] __attribute__ ((aligned (4))) = { 0 };
+uint8_t copy_bytes[COPY_BYTES_NUM + 1] = { 0 };
+
+static spi_async_t spi_queue;
+static volatile uint32_t reads_done;
+
+static void read_done(void *ctx)
+{
+    reads_done++;
+}
+
+// Read command (1 Byte) followed by the address (3 Bytes, MSB first)
+static void flash_read_cmd(uint8_t cmd[4], const void *addr)
+{
+    cmd[0] = 0x03;
+    cmd[1] = (uint32_t)addr >> 16;
+    cmd[2] = (uint32_t)addr >> 8;
+    cmd[3] = (uint32_t)addr;
+}
+
+int main(int argc, char *argv[])
+{
+    spi_host_t spi_host;
+    #ifndef USE_SPI_FLASH
+        spi_host.base_addr = mmio_region_from_addr((uintptr_t)SPI_HOST_START_ADDRESS);
+    #else
+        spi_host.base_addr = mmio_region_from_addr((uintptr_t)SPI_FLASH_START_ADDRESS);
+    #endif
+
+    dma_t dma;
+    dma.base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS);
+
+    soc_ctrl_t soc_ctrl;
+    soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+    uint32_t core_clk = soc_ctrl_get_frequency(&soc_ctrl);
+
+    #ifdef USE_SPI_FLASH
+        // Select SPI host as SPI output
+        soc_ctrl_select_spi_host(&soc_ctrl);
+    #endif
+
+    // Enable SPI host device
+    spi_set_enable(&spi_host, true);
+    // Enable SPI output
+    spi_output_enable(&spi_host, true);
+
+    // Configure SPI clock
+    // SPI clk freq = 1/2 core clk freq when clk_div = 0
+    // SPI_CLK = CORE_CLK/(2 + 2 * CLK_DIV) <= CLK_MAX => CLK_DIV > (CORE_CLK/CLK_MAX - 2)/2
+    uint16_t clk_div = 0;
+    if(FLASH_CLK_MAX_HZ < core_clk/2){
+        clk_div = (core_clk/(FLASH_CLK_MAX_HZ) - 2)/2; // The value is truncated
+        if (core_clk/(2 + 2 * clk_div) > FLASH_CLK_MAX_HZ) clk_div += 1; // Adjust if the truncation was not 0
+    }
+    // Configure chip 0 (flash memory)
+    const uint32_t chip_cfg = spi_create_configopts((spi_configopts_t){
+        .clkdiv     = clk_div,
+        .csnidle    = 0xF,
+        .csntrail   = 0xF,
+        .csnlead    = 0xF,
+        .fullcyc    = false,
+        .cpha       = 0,
+        .cpol       = 0
+    });
+    spi_set_configopts(&spi_host, 0, chip_cfg);
+
+    dma_async_init(&dma);
+    if (!spi_async_init(&spi_queue, &spi_host, true)) {
+        printf("spi_async_init failed\n");
+        return EXIT_FAILURE;
+    }
+    // Enable global interrupt for machine-level interrupts
+    CSR_SET_BITS(CSR_REG_MSTATUS, 0x8);
+
+    // Reset and power up the flash
+    static const uint8_t reset_cmd[4] = {0xff, 0xff, 0xff, 0xff};
+    static const uint8_t powerup_cmd[1] = {0xab};
+    const spi_segment_t reset_seg[] = {
+        {.dir = kSpiDirTxOnly, .speed = kSpiSpeedStandard, .len = sizeof(reset_cmd), .tx = reset_cmd},
+    };
+    const spi_segment_t powerup_seg[] = {
+        {.dir = kSpiDirTxOnly, .speed = kSpiSpeedStandard, .len = sizeof(powerup_cmd), .tx = powerup_cmd},
+    };
+    spi_async_submit(&spi_queue, &(spi_transaction_t){.segments = reset_seg, .num_segments = 1});
+    spi_async_submit(&spi_queue, &(spi_transaction_t){.segments = powerup_seg, .num_segments = 1});
+
+    // Both reads are queued at once, the CPU is free while they run
+    uint8_t read_cmd[4], read_bytes_cmd[4];
+    flash_read_cmd(read_cmd, flash_data);
+    flash_read_cmd(read_bytes_cmd, flash_data);
+    const spi_segment_t read_seg[] = {
+        {.dir = kSpiDirTxOnly, .speed = kSpiSpeedStandard, .len = sizeof(read_cmd), .tx = read_cmd},
+        {.dir = kSpiDirRxOnly, .speed = kSpiSpeedStandard, .len = sizeof(copy_data), .rx = copy_data},
+    };
+    const spi_segment_t read_bytes_seg[] = {
+        {.dir = kSpiDirTxOnly, .speed = kSpiSpeedStandard, .len = sizeof(read_bytes_cmd), .tx = read_bytes_cmd},
+        {.dir = kSpiDirRxOnly, .speed = kSpiSpeedStandard, .len = COPY_BYTES_NUM, .rx = &copy_bytes[1]},
+    };
+
+    reads_done = 0;
+    spi_async_id_t id = spi_async_submit(&spi_queue, &(spi_transaction_t){
+        .segments = read_seg, .num_segments = 2, .csid = 0, .cb = read_done});
+    spi_async_id_t id_bytes = spi_async_submit(&spi_queue, &(spi_transaction_t){
+        .segments = read_bytes_seg, .num_segments = 2, .csid = 0, .cb = read_done});
+    if (id == SPI_ASYNC_INVALID_ID || id_bytes == SPI_ASYNC_INVALID_ID) {
+        printf("spi_async_submit failed\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Waiting for the reads...\n");
+    spi_async_wait(&spi_queue, id_bytes);
+    printf("done, %u reads!\n", reads_done);
+
+    // Power down flash
+    static const uint8_t powerdown_cmd[1] = {0xb9};
+    const spi_segment_t powerdown_seg[] = {
+        {.dir = kSpiDirTxOnly, .speed = kSpiSpeedStandard, .len = sizeof(powerdown_cmd), .tx = powerdown_cmd},
+    };
+    spi_async_wait(&spi_queue, spi_async_submit(&spi_queue,
+                   &(spi_transaction_t){.segments = powerdown_seg, .num_segments = 1}));
+
+    // The data is already in memory -- Check results
+    printf("flash vs ram...\n");
+
+    uint32_t errors = 0;
+    for (int i = 0; i<COPY_DATA_NUM; i++) {
+        if(flash_data[i] != copy_data[i]) {
+            printf("@%08x-@%08x : %08x != %08x\n" , &flash_data[i] , &copy_data[i], flash_data[i], copy_data[i]);
+            errors++;
+        }
+    }
+    const uint8_t *flash_bytes = (const uint8_t *)flash_data;
+    for (int i = 0; i<COPY_BYTES_NUM; i++) {
+        if(flash_bytes[i] != copy_bytes[i + 1]) {
+            printf("byte %d : %02x != %02x\n" , i, flash_bytes[i], copy_bytes[i + 1]);
+            errors++;
+        }
+    }
+
+    if (errors == 0) {
+        printf("success! (bytes checked: %d)\n", sizeof(copy_data) + COPY_BYTES_NUM);
+    } else {
+        printf("failure, %d errors!\n", errors);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
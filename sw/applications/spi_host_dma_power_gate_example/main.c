@@ -12,6 +12,7 @@
 #include "handler.h"
 #include "soc_ctrl.h"
 #include "spi_host.h"
+#include "spi_flash.h"
 #include "dma.h"
 #include "fast_intr_ctrl.h"
 #include "power_manager.h"
@@ -20,7 +21,7 @@
     #define USE_SPI_FLASH
 #endif
 
-// Type of data frome the SPI. For types different than words the SPI data is requested in separate transactions
+// Type of data frome the SPI. For types different than words the SPI data is requested in separate reads
 // word(0), half-word(1), byte(2,3)
 #define SPI_DATA_TYPE 0
 
@@ -29,11 +30,9 @@
 
 #define FLASH_CLK_MAX_HZ (133*1000*1000) // In Hz (133 MHz for the flash w25q128jvsim used in the EPFL Programmer)
 
-#define REVERT_24b_ADDR(addr) ((((uint32_t)(addr) & 0xff0000) >> 16) | ((uint32_t)(addr) & 0xff00) | (((uint32_t)(addr) & 0xff) << 16))
-
 int8_t dma_intr_flag;
 int8_t core_sleep_flag;
-spi_host_t spi_host;
+spi_flash_t flash;
 
 static power_manager_t power_manager;
 
@@ -57,10 +56,13 @@ void fic_irq_dma(void)
 int main(int argc, char *argv[])
 {
     #ifndef USE_SPI_FLASH
-        spi_host.base_addr = mmio_region_from_addr((uintptr_t)SPI_HOST_START_ADDRESS);
+        flash.spi.base_addr = mmio_region_from_addr((uintptr_t)SPI_HOST_START_ADDRESS);
     #else
-        spi_host.base_addr = mmio_region_from_addr((uintptr_t)SPI_FLASH_START_ADDRESS);
+        flash.spi.base_addr = mmio_region_from_addr((uintptr_t)SPI_FLASH_START_ADDRESS);
     #endif
+    flash.csid = 0;
+    // the DMA is programmed below to run while the core is power gated
+    flash.use_dma = false;
 
     // dma peripheral structure to access the registers
     dma_t dma;
@@ -93,13 +95,14 @@ int main(int argc, char *argv[])
         soc_ctrl_select_spi_host(&soc_ctrl);
     #endif
 
-    // Enable SPI host device
-    spi_set_enable(&spi_host, true);
-    // Enable SPI output
-    spi_output_enable(&spi_host, true);
+    // SPI clock, reset and power up of the flash
+    if (spi_flash_init(&flash, core_clk, FLASH_CLK_MAX_HZ) != kSpiFlashOk) {
+        printf("no flash\n");
+        return EXIT_FAILURE;
+    }
 
     // SPI and SPI_FLASH are the same IP so same register map
-    uint32_t *fifo_ptr_rx = spi_host.base_addr.base + SPI_HOST_RXDATA_REG_OFFSET;
+    uint32_t *fifo_ptr_rx = flash.spi.base_addr.base + SPI_HOST_RXDATA_REG_OFFSET;
 
     core_sleep_flag = 0;
 
@@ -127,94 +130,16 @@ int main(int argc, char *argv[])
     #endif
     dma_set_data_type(&dma, (uint32_t) SPI_DATA_TYPE);
 
-    // Configure SPI clock
-    // SPI clk freq = 1/2 core clk freq when clk_div = 0
-    // SPI_CLK = CORE_CLK/(2 + 2 * CLK_DIV) <= CLK_MAX => CLK_DIV > (CORE_CLK/CLK_MAX - 2)/2
-    uint16_t clk_div = 0;
-    if(FLASH_CLK_MAX_HZ < core_clk/2){
-        clk_div = (core_clk/(FLASH_CLK_MAX_HZ) - 2)/2; // The value is truncated
-        if (core_clk/(2 + 2 * clk_div) > FLASH_CLK_MAX_HZ) clk_div += 1; // Adjust if the truncation was not 0
-    }
-    // SPI Configuration
-    // Configure chip 0 (flash memory)
-    const uint32_t chip_cfg = spi_create_configopts((spi_configopts_t){
-        .clkdiv     = clk_div,
-        .csnidle    = 0xF,
-        .csntrail   = 0xF,
-        .csnlead    = 0xF,
-        .fullcyc    = false,
-        .cpha       = 0,
-        .cpol       = 0
-    });
-    spi_set_configopts(&spi_host, 0, chip_cfg);
-    spi_set_csid(&spi_host, 0);
-
-    // Reset
-    const uint32_t reset_cmd = 0xFFFFFFFF;
-    spi_write_word(&spi_host, reset_cmd);
-    const uint32_t cmd_reset = spi_create_command((spi_command_t){
-        .len        = 3,
-        .csaat      = false,
-        .speed      = kSpiSpeedStandard,
-        .direction  = kSpiDirTxOnly
-    });
-    spi_set_command(&spi_host, cmd_reset);
-    spi_wait_for_ready(&spi_host);
-
-    // Power up flash
-    const uint32_t powerup_byte_cmd = 0xab;
-    spi_write_word(&spi_host, powerup_byte_cmd);
-    const uint32_t cmd_powerup = spi_create_command((spi_command_t){
-        .len        = 0,
-        .csaat      = false,
-        .speed      = kSpiSpeedStandard,
-        .direction  = kSpiDirTxOnly
-    });
-    spi_set_command(&spi_host, cmd_powerup);
-    spi_wait_for_ready(&spi_host);
-
-    // Load command FIFO with read command (1 Byte at single speed)
-    const uint32_t cmd_read = spi_create_command((spi_command_t){
-        .len        = 3,
-        .csaat      = true,
-        .speed      = kSpiSpeedStandard,
-        .direction  = kSpiDirTxOnly
-    });
-
-    uint32_t read_byte_cmd;
-    read_byte_cmd = ((REVERT_24b_ADDR(flash_data) << 8) | 0x03); // The address bytes sent through the SPI to the Flash are in reverse order
-
     dma_intr_flag = 0;
     dma_set_cnt_start(&dma, (uint32_t) (COPY_DATA_NUM*sizeof(*copy_data)));
 
+    // flash_data has the same offset in the flash as in RAM
     #if SPI_DATA_TYPE == 0
-        const uint32_t cmd_read_rx = spi_create_command((spi_command_t){ // Single transaction
-            .len        = COPY_DATA_NUM*sizeof(*copy_data) - 1, // In bytes - 1
-            .csaat      = false,
-            .speed      = kSpiSpeedStandard,
-            .direction  = kSpiDirRxOnly
-        });
-        spi_write_word(&spi_host, read_byte_cmd); // Fill TX FIFO with TX data (read command + 3B address)
-        spi_wait_for_ready(&spi_host); // Wait for readiness to process commands
-        spi_set_command(&spi_host, cmd_read); // Send read command to the external device through SPI
-        spi_wait_for_ready(&spi_host);
-        spi_set_command(&spi_host, cmd_read_rx); // Receive data in RX
-        spi_wait_for_ready(&spi_host);
+        spi_flash_read_start(&flash, (uint32_t) flash_data, COPY_DATA_NUM*sizeof(*copy_data), kSpiFlashReadStandard);
     #else
-        const uint32_t cmd_read_rx = spi_create_command((spi_command_t){ // Multiple transactions of the data type
-            .len        = (sizeof(*copy_data) - 1),
-            .csaat      = false,
-            .speed      = kSpiSpeedStandard,
-            .direction  = kSpiDirRxOnly
-        });
-        for (int i = 0; i<COPY_DATA_NUM; i++) { // Multiple 16-bit transactions
-            // Request the same data multiple times
-            spi_write_word(&spi_host, read_byte_cmd); // Fill TX FIFO with TX data (read command + 3B address)
-            spi_wait_for_ready(&spi_host); // Wait for readiness to process commands
-            spi_set_command(&spi_host, cmd_read); // Send read command to the external device through SPI
-            spi_wait_for_ready(&spi_host);
-            spi_set_command(&spi_host, cmd_read_rx); // Receive data in RX
-            spi_wait_for_ready(&spi_host);
+        for (int i = 0; i<COPY_DATA_NUM; i++) {
+            // Request the same data multiple times, one element per read
+            spi_flash_read_start(&flash, (uint32_t) flash_data, sizeof(*copy_data), kSpiFlashReadStandard);
         }
     #endif
 
@@ -239,16 +164,7 @@ int main(int argc, char *argv[])
     printf("triggered!\n");
 
     // Power down flash
-    const uint32_t powerdown_byte_cmd = 0xb9;
-    spi_write_word(&spi_host, powerdown_byte_cmd);
-    const uint32_t cmd_powerdown = spi_create_command((spi_command_t){
-        .len        = 0,
-        .csaat      = false,
-        .speed      = kSpiSpeedStandard,
-        .direction  = kSpiDirTxOnly
-    });
-    spi_set_command(&spi_host, cmd_powerdown);
-    spi_wait_for_ready(&spi_host);
+    spi_flash_power_down(&flash);
 
     // The data is already in memory -- Check results
     printf("flash vs ram...\n");
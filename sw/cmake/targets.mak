@@ -37,6 +37,9 @@ build/Makefile : CMakeLists.txt ${CMAKE_DIR}/riscv.cmake
 			-DLINKER:STRING=${LINKER} \
 			-DCOMPILER:STRING=${COMPILER} \
 			-DCOMPILER_PREFIX:STRING=${COMPILER_PREFIX} \
+			-DRAM_VECTORS:STRING=${RAM_VECTORS} \
+			-DCOMPRESS:STRING=${COMPRESS} \
+			-DDMA_CLEAR_BSS:STRING=${DMA_CLEAR_BSS} \
 		    ../ 
 
 clean:
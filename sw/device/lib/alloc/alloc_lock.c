@@ -0,0 +1,29 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+
+#include "alloc_lock.h"
+
+static alloc_lock_t alloc_lock_fn = NULL;
+static alloc_unlock_t alloc_unlock_fn = NULL;
+
+void alloc_set_lock(alloc_lock_t lock, alloc_unlock_t unlock) {
+  if (lock == NULL || unlock == NULL) {
+    lock = NULL;
+    unlock = NULL;
+  }
+  alloc_lock_fn = lock;
+  alloc_unlock_fn = unlock;
+}
+
+uint32_t alloc_lock(void) {
+  return alloc_lock_fn != NULL ? alloc_lock_fn() : 0;
+}
+
+void alloc_unlock(uint32_t state) {
+  if (alloc_unlock_fn != NULL) {
+    alloc_unlock_fn(state);
+  }
+}
@@ -0,0 +1,49 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _ALLOC_LOCK_H_
+#define _ALLOC_LOCK_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enter a critical section, returns the state to give back to the unlock.
+ */
+typedef uint32_t (*alloc_lock_t)(void);
+
+/**
+ * Leave a critical section.
+ */
+typedef void (*alloc_unlock_t)(uint32_t state);
+
+/**
+ * Set the lock used by the pools and the arenas. Without lock (the default)
+ * they must not be shared between tasks or with interrupt handlers.
+ * With FreeRTOS, wrap taskENTER_CRITICAL_FROM_ISR and
+ * taskEXIT_CRITICAL_FROM_ISR, which can be used both from tasks and from
+ * interrupt handlers.
+ * @param lock Lock function, NULL to remove the lock.
+ * @param unlock Unlock function, NULL to remove the lock.
+ */
+void alloc_set_lock(alloc_lock_t lock, alloc_unlock_t unlock);
+
+/**
+ * Used by the allocators, enter the critical section if a lock is set.
+ */
+uint32_t alloc_lock(void);
+
+/**
+ * Used by the allocators, leave the critical section if a lock is set.
+ */
+void alloc_unlock(uint32_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _ALLOC_LOCK_H_
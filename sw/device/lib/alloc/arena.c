@@ -0,0 +1,59 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "arena.h"
+#include "alloc_lock.h"
+
+void arena_init(arena_t *arena, void *buffer, size_t size) {
+  arena->base = (uint8_t *)buffer;
+  arena->size = size;
+  arena->used = 0;
+  arena->peak = 0;
+}
+
+void *arena_alloc_aligned(arena_t *arena, size_t size, size_t align) {
+  void *ptr = NULL;
+  uint32_t state = alloc_lock();
+
+  uintptr_t start = (uintptr_t)arena->base + arena->used;
+  size_t pad = (align - (start & (align - 1))) & (align - 1);
+  if (size <= arena->size - arena->used &&
+      pad <= arena->size - arena->used - size) {
+    ptr = (void *)(start + pad);
+    arena->used += pad + size;
+    if (arena->used > arena->peak) {
+      arena->peak = arena->used;
+    }
+  }
+
+  alloc_unlock(state);
+  return ptr;
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+  return arena_alloc_aligned(arena, size, ARENA_ALIGN);
+}
+
+arena_mark_t arena_mark(arena_t *arena) {
+  arena_mark_t mark = {.arena = arena, .used = arena->used};
+  return mark;
+}
+
+void arena_reset_to(arena_mark_t mark) {
+  uint32_t state = alloc_lock();
+
+  if (mark.used < mark.arena->used) {
+    mark.arena->used = mark.used;
+  }
+
+  alloc_unlock(state);
+}
+
+void arena_reset(arena_t *arena) {
+  uint32_t state = alloc_lock();
+  arena->used = 0;
+  alloc_unlock(state);
+}
+
+void arena_scope_end(arena_mark_t *mark) { arena_reset_to(*mark); }
@@ -0,0 +1,139 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _ALLOC_ARENA_H_
+#define _ALLOC_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Bump allocator: allocations are taken one after the other from a buffer
+ * and are all freed at once by resetting the arena, either completely or
+ * back to a mark, e.g.
+ *   ARENA_DEFINE(frame_arena, 2048);
+ *   {
+ *     ARENA_SCOPE(&frame_arena);
+ *     int16_t *samples = arena_alloc(&frame_arena, 256 * sizeof(int16_t));
+ *     ...
+ *   } // everything allocated in the scope is freed here
+ *
+ * The arenas are protected by the lock set with alloc_set_lock.
+ */
+
+/**
+ * Default alignment of the allocations.
+ */
+#define ARENA_ALIGN 4
+
+/**
+ * Define an arena named name of num_bytes bytes, at file scope. Other files can
+ * use it with extern arena_t name.
+ */
+#define ARENA_DEFINE(name, num_bytes)                                   \
+  static uint32_t name##_storage[((num_bytes) + sizeof(uint32_t) - 1) / \
+                                 sizeof(uint32_t)];                     \
+  arena_t name = {                                                      \
+      .base = (uint8_t *)name##_storage,                                \
+      .size = sizeof(name##_storage),                                   \
+  }
+
+#define ARENA_SCOPE_NAME_(line) arena_scope_##line
+#define ARENA_SCOPE_NAME(line) ARENA_SCOPE_NAME_(line)
+
+/**
+ * Reset the arena to its current level when leaving the enclosing scope,
+ * including with return or break.
+ */
+#define ARENA_SCOPE(arena)                \
+  arena_mark_t ARENA_SCOPE_NAME(__LINE__) \
+      __attribute__((cleanup(arena_scope_end))) = arena_mark(arena)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Arena state, initialized by ARENA_DEFINE or arena_init.
+ */
+typedef struct arena {
+  /**
+   * Start of the buffer.
+   */
+  uint8_t *base;
+  /**
+   * Size of the buffer in bytes.
+   */
+  size_t size;
+  /**
+   * Bytes allocated from the start of the buffer.
+   */
+  size_t used;
+  /**
+   * Highest value of used.
+   */
+  size_t peak;
+} arena_t;
+
+/**
+ * Level of an arena, to reset it to.
+ */
+typedef struct arena_mark {
+  arena_t *arena;
+  size_t used;
+} arena_mark_t;
+
+/**
+ * Initialize an arena on a buffer allocated elsewhere.
+ * @param arena Arena to initialize.
+ * @param buffer Buffer, word aligned.
+ * @param size Size of the buffer in bytes.
+ */
+void arena_init(arena_t *arena, void *buffer, size_t size);
+
+/**
+ * Allocate memory aligned to ARENA_ALIGN.
+ * @param arena Arena to allocate from.
+ * @param size Number of bytes.
+ * @return Pointer to the memory, NULL if the arena is full.
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * Allocate memory with a given alignment.
+ * @param arena Arena to allocate from.
+ * @param size Number of bytes.
+ * @param align Alignment, a power of 2.
+ * @return Pointer to the memory, NULL if the arena is full.
+ */
+void *arena_alloc_aligned(arena_t *arena, size_t size, size_t align);
+
+/**
+ * Get the current level of an arena.
+ * @param arena Arena.
+ */
+arena_mark_t arena_mark(arena_t *arena);
+
+/**
+ * Free everything allocated after a mark.
+ * @param mark Mark returned by arena_mark.
+ */
+void arena_reset_to(arena_mark_t mark);
+
+/**
+ * Free everything allocated from an arena.
+ * @param arena Arena.
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * Used by ARENA_SCOPE.
+ */
+void arena_scope_end(arena_mark_t *mark);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _ALLOC_ARENA_H_
@@ -0,0 +1,59 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "pool.h"
+#include "alloc_lock.h"
+
+void *pool_alloc(pool_t *pool) {
+  void *obj = NULL;
+  uint32_t state = alloc_lock();
+
+  if (pool->free_list != NULL) {
+    obj = pool->free_list;
+    pool->free_list = *(void **)obj;
+  } else if (pool->fresh < pool->count) {
+    obj = pool->storage + pool->fresh * pool->obj_size;
+    pool->fresh++;
+  }
+  if (obj != NULL) {
+    pool->used++;
+    if (pool->used > pool->peak) {
+      pool->peak = pool->used;
+    }
+  }
+
+  alloc_unlock(state);
+  return obj;
+}
+
+void pool_free(pool_t *pool, void *obj) {
+  if (obj == NULL) {
+    return;
+  }
+  uint32_t state = alloc_lock();
+
+  *(void **)obj = pool->free_list;
+  pool->free_list = obj;
+  pool->used--;
+
+  alloc_unlock(state);
+}
+
+bool pool_owns(const pool_t *pool, const void *obj) {
+  const uint8_t *ptr = (const uint8_t *)obj;
+
+  return ptr >= pool->storage &&
+         ptr < pool->storage + pool->count * pool->obj_size &&
+         (ptr - pool->storage) % pool->obj_size == 0;
+}
+
+void pool_reset(pool_t *pool) {
+  uint32_t state = alloc_lock();
+
+  pool->fresh = 0;
+  pool->free_list = NULL;
+  pool->used = 0;
+
+  alloc_unlock(state);
+}
@@ -0,0 +1,112 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _ALLOC_POOL_H_
+#define _ALLOC_POOL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Pool of fixed size objects, with constant time allocation and free.
+ *
+ * The storage is reserved at compile time with POOL_DEFINE, e.g.
+ *   POOL_DEFINE(packet_pool, sizeof(packet_t), 16);
+ *   packet_t *packet = pool_alloc(&packet_pool);
+ *   ...
+ *   pool_free(&packet_pool, packet);
+ *
+ * Objects are word aligned. The pools are protected by the lock set with
+ * alloc_set_lock.
+ */
+
+/**
+ * Size of the objects rounded up to a whole number of words.
+ */
+#define POOL_OBJ_WORDS(obj_bytes) \
+  (((obj_bytes) + sizeof(uint32_t) - 1) / sizeof(uint32_t))
+
+/**
+ * Define a pool named name holding num_objs objects of obj_bytes bytes, at file
+ * scope. Other files can use it with extern pool_t name.
+ */
+#define POOL_DEFINE(name, obj_bytes, num_objs)                            \
+  static uint32_t name##_storage[POOL_OBJ_WORDS(obj_bytes) * (num_objs)]; \
+  pool_t name = {                                                         \
+      .storage = (uint8_t *)name##_storage,                               \
+      .obj_size = POOL_OBJ_WORDS(obj_bytes) * sizeof(uint32_t),           \
+      .count = (num_objs),                                                \
+  }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pool state, initialized by POOL_DEFINE.
+ */
+typedef struct pool {
+  /**
+   * Storage for count objects.
+   */
+  uint8_t *storage;
+  /**
+   * Size of one object in bytes, a multiple of the word size.
+   */
+  uint32_t obj_size;
+  /**
+   * Number of objects.
+   */
+  uint32_t count;
+  /**
+   * Objects never allocated yet, taken in order after the free list is empty.
+   */
+  uint32_t fresh;
+  /**
+   * Freed objects, linked through their first word.
+   */
+  void *free_list;
+  /**
+   * Objects currently allocated.
+   */
+  uint32_t used;
+  /**
+   * Highest number of objects allocated at the same time.
+   */
+  uint32_t peak;
+} pool_t;
+
+/**
+ * Allocate one object.
+ * @param pool Pool defined with POOL_DEFINE.
+ * @return Pointer to the object, NULL if the pool is empty.
+ */
+void *pool_alloc(pool_t *pool);
+
+/**
+ * Give an object back to its pool.
+ * @param pool Pool the object was allocated from.
+ * @param obj Object returned by pool_alloc, can be NULL.
+ */
+void pool_free(pool_t *pool, void *obj);
+
+/**
+ * Check if an object comes from a pool.
+ * @param pool Pool defined with POOL_DEFINE.
+ * @param obj Pointer to check.
+ */
+bool pool_owns(const pool_t *pool, const void *obj);
+
+/**
+ * Free all the objects at once.
+ * @param pool Pool defined with POOL_DEFINE.
+ */
+void pool_reset(pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _ALLOC_POOL_H_
@@ -4,6 +4,8 @@
 
 #include "memory.h"
 
+#include <stdbool.h>
+
 extern uint32_t read_32(const void *);
 extern void write_32(uint32_t, void *);
 
@@ -17,24 +19,121 @@ extern void write_32(uint32_t, void *);
 // This approach is used so that DIFs can depend on `memory.h`, but also be
 // built for host-side software.
 
+// The compilers would otherwise turn the loops below back into calls to memcpy
+// and memset.
+#if defined(__clang__)
+#define MEMORY_NO_BUILTIN __attribute__((no_builtin))
+#else
+#define MEMORY_NO_BUILTIN
+#pragma GCC optimize("no-tree-loop-distribute-patterns")
+#endif
+
 #if !defined(HOST_BUILD)
-void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
-  uint8_t *dest8 = (uint8_t *)dest;
-  uint8_t *src8 = (uint8_t *)src;
+static inline bool same_word_offset(const void *a, const void *b) {
+  return (((uintptr_t)a ^ (uintptr_t)b) & (sizeof(uint32_t) - 1)) == 0;
+}
+
+static inline uint32_t byte_pattern(int value) {
+  return (uint8_t)value * 0x01010101u;
+}
+
+MEMORY_NO_BUILTIN
+static void copy_words(uint8_t *dest8, const uint8_t *src8, size_t len) {
+  size_t i = 0;
+  for (; i + 4 * sizeof(uint32_t) <= len; i += 4 * sizeof(uint32_t)) {
+    uint32_t w0 = read_32(src8 + i);
+    uint32_t w1 = read_32(src8 + i + 4);
+    uint32_t w2 = read_32(src8 + i + 8);
+    uint32_t w3 = read_32(src8 + i + 12);
+    write_32(w0, dest8 + i);
+    write_32(w1, dest8 + i + 4);
+    write_32(w2, dest8 + i + 8);
+    write_32(w3, dest8 + i + 12);
+  }
+  for (; i < len; i += sizeof(uint32_t)) {
+    write_32(read_32(src8 + i), dest8 + i);
+  }
+}
+
+MEMORY_NO_BUILTIN
+static void set_words(uint8_t *dest8, uint32_t value32, size_t len) {
+  size_t i = 0;
+  for (; i + 4 * sizeof(uint32_t) <= len; i += 4 * sizeof(uint32_t)) {
+    write_32(value32, dest8 + i);
+    write_32(value32, dest8 + i + 4);
+    write_32(value32, dest8 + i + 8);
+    write_32(value32, dest8 + i + 12);
+  }
+  for (; i < len; i += sizeof(uint32_t)) {
+    write_32(value32, dest8 + i);
+  }
+}
+
+MEMORY_NO_BUILTIN
+static void copy_bytes(uint8_t *dest8, const uint8_t *src8, size_t len) {
   for (size_t i = 0; i < len; ++i) {
     dest8[i] = src8[i];
   }
+}
+
+MEMORY_NO_BUILTIN
+static void set_bytes(uint8_t *dest8, uint8_t value8, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    dest8[i] = value8;
+  }
+}
+
+// Bytes to handle one at a time before `ptr` is word-aligned.
+static inline size_t head_len(const void *ptr, size_t len) {
+  size_t head = (size_t)(-(uintptr_t)ptr & (sizeof(uint32_t) - 1));
+  return head < len ? head : len;
+}
+
+static void memcpy_words(uint8_t *dest8, const uint8_t *src8, size_t len) {
+  // Words cannot be used on both sides when the offsets differ.
+  if (len < MEMORY_WORD_THRESHOLD || !same_word_offset(dest8, src8)) {
+    copy_bytes(dest8, src8, len);
+    return;
+  }
+
+  size_t head = head_len(dest8, len);
+  copy_bytes(dest8, src8, head);
+  dest8 += head;
+  src8 += head;
+  len -= head;
+
+  size_t words = len & ~(sizeof(uint32_t) - 1);
+  copy_words(dest8, src8, words);
+  copy_bytes(dest8 + words, src8 + words, len - words);
+}
+
+static void memset_words(uint8_t *dest8, int value, size_t len) {
+  if (len < MEMORY_WORD_THRESHOLD) {
+    set_bytes(dest8, (uint8_t)value, len);
+    return;
+  }
+
+  size_t head = head_len(dest8, len);
+  set_bytes(dest8, (uint8_t)value, head);
+  dest8 += head;
+  len -= head;
+
+  size_t words = len & ~(sizeof(uint32_t) - 1);
+  set_words(dest8, byte_pattern(value), words);
+  set_bytes(dest8 + words, (uint8_t)value, len - words);
+}
+#endif  // !defined(HOST_BUILD)
+
+#if !defined(HOST_BUILD)
+void *memcpy(void *restrict dest, const void *restrict src, size_t len) {
+  memcpy_words((uint8_t *)dest, (const uint8_t *)src, len);
   return dest;
 }
 #endif  // !defined(HOST_BUILD)
 
 #if !defined(HOST_BUILD)
 void *memset(void *dest, int value, size_t len) {
-  uint8_t *dest8 = (uint8_t *)dest;
-  uint8_t value8 = (uint8_t)value;
-  for (size_t i = 0; i < len; ++i) {
-    dest8[i] = value8;
-  }
+  memset_words((uint8_t *)dest, value, len);
   return dest;
 }
 #endif  // !defined(HOST_BUILD)
@@ -49,7 +148,26 @@ enum {
 int memcmp(const void *lhs, const void *rhs, size_t len) {
   const uint8_t *lhs8 = (uint8_t *)lhs;
   const uint8_t *rhs8 = (uint8_t *)rhs;
-  for (size_t i = 0; i < len; ++i) {
+  size_t i = 0;
+
+  // Skip the identical words, the first difference is searched byte by byte.
+  if (len >= MEMORY_WORD_THRESHOLD && same_word_offset(lhs8, rhs8)) {
+    size_t head = head_len(lhs8, len);
+    for (; i < head; ++i) {
+      if (lhs8[i] != rhs8[i]) {
+        break;
+      }
+    }
+    if (i == head) {
+      for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+        if (read_32(lhs8 + i) != read_32(rhs8 + i)) {
+          break;
+        }
+      }
+    }
+  }
+
+  for (; i < len; ++i) {
     if (lhs8[i] < rhs8[i]) {
       return kMemCmpLt;
     } else if (lhs8[i] > rhs8[i]) {
@@ -21,6 +21,15 @@
 extern "C" {
 #endif  // __cplusplus
 
+/**
+ * Minimum length, in bytes, for `memcpy()`, `memset()` and `memcmp()` to work
+ * on whole words instead of bytes. Words are only used when both regions have
+ * the same offset within a word.
+ */
+#ifndef MEMORY_WORD_THRESHOLD
+#define MEMORY_WORD_THRESHOLD 16
+#endif
+
 /**
  * Computes the number of elements in the given array.
  *
@@ -0,0 +1,123 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dlog.h"
+#include "csr.h"
+
+// mstatus.MIE
+#define DLOG_MSTATUS_MIE (1 << 3)
+// Words sent to the UART per uart_write, the interrupts are enabled in between
+#define DLOG_DRAIN_WORDS 16
+// Number of arguments of a record, from its header
+#define DLOG_HEADER_NARGS(header) (((header) >> 24) & 0xF)
+
+static uint32_t *dlog_buf;
+static size_t dlog_size = 0;
+static volatile size_t dlog_head;
+static volatile size_t dlog_count;
+static volatile uint32_t dlog_dropped;
+// Words of the record being drained not sent yet, 0 between two records
+static size_t dlog_record_left;
+
+static inline uint32_t dlog_lock(void) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_CLEAR_BITS(CSR_REG_MSTATUS, DLOG_MSTATUS_MIE);
+  return mstatus;
+}
+
+static inline void dlog_unlock(uint32_t mstatus) {
+  if (mstatus & DLOG_MSTATUS_MIE) {
+    CSR_SET_BITS(CSR_REG_MSTATUS, DLOG_MSTATUS_MIE);
+  }
+}
+
+void dlog_init(uint32_t *buffer, size_t words) {
+  uint32_t mstatus = dlog_lock();
+  dlog_buf = buffer;
+  dlog_size = buffer != NULL ? words : 0;
+  dlog_head = 0;
+  dlog_count = 0;
+  dlog_dropped = 0;
+  dlog_record_left = 0;
+  dlog_unlock(mstatus);
+}
+
+void dlog_write(uint32_t id, const uint32_t *args, uint32_t nargs) {
+  uint32_t mstatus = dlog_lock();
+
+  if (dlog_size - dlog_count < nargs + 1) {
+    dlog_dropped++;
+    dlog_unlock(mstatus);
+    return;
+  }
+
+  size_t tail = dlog_head + dlog_count;
+  if (tail >= dlog_size) {
+    tail -= dlog_size;
+  }
+  dlog_count += nargs + 1;
+
+  dlog_buf[tail] = DLOG_HEADER(id, nargs);
+  for (uint32_t i = 0; i < nargs; i++) {
+    if (++tail == dlog_size) {
+      tail = 0;
+    }
+    dlog_buf[tail] = args[i];
+  }
+
+  dlog_unlock(mstatus);
+}
+
+size_t dlog_pending(void) {
+  return dlog_count;
+}
+
+size_t dlog_drain(const uart_t *uart) {
+  uint32_t chunk[DLOG_DRAIN_WORDS];
+  size_t sent = 0;
+
+  while (1) {
+    size_t n = 0;
+    uint32_t mstatus = dlog_lock();
+
+    // Records may be split between chunks, they are sent in order. The
+    // dropped record is only sent between two records, for the decoder to
+    // stay in sync.
+    while (n < DLOG_DRAIN_WORDS) {
+      if (dlog_record_left == 0) {
+        if (dlog_dropped != 0) {
+          if (DLOG_DRAIN_WORDS - n < 2) {
+            break;
+          }
+          chunk[n++] = DLOG_HEADER(DLOG_ID_DROPPED, 1);
+          chunk[n++] = dlog_dropped;
+          dlog_dropped = 0;
+          continue;
+        }
+        if (dlog_count == 0) {
+          break;
+        }
+        dlog_record_left = DLOG_HEADER_NARGS(dlog_buf[dlog_head]) + 1;
+      }
+      chunk[n++] = dlog_buf[dlog_head];
+      if (++dlog_head == dlog_size) {
+        dlog_head = 0;
+      }
+      dlog_count--;
+      dlog_record_left--;
+    }
+
+    dlog_unlock(mstatus);
+    if (n == 0) {
+      return sent;
+    }
+    // Little endian, the decoder reads the words byte per byte
+    uart_write(uart, (const uint8_t *)chunk, n * sizeof(uint32_t));
+    sent += n;
+  }
+}
@@ -0,0 +1,130 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _DLOG_H_
+#define _DLOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uart.h"
+
+/**
+ * Deferred binary logging, formatted on the host.
+ *
+ * The format strings are kept in the .dlog_fmt section of the ELF, which is
+ * not loaded in memory. A log call only stores the offset of its format
+ * string and its arguments in a RAM ring buffer, e.g.
+ *   static uint32_t log_buffer[256];
+ *   dlog_init(log_buffer, 256);
+ *   DLOG("speed %d, setpoint %d\n", speed, setpoint);
+ *   ...
+ *   dlog_drain(&uart); // where there is time, e.g. in the idle loop
+ * and util/dlog_decode.py formats the messages from the ELF and the UART
+ * output (which can mix printf text and logs):
+ *   util/dlog_decode.py main.elf uart0.log
+ *
+ * The arguments are 32-bit integers (char, short, int, long, pointers) or
+ * pointers to strings of the ELF (string literals, const arrays) for %s.
+ * Floating point arguments are not supported.
+ */
+
+/**
+ * Maximum number of arguments of a log.
+ */
+#define DLOG_MAX_ARGS 15
+
+/**
+ * A record is a header word followed by its arguments. The header holds
+ * DLOG_SYNC in its top nibble, which is never an ASCII character, the number
+ * of arguments and the offset of the format string in .dlog_fmt.
+ */
+#define DLOG_SYNC 0xA
+#define DLOG_HEADER(id, nargs) \
+  (((uint32_t)DLOG_SYNC << 28) | ((uint32_t)(nargs) << 24) | ((id) & 0xFFFFFF))
+
+/**
+ * Format string identifier of the record telling how many logs were dropped
+ * because the buffer was full.
+ */
+#define DLOG_ID_DROPPED 0xFFFFFF
+
+// Argument conversion, a pointer is stored as its address
+#define DLOG_ARG(x) ((uint32_t)(uintptr_t)(x))
+#define DLOG_MAP_0()
+#define DLOG_MAP_1(a) , DLOG_ARG(a)
+#define DLOG_MAP_2(a, ...) , DLOG_ARG(a) DLOG_MAP_1(__VA_ARGS__)
+#define DLOG_MAP_3(a, ...) , DLOG_ARG(a) DLOG_MAP_2(__VA_ARGS__)
+#define DLOG_MAP_4(a, ...) , DLOG_ARG(a) DLOG_MAP_3(__VA_ARGS__)
+#define DLOG_MAP_5(a, ...) , DLOG_ARG(a) DLOG_MAP_4(__VA_ARGS__)
+#define DLOG_MAP_6(a, ...) , DLOG_ARG(a) DLOG_MAP_5(__VA_ARGS__)
+#define DLOG_MAP_7(a, ...) , DLOG_ARG(a) DLOG_MAP_6(__VA_ARGS__)
+#define DLOG_MAP_8(a, ...) , DLOG_ARG(a) DLOG_MAP_7(__VA_ARGS__)
+#define DLOG_MAP_9(a, ...) , DLOG_ARG(a) DLOG_MAP_8(__VA_ARGS__)
+#define DLOG_MAP_10(a, ...) , DLOG_ARG(a) DLOG_MAP_9(__VA_ARGS__)
+#define DLOG_MAP_11(a, ...) , DLOG_ARG(a) DLOG_MAP_10(__VA_ARGS__)
+#define DLOG_MAP_12(a, ...) , DLOG_ARG(a) DLOG_MAP_11(__VA_ARGS__)
+#define DLOG_MAP_13(a, ...) , DLOG_ARG(a) DLOG_MAP_12(__VA_ARGS__)
+#define DLOG_MAP_14(a, ...) , DLOG_ARG(a) DLOG_MAP_13(__VA_ARGS__)
+#define DLOG_MAP_15(a, ...) , DLOG_ARG(a) DLOG_MAP_14(__VA_ARGS__)
+#define DLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, \
+                    _14, _15, n, ...) n
+#define DLOG_NARGS(...) \
+  DLOG_NARGS_(0, ##__VA_ARGS__, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DLOG_CAT_(a, b) a##b
+#define DLOG_CAT(a, b) DLOG_CAT_(a, b)
+
+/**
+ * Log a message, printf style, with up to DLOG_MAX_ARGS arguments.
+ */
+#define DLOG(fmt, ...)                                                     \
+  do {                                                                     \
+    static const char dlog_fmt[]                                           \
+        __attribute__((section(".dlog_fmt"), used, aligned(1))) = fmt;     \
+    const uint32_t dlog_args[] = {                                         \
+        0 DLOG_CAT(DLOG_MAP_, DLOG_NARGS(__VA_ARGS__))(__VA_ARGS__)};      \
+    dlog_write((uint32_t)(uintptr_t)dlog_fmt, &dlog_args[1],               \
+               DLOG_NARGS(__VA_ARGS__));                                   \
+  } while (0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Set the ring buffer of the logs. Before, the logs are dropped silently.
+ * @param buffer Memory of the buffer, owned by the library from now on.
+ * @param words Size of the buffer in words.
+ */
+void dlog_init(uint32_t *buffer, size_t words);
+
+/**
+ * Store a record, used by DLOG. The record is dropped if it does not fit in
+ * the buffer. Can be called from interrupt handlers.
+ * @param id Offset of the format string in .dlog_fmt.
+ * @param args Arguments.
+ * @param nargs Number of arguments.
+ */
+void dlog_write(uint32_t id, const uint32_t *args, uint32_t nargs);
+
+/**
+ * Number of words waiting in the buffer.
+ */
+size_t dlog_pending(void);
+
+/**
+ * Send the records waiting in the buffer to the UART with uart_write, which
+ * returns right away with the UART TX buffer (see uart_tx_buffer_init).
+ * A DLOG_ID_DROPPED record is sent if logs were dropped, at the end of the
+ * record being sent.
+ * @param uart Pointer to uart_t represting the target UART.
+ * @return Number of words sent.
+ */
+size_t dlog_drain(const uart_t *uart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _DLOG_H_
@@ -8,6 +8,24 @@
 
 #include "dma.h"
 #include "dma_regs.h"  // Generated.
+#include "bitfield.h"
+#include "csr.h"
+#include "fast_intr_ctrl.h"
+
+// mip bit of the fast DMA interrupt
+#define DMA_FAST_INTR_MASK (1 << (16 + kDma_fic_e))
+
+// Registers changed by the transfers of a borrowed DMA, restored by dma_release
+static const ptrdiff_t kBorrowSavedRegs[] = {
+    DMA_PTR_IN_REG_OFFSET,        DMA_PTR_OUT_REG_OFFSET,
+    DMA_SRC_PTR_INC_REG_OFFSET,   DMA_DST_PTR_INC_REG_OFFSET,
+    DMA_SLOT_REG_OFFSET,          DMA_DATA_TYPE_REG_OFFSET,
+    DMA_DST_DATA_TYPE_REG_OFFSET, DMA_EXTEND_REG_OFFSET,
+    DMA_FILL_REG_OFFSET,          DMA_FILL_PATTERN_REG_OFFSET,
+};
+
+_Static_assert(sizeof(kBorrowSavedRegs) / sizeof(kBorrowSavedRegs[0]) == DMA_BORROW_SAVED_REGS,
+               "DMA_BORROW_SAVED_REGS must match kBorrowSavedRegs");
 
 void dma_set_read_ptr(const dma_t *dma, uint32_t read_ptr) {
   mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_PTR_IN_REG_OFFSET), read_ptr);
@@ -61,5 +79,70 @@ void dma_set_spi_mode(const dma_t *dma, uint32_t spi_mode){
 }
 
 void dma_set_data_type(const dma_t *dma, uint32_t data_type){
+  dma_set_src_data_type(dma, data_type);
+  dma_set_dst_data_type(dma, data_type);
+}
+
+void dma_set_src_data_type(const dma_t *dma, uint32_t data_type){
   mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_DATA_TYPE_REG_OFFSET), data_type);
 }
+
+void dma_set_dst_data_type(const dma_t *dma, uint32_t data_type){
+  mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_DST_DATA_TYPE_REG_OFFSET), data_type);
+}
+
+void dma_set_extend(const dma_t *dma, bool enable, bool sign_ext){
+  uint32_t extend = 0;
+  extend = bitfield_bit32_write(extend, DMA_EXTEND_EN_BIT, enable);
+  extend = bitfield_bit32_write(extend, DMA_EXTEND_SIGN_EXT_BIT, sign_ext);
+  mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_EXTEND_REG_OFFSET), extend);
+}
+
+void dma_set_fill(const dma_t *dma, bool enable, uint32_t pattern){
+  mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_FILL_PATTERN_REG_OFFSET), pattern);
+  mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_FILL_REG_OFFSET), enable << DMA_FILL_EN_BIT);
+}
+
+void dma_get_stats(const dma_t *dma, dma_stats_t *stats){
+  stats->bytes = mmio_region_read32(dma->base_addr, (ptrdiff_t)(DMA_STAT_BYTES_REG_OFFSET));
+  stats->busy_cycles = mmio_region_read32(dma->base_addr, (ptrdiff_t)(DMA_STAT_BUSY_REG_OFFSET));
+  stats->slot_stall_cycles = mmio_region_read32(dma->base_addr, (ptrdiff_t)(DMA_STAT_SLOT_STALL_REG_OFFSET));
+  stats->read_stall_cycles = mmio_region_read32(dma->base_addr, (ptrdiff_t)(DMA_STAT_READ_STALL_REG_OFFSET));
+  stats->write_stall_cycles = mmio_region_read32(dma->base_addr, (ptrdiff_t)(DMA_STAT_WRITE_STALL_REG_OFFSET));
+}
+
+void dma_clear_stats(const dma_t *dma){
+  mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_STAT_CLEAR_REG_OFFSET), 1 << DMA_STAT_CLEAR_STAT_CLEAR_BIT);
+}
+
+void dma_set_ext_start(const dma_t *dma, bool enable){
+  mmio_region_write32(dma->base_addr, (ptrdiff_t)(DMA_EXT_START_REG_OFFSET), enable << DMA_EXT_START_EN_BIT);
+}
+
+bool dma_get_ext_start(const dma_t *dma){
+  return mmio_region_get_bit32(dma->base_addr, (ptrdiff_t)(DMA_EXT_START_REG_OFFSET), DMA_EXT_START_EN_BIT);
+}
+
+bool dma_borrow(const dma_t *dma, dma_borrow_t *saved){
+  uint32_t mip;
+
+  CSR_READ(CSR_REG_MIP, &mip);
+  // busy, not serviced yet, or started by the event_matrix hardware triggers
+  if (dma_get_done(dma) == 0 || (mip & DMA_FAST_INTR_MASK) != 0 || dma_get_ext_start(dma)) {
+    return false;
+  }
+  for (size_t i = 0; i < DMA_BORROW_SAVED_REGS; ++i) {
+    saved->regs[i] = mmio_region_read32(dma->base_addr, kBorrowSavedRegs[i]);
+  }
+  return true;
+}
+
+void dma_release(const dma_t *dma, const dma_borrow_t *saved){
+  while (dma_get_done(dma) == 0) {
+  }
+  // the transfer is not seen by the fast interrupt handler nor by dma_async
+  clear_fast_interrupt(kDma_fic_e);
+  for (size_t i = 0; i < DMA_BORROW_SAVED_REGS; ++i) {
+    mmio_region_write32(dma->base_addr, kBorrowSavedRegs[i], saved->regs[i]);
+  }
+}
@@ -5,6 +5,7 @@
 #ifndef _DRIVERS_DMA_H_
 #define _DRIVERS_DMA_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -27,6 +28,9 @@
 #define DMA_SPI_FLASH_RX_SLOT 0b00000100
 #define DMA_SPI_FLASH_TX_SLOT 0b00001000
 #define DMA_I2S_RX_SLOT 0b00010000
+// One read (rx) or one write (tx) per tick of the always-on rv_timer 1
+#define DMA_TIMER_RX_SLOT 0b00100000
+#define DMA_TIMER_TX_SLOT 0b01000000
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +47,45 @@ typedef struct dma {
   mmio_region_t base_addr;
 } dma_t;
 
+/**
+ * DMA performance counters.
+ * They count across transfers until cleared with dma_clear_stats.
+ */
+typedef struct dma_stats {
+  /**
+   * Bytes written to the destination.
+   */
+  uint32_t bytes;
+  /**
+   * Cycles the DMA was transferring data.
+   */
+  uint32_t busy_cycles;
+  /**
+   * Cycles waiting for a trigger slot (the peripheral is the bottleneck).
+   */
+  uint32_t slot_stall_cycles;
+  /**
+   * Cycles a read request waited for the bus grant (bus contention).
+   */
+  uint32_t read_stall_cycles;
+  /**
+   * Cycles a write request waited for the bus grant (bus contention).
+   */
+  uint32_t write_stall_cycles;
+} dma_stats_t;
+
+/**
+ * Number of DMA registers changed by a transfer, saved by dma_borrow.
+ */
+#define DMA_BORROW_SAVED_REGS 10
+
+/**
+ * DMA configuration saved by dma_borrow, restored by dma_release.
+ */
+typedef struct dma_borrow {
+  uint32_t regs[DMA_BORROW_SAVED_REGS];
+} dma_borrow_t;
+
 /**
  * Write to read_ptr register of the DMA
  * @param dma Pointer to dma_t represting the target MEMCOPY PERIPHERAL.
@@ -109,12 +152,104 @@ void dma_set_slot(const dma_t *dma, uint16_t rx_slot_mask, uint16_t tx_slot_mask
 void dma_set_spi_mode(const dma_t *dma, uint32_t spi_mode);
 
 /**
- * Sets the DMA data type.
+ * Sets the DMA data type, the same for source and destination.
  * @param dma Pointer to dma_t represting the target DMA.
  * @param data_type Data type to transfer: 32-bit word(0), 16-bit half word (1), 8-bit byte(2,3).
  */
 void dma_set_data_type(const dma_t *dma, uint32_t data_type);
 
+/**
+ * Sets the DMA source data type.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param data_type Data type to read: 32-bit word(0), 16-bit half word (1), 8-bit byte(2,3).
+ */
+void dma_set_src_data_type(const dma_t *dma, uint32_t data_type);
+
+/**
+ * Sets the DMA destination data type.
+ * When wider than the source data type, source elements are packed into
+ * destination elements (e.g. 4 bytes into 1 word), when narrower they are
+ * unpacked, unless the extend mode is enabled.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param data_type Data type to write: 32-bit word(0), 16-bit half word (1), 8-bit byte(2,3).
+ */
+void dma_set_dst_data_type(const dma_t *dma, uint32_t data_type);
+
+/**
+ * Sets the DMA extend mode.
+ * In extend mode every source element is written as one destination element,
+ * zero or sign extended if the destination type is wider (e.g. 16-bit PCM
+ * samples into 32-bit words), truncated if it is narrower.
+ * The transfer size given to dma_set_cnt_start is always in source bytes.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param enable Enable the extend mode (Default: false).
+ * @param sign_ext Sign extension (true) or zero extension (false).
+ */
+void dma_set_extend(const dma_t *dma, bool enable, bool sign_ext);
+
+/**
+ * Sets the DMA fill mode.
+ * In fill mode the source is not read, the pattern is written over the
+ * destination instead, one destination data type element at a time
+ * (e.g. zeroing a buffer word by word). The transfer size given to
+ * dma_set_cnt_start is the number of destination bytes.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param enable Enable the fill mode (Default: false).
+ * @param pattern Pattern to write, only its destination data type low bits are used.
+ */
+void dma_set_fill(const dma_t *dma, bool enable, uint32_t pattern);
+
+/**
+ * Reads the DMA performance counters.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param stats Filled with the counter values.
+ */
+void dma_get_stats(const dma_t *dma, dma_stats_t *stats);
+
+/**
+ * Resets all the DMA performance counters to 0.
+ * @param dma Pointer to dma_t represting the target DMA.
+ */
+void dma_clear_stats(const dma_t *dma);
+
+/**
+ * Enables the hardware start of the DMA (event_matrix DMA start action).
+ * When enabled, each hardware start received while the DMA is idle starts
+ * the transfer programmed with the functions above, without
+ * dma_set_cnt_start. The DMA must not be used through dma_async meanwhile,
+ * dma_memcpy copies with the CPU instead.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param enable Enable the hardware start (Default: false).
+ */
+void dma_set_ext_start(const dma_t *dma, bool enable);
+
+/**
+ * Reads whether the hardware start of the DMA is enabled.
+ * @param dma Pointer to dma_t represting the target DMA.
+ */
+bool dma_get_ext_start(const dma_t *dma);
+
+/**
+ * Borrows the DMA for a transfer outside of dma_async, waited for with
+ * dma_release. The DMA is only borrowed when it is idle, no DMA fast interrupt
+ * is pending and its hardware start is disabled. The registers changed by a
+ * transfer are saved. Must be called with the interrupts disabled, until
+ * dma_release returns.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param saved Where to save the DMA configuration.
+ * @return false if the DMA is in use, the caller moves the data itself.
+ */
+bool dma_borrow(const dma_t *dma, dma_borrow_t *saved);
+
+/**
+ * Waits for the transfer started on the borrowed DMA, clears its fast
+ * interrupt, so that neither fic_irq_dma nor dma_async see it, and restores
+ * the configuration saved by dma_borrow.
+ * @param dma Pointer to dma_t represting the target DMA.
+ * @param saved DMA configuration saved by dma_borrow.
+ */
+void dma_release(const dma_t *dma, const dma_borrow_t *saved);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,197 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma_async.h"
+#include "csr.h"
+#include "hart.h"
+#include "fast_intr_ctrl.h"
+
+// mie bit of the fast DMA interrupt
+#define DMA_ASYNC_FAST_INTR_MASK (1 << 19)
+// mstatus.MIE
+#define DMA_ASYNC_MSTATUS_MIE (1 << 3)
+
+typedef struct dma_async_entry {
+  dma_job_t job;
+  dma_callback_t cb;
+  void *ctx;
+  dma_job_id_t id;
+} dma_async_entry_t;
+
+static dma_t dma_async_periph;
+static dma_async_entry_t dma_async_queue[DMA_ASYNC_QUEUE_SIZE];
+static volatile uint32_t dma_async_head;
+static volatile uint32_t dma_async_count;
+static volatile bool dma_async_running;
+static dma_job_id_t dma_async_next_id = 1;
+static bool dma_async_ready = false;
+
+static inline uint32_t dma_async_lock(void) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_CLEAR_BITS(CSR_REG_MSTATUS, DMA_ASYNC_MSTATUS_MIE);
+  return mstatus;
+}
+
+static inline void dma_async_unlock(uint32_t mstatus) {
+  if (mstatus & DMA_ASYNC_MSTATUS_MIE) {
+    CSR_SET_BITS(CSR_REG_MSTATUS, DMA_ASYNC_MSTATUS_MIE);
+  }
+}
+
+static inline dma_async_entry_t *dma_async_entry(uint32_t pos) {
+  return &dma_async_queue[(dma_async_head + pos) % DMA_ASYNC_QUEUE_SIZE];
+}
+
+// Must be called with interrupts disabled, with the job at the head of the queue.
+static void dma_async_launch(void) {
+  const dma_t *dma = &dma_async_periph;
+  const dma_job_t *job = &dma_async_entry(0)->job;
+
+  dma_async_running = true;
+  dma_set_read_ptr(dma, job->src);
+  dma_set_write_ptr(dma, job->dst);
+  dma_set_read_ptr_inc(dma, job->src_inc);
+  dma_set_write_ptr_inc(dma, job->dst_inc);
+  dma_set_slot(dma, job->rx_slot_mask, job->tx_slot_mask);
+  dma_set_src_data_type(dma, job->src_type);
+  dma_set_dst_data_type(dma, job->dst_type);
+  dma_set_extend(dma, job->extend, job->sign_ext);
+  dma_set_fill(dma, job->fill, job->fill_pattern);
+  dma_set_cnt_start(dma, job->size);
+}
+
+// Position of a job waiting in the queue, -1 if not found.
+static int32_t dma_async_find(dma_job_id_t id) {
+  for (uint32_t i = 0; i < dma_async_count; i++) {
+    if (dma_async_entry(i)->id == id) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void dma_async_init(const dma_t *dma) {
+  dma_async_periph = *dma;
+  dma_async_head = 0;
+  dma_async_count = 0;
+  dma_async_running = false;
+  dma_async_ready = true;
+
+  enable_fast_interrupt(kDma_fic_e, true);
+  CSR_SET_BITS(CSR_REG_MIE, DMA_ASYNC_FAST_INTR_MASK);
+}
+
+dma_job_id_t dma_submit(const dma_job_t *job, dma_callback_t cb, void *ctx) {
+  dma_job_id_t id = DMA_ASYNC_INVALID_JOB;
+  uint32_t mstatus = dma_async_lock();
+
+  // A zero size never starts the DMA, the job would block the queue
+  if (dma_async_ready && job->size != 0 && dma_async_count < DMA_ASYNC_QUEUE_SIZE) {
+    dma_async_entry_t *entry = dma_async_entry(dma_async_count);
+    id = dma_async_next_id++;
+    if (dma_async_next_id == DMA_ASYNC_INVALID_JOB) {
+      dma_async_next_id++;
+    }
+    entry->job = *job;
+    entry->cb = cb;
+    entry->ctx = ctx;
+    entry->id = id;
+    dma_async_count++;
+    // The DMA is idle, start right away
+    if (!dma_async_running) {
+      dma_async_launch();
+    }
+  }
+
+  dma_async_unlock(mstatus);
+  return id;
+}
+
+bool dma_cancel(dma_job_id_t id) {
+  bool removed = false;
+  uint32_t mstatus = dma_async_lock();
+
+  int32_t pos = dma_async_find(id);
+  // The head of the queue is being transferred
+  if (pos > 0 || (pos == 0 && !dma_async_running)) {
+    for (uint32_t i = pos; i + 1 < dma_async_count; i++) {
+      *dma_async_entry(i) = *dma_async_entry(i + 1);
+    }
+    dma_async_count--;
+    removed = true;
+  }
+
+  dma_async_unlock(mstatus);
+  return removed;
+}
+
+bool dma_job_done(dma_job_id_t id) {
+  uint32_t mstatus = dma_async_lock();
+  bool done = dma_async_find(id) < 0;
+  dma_async_unlock(mstatus);
+  return done;
+}
+
+void dma_wait(dma_job_id_t id) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+
+  while (!dma_job_done(id)) {
+    // Check again with interrupts disabled so the completion cannot be missed,
+    // wfi still wakes up on a pending interrupt.
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, DMA_ASYNC_MSTATUS_MIE);
+    if (dma_async_find(id) >= 0) {
+      wait_for_interrupt();
+    }
+    CSR_SET_BITS(CSR_REG_MSTATUS, DMA_ASYNC_MSTATUS_MIE);
+  }
+
+  // Interrupts are needed to make progress, restore the caller state
+  if ((mstatus & DMA_ASYNC_MSTATUS_MIE) == 0) {
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, DMA_ASYNC_MSTATUS_MIE);
+  }
+}
+
+void dma_wait_all(void) {
+  while (true) {
+    uint32_t mstatus = dma_async_lock();
+    dma_job_id_t last = dma_async_count != 0 ? dma_async_entry(dma_async_count - 1)->id
+                                             : DMA_ASYNC_INVALID_JOB;
+    dma_async_unlock(mstatus);
+    if (last == DMA_ASYNC_INVALID_JOB) {
+      break;
+    }
+    dma_wait(last);
+  }
+}
+
+void dma_async_irq_handler(void) {
+  if (!dma_async_running) {
+    // The DMA was used directly, not through the queue
+    return;
+  }
+
+  dma_async_entry_t entry = *dma_async_entry(0);
+  dma_async_head = (dma_async_head + 1) % DMA_ASYNC_QUEUE_SIZE;
+  dma_async_count--;
+  dma_async_running = false;
+
+  if (entry.cb != NULL) {
+    entry.cb(entry.ctx);
+  }
+
+  // The callback may have already submitted and launched a new job
+  if (!dma_async_running && dma_async_count != 0) {
+    dma_async_launch();
+  }
+}
+
+// Serviced from the DMA fast interrupt, before the user fic_irq_dma
+void fic_driver_irq_dma(void) {
+  dma_async_irq_handler();
+}
@@ -0,0 +1,155 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _DRIVERS_DMA_ASYNC_H_
+#define _DRIVERS_DMA_ASYNC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma.h"
+
+/**
+ * Number of jobs that can be waiting in the software queue, including the
+ * one being transferred. Can be overriden at compile time.
+ */
+#ifndef DMA_ASYNC_QUEUE_SIZE
+#define DMA_ASYNC_QUEUE_SIZE 8
+#endif
+
+/**
+ * Invalid job identifier, returned when a job cannot be submitted.
+ */
+#define DMA_ASYNC_INVALID_JOB 0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Description of a DMA transfer.
+ * The fields map one to one to the DMA registers (see dma.h).
+ */
+typedef struct dma_job {
+  /**
+   * Source address.
+   */
+  uint32_t src;
+  /**
+   * Destination address.
+   */
+  uint32_t dst;
+  /**
+   * Number of source bytes to transfer.
+   */
+  uint32_t size;
+  /**
+   * Source pointer increment (0 to pop from a peripheral FIFO).
+   */
+  uint32_t src_inc;
+  /**
+   * Destination pointer increment (0 to push into a peripheral FIFO).
+   */
+  uint32_t dst_inc;
+  /**
+   * Source data type: 32-bit word(0), 16-bit half word (1), 8-bit byte(2,3).
+   */
+  uint32_t src_type;
+  /**
+   * Destination data type: 32-bit word(0), 16-bit half word (1), 8-bit byte(2,3).
+   */
+  uint32_t dst_type;
+  /**
+   * Convert every source element into one destination element.
+   */
+  bool extend;
+  /**
+   * Sign extension (true) or zero extension (false), in extend mode only.
+   */
+  bool sign_ext;
+  /**
+   * Write fill_pattern to the destination instead of reading the source.
+   */
+  bool fill;
+  /**
+   * Pattern written in fill mode.
+   */
+  uint32_t fill_pattern;
+  /**
+   * Trigger slots the read side waits for (e.g. DMA_SPI_RX_SLOT).
+   */
+  uint16_t rx_slot_mask;
+  /**
+   * Trigger slots the write side waits for (e.g. DMA_SPI_TX_SLOT).
+   */
+  uint16_t tx_slot_mask;
+} dma_job_t;
+
+/**
+ * Identifier of a submitted job.
+ */
+typedef uint32_t dma_job_id_t;
+
+/**
+ * Completion callback, called from the DMA interrupt handler once the job
+ * is done and before the next job is launched.
+ */
+typedef void (*dma_callback_t)(void *ctx);
+
+/**
+ * Initialize the job queue and enable the DMA fast interrupt.
+ * Machine-level interrupts still have to be enabled globally (mstatus.MIE).
+ * @param dma Pointer to dma_t represting the target DMA.
+ */
+void dma_async_init(const dma_t *dma);
+
+/**
+ * Submit a job. It is copied into the queue and launched as soon as the
+ * jobs submitted before it are done, so the caller does not need to keep it.
+ * @param job Description of the transfer.
+ * @param cb Completion callback, can be NULL.
+ * @param ctx Argument given to the callback.
+ * @return The job identifier, DMA_ASYNC_INVALID_JOB if the job size is 0, or
+ * if the queue is full or not initialized.
+ */
+dma_job_id_t dma_submit(const dma_job_t *job, dma_callback_t cb, void *ctx);
+
+/**
+ * Remove a job from the queue before it is launched. Its callback is not
+ * called. A job already being transferred cannot be cancelled.
+ * @param id Identifier returned by dma_submit.
+ * @return true if the job was removed.
+ */
+bool dma_cancel(dma_job_id_t id);
+
+/**
+ * Check if a job is finished (done or cancelled).
+ * @param id Identifier returned by dma_submit.
+ */
+bool dma_job_done(dma_job_id_t id);
+
+/**
+ * Wait for a job to be finished, sleeping with wfi in between interrupts.
+ * @param id Identifier returned by dma_submit.
+ */
+void dma_wait(dma_job_id_t id);
+
+/**
+ * Wait for all the submitted jobs to be finished.
+ */
+void dma_wait_all(void);
+
+/**
+ * Completes the running job and launches the next one.
+ * Called through the fic_driver_irq_dma hook of the fast DMA interrupt
+ * handler, before fic_irq_dma.
+ */
+void dma_async_irq_handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_DMA_ASYNC_H_
@@ -0,0 +1,207 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma_memcpy.h"
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "memory.h"
+
+// DMA data types used for the transfers (see dma.h).
+enum {
+  kDmaMemcpyWord = 0,
+  kDmaMemcpyByte = 2,
+};
+
+// mstatus.MIE
+#define DMA_MEMCPY_MSTATUS_MIE (1 << 3)
+
+static inline bool same_word_offset(const void *a, const void *b) {
+  return (((uintptr_t)a ^ (uintptr_t)b) & (sizeof(uint32_t) - 1)) == 0;
+}
+
+static inline uint32_t byte_pattern(int value) {
+  return (uint8_t)value * 0x01010101u;
+}
+
+// Bytes to handle with the CPU before `ptr` is word-aligned.
+static inline size_t head_len(const void *ptr, size_t len) {
+  size_t head = (size_t)(-(uintptr_t)ptr & (sizeof(uint32_t) - 1));
+  return head < len ? head : len;
+}
+
+static dma_job_t copy_job(uint8_t *dest8, const uint8_t *src8, size_t len,
+                          uint32_t data_type) {
+  uint32_t inc = data_type == kDmaMemcpyWord ? sizeof(uint32_t) : 1;
+  return (dma_job_t){
+      .src = (uint32_t)src8,
+      .dst = (uint32_t)dest8,
+      .size = len,
+      .src_inc = inc,
+      .dst_inc = inc,
+      .src_type = data_type,
+      .dst_type = data_type,
+  };
+}
+
+// `dest8` must be word-aligned.
+static dma_job_t fill_job(uint8_t *dest8, int value, size_t len) {
+  return (dma_job_t){
+      .dst = (uint32_t)dest8,
+      .size = len,
+      .dst_inc = sizeof(uint32_t),
+      .src_type = kDmaMemcpyWord,
+      .dst_type = kDmaMemcpyWord,
+      .fill = true,
+      .fill_pattern = byte_pattern(value),
+  };
+}
+
+/**
+ * Runs one memory to memory transfer on the DMA and waits for it.
+ * @return false if the DMA is in use or its hardware start is enabled, the
+ * caller must do the copy itself.
+ */
+static bool dma_memcpy_transfer(const dma_job_t *job) {
+  dma_borrow_t saved;
+  dma_t dma = {
+      .base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS),
+  };
+  uint32_t mstatus;
+  bool done = false;
+
+  if (job->size == 0) {
+    return true;
+  }
+
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_CLEAR_BITS(CSR_REG_MSTATUS, DMA_MEMCPY_MSTATUS_MIE);
+
+  if (dma_borrow(&dma, &saved)) {
+    dma_set_read_ptr(&dma, job->src);
+    dma_set_write_ptr(&dma, job->dst);
+    dma_set_read_ptr_inc(&dma, job->src_inc);
+    dma_set_write_ptr_inc(&dma, job->dst_inc);
+    dma_set_slot(&dma, 0, 0);
+    dma_set_src_data_type(&dma, job->src_type);
+    dma_set_dst_data_type(&dma, job->dst_type);
+    dma_set_extend(&dma, false, false);
+    dma_set_fill(&dma, job->fill, job->fill_pattern);
+    dma_set_cnt_start(&dma, job->size);
+    dma_release(&dma, &saved);
+    done = true;
+  }
+
+  if (mstatus & DMA_MEMCPY_MSTATUS_MIE) {
+    CSR_SET_BITS(CSR_REG_MSTATUS, DMA_MEMCPY_MSTATUS_MIE);
+  }
+  return done;
+}
+
+void *dma_memcpy(void *dest, const void *src, size_t len) {
+  uint8_t *dest8 = (uint8_t *)dest;
+  const uint8_t *src8 = (const uint8_t *)src;
+
+  if (len < DMA_MEMCPY_THRESHOLD) {
+    return memcpy(dest, src, len);
+  }
+
+  if (!same_word_offset(dest8, src8)) {
+    // Words cannot be used on both sides, the DMA still copies bytes faster.
+    dma_job_t job = copy_job(dest8, src8, len, kDmaMemcpyByte);
+    if (!dma_memcpy_transfer(&job)) {
+      memcpy(dest8, src8, len);
+    }
+    return dest;
+  }
+
+  size_t head = head_len(dest8, len);
+  size_t words = (len - head) & ~(sizeof(uint32_t) - 1);
+  dma_job_t job = copy_job(dest8 + head, src8 + head, words, kDmaMemcpyWord);
+  if (!dma_memcpy_transfer(&job)) {
+    return memcpy(dest, src, len);
+  }
+  memcpy(dest8, src8, head);
+  memcpy(dest8 + head + words, src8 + head + words, len - head - words);
+  return dest;
+}
+
+void *dma_memset(void *dest, int value, size_t len) {
+  uint8_t *dest8 = (uint8_t *)dest;
+
+  if (len < DMA_MEMCPY_THRESHOLD) {
+    return memset(dest, value, len);
+  }
+
+  size_t head = head_len(dest8, len);
+  size_t words = (len - head) & ~(sizeof(uint32_t) - 1);
+  dma_job_t job = fill_job(dest8 + head, value, words);
+  if (!dma_memcpy_transfer(&job)) {
+    return memset(dest, value, len);
+  }
+  memset(dest8, value, head);
+  memset(dest8 + head + words, value, len - head - words);
+  return dest;
+}
+
+dma_job_id_t dma_memcpy_async(void *dest, const void *src, size_t len,
+                              dma_callback_t cb, void *ctx) {
+  uint8_t *dest8 = (uint8_t *)dest;
+  const uint8_t *src8 = (const uint8_t *)src;
+  dma_job_id_t id = DMA_ASYNC_INVALID_JOB;
+
+  if (len >= DMA_MEMCPY_THRESHOLD) {
+    dma_job_t job = copy_job(dest8, src8, len, kDmaMemcpyByte);
+    size_t head = 0;
+    size_t tail = 0;
+    if (same_word_offset(dest8, src8)) {
+      head = head_len(dest8, len);
+      tail = (len - head) & (sizeof(uint32_t) - 1);
+      job = copy_job(dest8 + head, src8 + head, len - head - tail,
+                     kDmaMemcpyWord);
+    }
+    // The unaligned edges are copied first, the callback then means that the
+    // whole buffer is done.
+    memcpy(dest8, src8, head);
+    memcpy(dest8 + len - tail, src8 + len - tail, tail);
+    id = dma_submit(&job, cb, ctx);
+    if (id != DMA_ASYNC_INVALID_JOB) {
+      return id;
+    }
+  }
+
+  memcpy(dest8, src8, len);
+  if (cb != NULL) {
+    cb(ctx);
+  }
+  return id;
+}
+
+dma_job_id_t dma_memset_async(void *dest, int value, size_t len,
+                              dma_callback_t cb, void *ctx) {
+  uint8_t *dest8 = (uint8_t *)dest;
+  dma_job_id_t id = DMA_ASYNC_INVALID_JOB;
+
+  if (len >= DMA_MEMCPY_THRESHOLD) {
+    size_t head = head_len(dest8, len);
+    size_t tail = (len - head) & (sizeof(uint32_t) - 1);
+    dma_job_t job = fill_job(dest8 + head, value, len - head - tail);
+    memset(dest8, value, head);
+    memset(dest8 + len - tail, value, tail);
+    id = dma_submit(&job, cb, ctx);
+    if (id != DMA_ASYNC_INVALID_JOB) {
+      return id;
+    }
+  }
+
+  memset(dest8, value, len);
+  if (cb != NULL) {
+    cb(ctx);
+  }
+  return id;
+}
@@ -0,0 +1,97 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// memcpy/memset offloaded to the DMA. The plain memcpy/memset of memory.h (or
+// the libc) never touch the DMA, these functions have to be called explicitly.
+
+#ifndef _DRIVERS_DMA_MEMCPY_H_
+#define _DRIVERS_DMA_MEMCPY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma_async.h"
+
+/**
+ * Minimum length, in bytes, for the functions below to hand the transfer over
+ * to the DMA. Below this size programming the DMA costs more than the copy
+ * itself, which is then done with memcpy/memset. Can be overriden at compile
+ * time.
+ */
+#ifndef DMA_MEMCPY_THRESHOLD
+#define DMA_MEMCPY_THRESHOLD 256
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Copy memory between non-overlapping regions with the DMA and wait for it.
+ *
+ * The DMA is only borrowed when it is idle and no DMA interrupt is pending,
+ * its configuration is restored afterwards and its completion interrupt is
+ * cleared, so the dma_async queue and the fic_irq_dma handler do not see it.
+ * Interrupts are disabled during the transfer. When the DMA is in use, or its
+ * hardware start is enabled (dma_set_ext_start) so that an event_matrix
+ * channel can start it, the copy is done by the CPU.
+ *
+ * @param dest the region to copy to.
+ * @param src the region to copy from.
+ * @param len the number of bytes to copy.
+ * @return the value of `dest`.
+ */
+void *dma_memcpy(void *dest, const void *src, size_t len);
+
+/**
+ * Set a region of memory to a particular byte value with the DMA fill mode
+ * and wait for it. Same behaviour as `dma_memcpy()`.
+ *
+ * @param dest the region to write to.
+ * @param value the value, converted to a byte, to write to each byte cell.
+ * @param len the number of bytes to write.
+ * @return the value of `dest`.
+ */
+void *dma_memset(void *dest, int value, size_t len);
+
+/**
+ * Start copying memory between non-overlapping regions with the DMA and return
+ * immediately.
+ *
+ * The transfer is queued with `dma_submit()`, so `dma_async_init()` must have
+ * been called. Its result can be waited for with `dma_wait()`. When the DMA
+ * cannot be used (small size, queue full or not initialized) the copy is done
+ * before returning and the callback is called right away.
+ *
+ * @param dest the region to copy to.
+ * @param src the region to copy from, must not change until the copy is done.
+ * @param len the number of bytes to copy.
+ * @param cb called once the copy is done, can be NULL.
+ * @param ctx argument given to `cb`.
+ * @return the identifier of the transfer, DMA_ASYNC_INVALID_JOB if the copy is
+ * already done.
+ */
+dma_job_id_t dma_memcpy_async(void *dest, const void *src, size_t len,
+                              dma_callback_t cb, void *ctx);
+
+/**
+ * Start setting a region of memory to a particular byte value with the DMA and
+ * return immediately. Same behaviour as `dma_memcpy_async()`.
+ *
+ * @param dest the region to write to.
+ * @param value the value, converted to a byte, to write to each byte cell.
+ * @param len the number of bytes to write.
+ * @param cb called once the region is written, can be NULL.
+ * @param ctx argument given to `cb`.
+ * @return the identifier of the transfer, DMA_ASYNC_INVALID_JOB if the region
+ * is already written.
+ */
+dma_job_id_t dma_memset_async(void *dest, int value, size_t len,
+                              dma_callback_t cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _DRIVERS_DMA_MEMCPY_H_
@@ -47,7 +47,7 @@ extern "C" {
 #define DMA_SLOT_TX_TRIGGER_SLOT_FIELD \
   ((bitfield_field32_t) { .mask = DMA_SLOT_TX_TRIGGER_SLOT_MASK, .index = DMA_SLOT_TX_TRIGGER_SLOT_OFFSET })
 
-// Data type to transfer: 32-bit word(0), 16-bit half word(1), 8-bit
+// Source data type to transfer: 32-bit word(0), 16-bit half word(1), 8-bit
 // byte(2,3).
 #define DMA_DATA_TYPE_REG_OFFSET 0x1c
 #define DMA_DATA_TYPE_DATA_TYPE_MASK 0x3
@@ -59,6 +59,54 @@ extern "C" {
 #define DMA_DATA_TYPE_DATA_TYPE_VALUE_DMA_8BIT_WORD 0x2
 #define DMA_DATA_TYPE_DATA_TYPE_VALUE_DMA_8BIT_WORD_2 0x3
 
+// Destination data type to transfer: 32-bit word(0), 16-bit half word(1),
+// 8-bit byte(2,3).
+#define DMA_DST_DATA_TYPE_REG_OFFSET 0x20
+#define DMA_DST_DATA_TYPE_DST_DATA_TYPE_MASK 0x3
+#define DMA_DST_DATA_TYPE_DST_DATA_TYPE_OFFSET 0
+#define DMA_DST_DATA_TYPE_DST_DATA_TYPE_FIELD \
+  ((bitfield_field32_t) { .mask = DMA_DST_DATA_TYPE_DST_DATA_TYPE_MASK, .index = DMA_DST_DATA_TYPE_DST_DATA_TYPE_OFFSET })
+#define DMA_DST_DATA_TYPE_DST_DATA_TYPE_VALUE_DMA_32BIT_WORD 0x0
+#define DMA_DST_DATA_TYPE_DST_DATA_TYPE_VALUE_DMA_16BIT_WORD 0x1
+#define DMA_DST_DATA_TYPE_DST_DATA_TYPE_VALUE_DMA_8BIT_WORD 0x2
+#define DMA_DST_DATA_TYPE_DST_DATA_TYPE_VALUE_DMA_8BIT_WORD_2 0x3
+
+// Conversion between source and destination data types of different width.
+#define DMA_EXTEND_REG_OFFSET 0x24
+#define DMA_EXTEND_EN_BIT 0
+#define DMA_EXTEND_SIGN_EXT_BIT 1
+
+// Fill mode: FILL_PATTERN is written to the destination, the source is not
+// read
+#define DMA_FILL_REG_OFFSET 0x28
+#define DMA_FILL_EN_BIT 0
+
+// Pattern written in fill mode, only its DST_DATA_TYPE low bits are used
+#define DMA_FILL_PATTERN_REG_OFFSET 0x2c
+
+// Number of bytes written by the DMA
+#define DMA_STAT_BYTES_REG_OFFSET 0x30
+
+// Number of cycles the DMA was transferring data
+#define DMA_STAT_BUSY_REG_OFFSET 0x34
+
+// Number of cycles the DMA was waiting for a trigger slot
+#define DMA_STAT_SLOT_STALL_REG_OFFSET 0x38
+
+// Number of cycles a read request was waiting for the bus grant
+#define DMA_STAT_READ_STALL_REG_OFFSET 0x3c
+
+// Number of cycles a write request was waiting for the bus grant
+#define DMA_STAT_WRITE_STALL_REG_OFFSET 0x40
+
+// Clear the performance counters
+#define DMA_STAT_CLEAR_REG_OFFSET 0x44
+#define DMA_STAT_CLEAR_STAT_CLEAR_BIT 0
+
+// Hardware start (event matrix DMA start action)
+#define DMA_EXT_START_REG_OFFSET 0x48
+#define DMA_EXT_START_EN_BIT 0
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
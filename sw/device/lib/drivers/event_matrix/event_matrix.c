@@ -0,0 +1,98 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "event_matrix.h"
+#include "event_matrix_regs.h"  // Generated.
+#include "bitfield.h"
+
+// The CHANNEL registers are contiguous, one per channel
+#define EVENT_MATRIX_CHANNEL_REG_OFFSET(channel) \
+  (EVENT_MATRIX_CHANNEL_0_REG_OFFSET + (channel) * sizeof(uint32_t))
+
+bool event_matrix_connect(const event_matrix_t *em, uint32_t channel, uint32_t source,
+                          event_matrix_edge_t edge, event_matrix_action_t action,
+                          uint32_t target) {
+  if (channel >= EVENT_MATRIX_PARAM_NUM_CHANNELS || source >= EVENT_MATRIX_NUM_SOURCES) {
+    return false;
+  }
+  if ((action == kEventMatrixTimerStart || action == kEventMatrixTimerStop) &&
+      target >= EVENT_MATRIX_NUM_TIMERS) {
+    return false;
+  }
+  if (target >= EVENT_MATRIX_NUM_GPIOS) {
+    return false;
+  }
+
+  uint32_t reg = 0;
+  reg = bitfield_field32_write(reg, EVENT_MATRIX_CHANNEL_0_SOURCE_0_FIELD, source);
+  reg = bitfield_field32_write(reg, EVENT_MATRIX_CHANNEL_0_ACTION_0_FIELD, action);
+  reg = bitfield_field32_write(reg, EVENT_MATRIX_CHANNEL_0_TARGET_0_FIELD, target);
+  // The edge last, the channel may fire as soon as it is written
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_CHANNEL_REG_OFFSET(channel), reg);
+  reg = bitfield_field32_write(reg, EVENT_MATRIX_CHANNEL_0_EDGE_SEL_0_FIELD, edge);
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_CHANNEL_REG_OFFSET(channel), reg);
+  return true;
+}
+
+void event_matrix_disconnect(const event_matrix_t *em, uint32_t channel) {
+  if (channel < EVENT_MATRIX_PARAM_NUM_CHANNELS) {
+    mmio_region_write32(em->base_addr, EVENT_MATRIX_CHANNEL_REG_OFFSET(channel), 0);
+  }
+}
+
+void event_matrix_trigger(const event_matrix_t *em, uint32_t channel) {
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_TRIGGER_REG_OFFSET, 1 << channel);
+}
+
+bool event_matrix_fired(const event_matrix_t *em, uint32_t channel) {
+  return mmio_region_get_bit32(em->base_addr, EVENT_MATRIX_FIRED_REG_OFFSET, channel);
+}
+
+void event_matrix_clear_fired(const event_matrix_t *em, uint32_t channel) {
+  // Write 1 to clear
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_FIRED_REG_OFFSET, 1 << channel);
+}
+
+void event_matrix_set_dma_size(const event_matrix_t *em, uint32_t size) {
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_DMA_SIZE_REG_OFFSET, size);
+}
+
+bool event_matrix_set_timer_gate(const event_matrix_t *em, uint32_t hart, bool enable, bool run) {
+  if (hart >= EVENT_MATRIX_NUM_TIMERS) {
+    return false;
+  }
+  // The run state first, the hart is held as soon as it is gated
+  uint32_t reg = mmio_region_read32(em->base_addr, EVENT_MATRIX_TIMER_RUN_REG_OFFSET);
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_TIMER_RUN_REG_OFFSET,
+                      bitfield_bit32_write(reg, hart, run));
+  reg = mmio_region_read32(em->base_addr, EVENT_MATRIX_TIMER_GATE_REG_OFFSET);
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_TIMER_GATE_REG_OFFSET,
+                      bitfield_bit32_write(reg, hart, enable));
+  return true;
+}
+
+bool event_matrix_timer_running(const event_matrix_t *em, uint32_t hart) {
+  return mmio_region_get_bit32(em->base_addr, EVENT_MATRIX_TIMER_RUN_REG_OFFSET, hart);
+}
+
+bool event_matrix_set_gpio(const event_matrix_t *em, uint32_t pin, bool enable, bool value) {
+  if (pin >= EVENT_MATRIX_NUM_GPIOS) {
+    return false;
+  }
+  // The value first, the pin is driven as soon as it is selected
+  uint32_t reg = mmio_region_read32(em->base_addr, EVENT_MATRIX_GPIO_OUT_REG_OFFSET);
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_GPIO_OUT_REG_OFFSET,
+                      bitfield_bit32_write(reg, pin, value));
+  reg = mmio_region_read32(em->base_addr, EVENT_MATRIX_GPIO_SEL_REG_OFFSET);
+  mmio_region_write32(em->base_addr, EVENT_MATRIX_GPIO_SEL_REG_OFFSET,
+                      bitfield_bit32_write(reg, pin, enable));
+  return true;
+}
+
+bool event_matrix_get_gpio(const event_matrix_t *em, uint32_t pin) {
+  return mmio_region_get_bit32(em->base_addr, EVENT_MATRIX_GPIO_OUT_REG_OFFSET, pin);
+}
@@ -0,0 +1,172 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Always-on event system: each channel connects a source event (interrupt line,
+// DMA trigger slot, timer tick, GPIO pin) to an action on the DMA, the
+// always-on rv_timer or the always-on GPIOs, without the CPU. The number of
+// channels is set by event_matrix/channels in mcu_cfg.hjson, from 2 to 32.
+
+#ifndef _DRIVERS_EVENT_MATRIX_H_
+#define _DRIVERS_EVENT_MATRIX_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mmio.h"
+
+/**
+ * Source events, see ao_peripheral_subsystem.sv.
+ */
+// Level of the always-on GPIO pin 0 to 7
+#define EVENT_MATRIX_SRC_GPIO(pin) (pin)
+// Fast interrupt line, e.g. EVENT_MATRIX_SRC_FAST_INTR(kDma_fic_e) for the DMA done
+#define EVENT_MATRIX_SRC_FAST_INTR(fic) (8 + (fic))
+// Interrupt of the always-on rv_timer 0 (the system timer)
+#define EVENT_MATRIX_SRC_TIMER_0_INTR 23
+// DMA trigger slot, e.g. EVENT_MATRIX_SRC_DMA_SLOT(0) for the SPI RX valid (DMA_SPI_RX_SLOT)
+#define EVENT_MATRIX_SRC_DMA_SLOT(slot) (24 + (slot))
+// Prescaler tick of the always-on rv_timer hart 0 or 1
+#define EVENT_MATRIX_SRC_TIMER_TICK(hart) (32 + (hart))
+
+#define EVENT_MATRIX_NUM_SOURCES 64
+#define EVENT_MATRIX_NUM_TIMERS 2
+#define EVENT_MATRIX_NUM_GPIOS 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initialization parameters for the event matrix.
+ */
+typedef struct event_matrix {
+  /**
+   * The base address for the event matrix hardware registers.
+   */
+  mmio_region_t base_addr;
+} event_matrix_t;
+
+/**
+ * Edge of the source firing the channel.
+ */
+typedef enum event_matrix_edge {
+  kEventMatrixEdgeNone    = 0, /*!< Fired by event_matrix_trigger only. */
+  kEventMatrixEdgeRising  = 1,
+  kEventMatrixEdgeFalling = 2,
+  kEventMatrixEdgeBoth    = 3,
+} event_matrix_edge_t;
+
+/**
+ * Action of the channel.
+ */
+typedef enum event_matrix_action {
+  kEventMatrixDmaStart   = 0, /*!< Start the DMA, see event_matrix_set_dma_size. */
+  kEventMatrixTimerStart = 1, /*!< Run the gated timer hart (target). */
+  kEventMatrixTimerStop  = 2, /*!< Stop the gated timer hart (target). */
+  kEventMatrixGpioToggle = 3, /*!< Toggle the selected GPIO pin (target). */
+  kEventMatrixGpioSet    = 4, /*!< Drive the selected GPIO pin (target) high. */
+  kEventMatrixGpioClear  = 5, /*!< Drive the selected GPIO pin (target) low. */
+} event_matrix_action_t;
+
+/**
+ * Connect a source to an action. The timer actions only act on the harts
+ * gated with event_matrix_set_timer_gate, the GPIO actions only on the pins
+ * selected with event_matrix_set_gpio. When several channels fire at once,
+ * stop and clear win over start and set.
+ * @param em Event matrix.
+ * @param channel Channel, below the number of channels of the configuration.
+ * @param source Source event, one of EVENT_MATRIX_SRC_*.
+ * @param edge Edge of the source firing the channel.
+ * @param action Action of the channel.
+ * @param target Timer hart or GPIO pin of the action, unused by the DMA start.
+ * @return false if the channel, the source or the target does not exist.
+ */
+bool event_matrix_connect(const event_matrix_t *em, uint32_t channel, uint32_t source,
+                          event_matrix_edge_t edge, event_matrix_action_t action,
+                          uint32_t target);
+
+/**
+ * Disconnect the channel from its source, it can still be fired by
+ * event_matrix_trigger (as a DMA start).
+ * @param em Event matrix.
+ * @param channel Channel.
+ */
+void event_matrix_disconnect(const event_matrix_t *em, uint32_t channel);
+
+/**
+ * Fire the channel from software, whatever its source.
+ * @param em Event matrix.
+ * @param channel Channel.
+ */
+void event_matrix_trigger(const event_matrix_t *em, uint32_t channel);
+
+/**
+ * @param em Event matrix.
+ * @param channel Channel.
+ * @return true if the channel fired since it was last cleared.
+ */
+bool event_matrix_fired(const event_matrix_t *em, uint32_t channel);
+
+/**
+ * Clear the fired flag of the channel.
+ * @param em Event matrix.
+ * @param channel Channel.
+ */
+void event_matrix_clear_fired(const event_matrix_t *em, uint32_t channel);
+
+/**
+ * Size of the transfers started by the DMA start action. The transfer is the
+ * one programmed with dma.h (pointers, increments, data types, slots) but not
+ * started (no dma_set_cnt_start), each start reloads the same pointers. The
+ * starts are ignored unless enabled in the DMA with dma_set_ext_start, and
+ * while the DMA is busy. The DMA must not be used through dma_async
+ * meanwhile.
+ * @param em Event matrix.
+ * @param size Size in bytes, 0 to ignore the DMA start actions.
+ */
+void event_matrix_set_dma_size(const event_matrix_t *em, uint32_t size);
+
+/**
+ * Gate a hart of the always-on rv_timer: while gated, it counts only when its
+ * counter is enabled (rv_timer_counter_set_enabled) and it is running, that is
+ * between a timer start and a timer stop action.
+ * @param em Event matrix.
+ * @param hart Timer hart, 0 or 1.
+ * @param enable Gate the hart.
+ * @param run Initial run state.
+ * @return false if the hart does not exist.
+ */
+bool event_matrix_set_timer_gate(const event_matrix_t *em, uint32_t hart, bool enable, bool run);
+
+/**
+ * @param em Event matrix.
+ * @param hart Timer hart, 0 or 1.
+ * @return true if the gated timer hart is running.
+ */
+bool event_matrix_timer_running(const event_matrix_t *em, uint32_t hart);
+
+/**
+ * Drive an always-on GPIO pin from the event matrix instead of the GPIO
+ * peripheral. The pin must still be an output (gpio_output_set_enabled on the
+ * always-on GPIO).
+ * @param em Event matrix.
+ * @param pin GPIO pin, 0 to 7.
+ * @param enable Select the pin.
+ * @param value Initial value of the pin.
+ * @return false if the pin does not exist.
+ */
+bool event_matrix_set_gpio(const event_matrix_t *em, uint32_t pin, bool enable, bool value);
+
+/**
+ * @param em Event matrix.
+ * @param pin GPIO pin, 0 to 7.
+ * @return Value driven on the selected pin.
+ */
+bool event_matrix_get_gpio(const event_matrix_t *em, uint32_t pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_EVENT_MATRIX_H_
@@ -34,6 +34,7 @@
 #include "core_v_mini_mcu.h"
 #include "fast_intr_ctrl_regs.h"  // Generated.
 #include "fast_intr_ctrl_structs.h"
+#include "handler.h"
 
 /****************************************************************************/
 /**                                                                        **/
@@ -41,26 +42,6 @@
 /**                                                                        **/
 /****************************************************************************/
 
-/**
- * The RISC-V interrupt vector will not include the addresses of the handlers,
- * instead, it includes (uncompressed) instructions. Thus the interrupt vector
- * will include `j <interrupt handler name>` for each handler.
- * 
- * The only requirement on the symbol in the jump is that it must be correctly
- * aligned. If the processor supports the C extension, this can be 2-byte
- * aligned, but 4-byte aligned is compatible with all RISC-V processors.
- * 
- * If the processor is not using interrupt vectoring, then there will be a
- * single address where interrupts jump to, which will either contain a function
- * (which will need to be aligned), or will contain a jump to a function, again
- * which will need to be aligned.
- * 
- * You only need to use this ABI for handlers that are the first function called
- * in an interrupt handler. Subsequent functions can just use the regular RISC-V
- * calling convention.
- */
-#define INTERRUPT_HANDLER_ABI __attribute__((aligned(4), interrupt))
-
 /****************************************************************************/
 /**                                                                        **/
 /*                        TYPEDEFS AND STRUCTURES                           */
@@ -251,16 +232,31 @@ __attribute__((weak, optimize("O0"))) void fic_irq_dma(void)
     /* Users should implement their non-weak version */
 }
 
+__attribute__((weak, optimize("O0"))) void fic_driver_irq_dma(void)
+{
+    /* Overridden by the driver servicing the interrupt, if linked */
+}
+
 __attribute__((weak, optimize("O0"))) void fic_irq_spi(void)
 {
     /* Users should implement their non-weak version */
 }
 
+__attribute__((weak, optimize("O0"))) void fic_driver_irq_spi(void)
+{
+    /* Overridden by the driver servicing the interrupt, if linked */
+}
+
 __attribute__((weak, optimize("O0"))) void fic_irq_spi_flash(void)
 {
     /* Users should implement their non-weak version */
 }
 
+__attribute__((weak, optimize("O0"))) void fic_driver_irq_spi_flash(void)
+{
+    /* Overridden by the driver servicing the interrupt, if linked */
+}
+
 __attribute__((weak, optimize("O0"))) void fic_irq_gpio_0(void)
 {
     /* Users should implement their non-weak version */
@@ -335,6 +331,8 @@ void handler_irq_fast_dma(void)
 {
     // The interrupt is cleared.
     clear_fast_interrupt(kDma_fic_e);
+    // call the driver hook, e.g. to launch the next queued DMA job
+    fic_driver_irq_dma();
     // call the weak fic handler
     fic_irq_dma();
 }
@@ -343,6 +341,8 @@ void handler_irq_fast_spi(void)
 {
     // The interrupt is cleared.
     clear_fast_interrupt(kSpi_fic_e);
+    // call the driver hook, e.g. to run the queued SPI transactions
+    fic_driver_irq_spi();
     // call the weak fic handler
     fic_irq_spi();
 }
@@ -351,6 +351,8 @@ void handler_irq_fast_spi_flash(void)
 {
     // The interrupt is cleared.
     clear_fast_interrupt(kSpiFlash_fic_e);
+    // call the driver hook, e.g. to run the queued SPI transactions
+    fic_driver_irq_spi_flash();
     // call the weak fic handler
     fic_irq_spi_flash();
 }
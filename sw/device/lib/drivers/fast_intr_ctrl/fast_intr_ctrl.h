@@ -156,6 +156,14 @@ void fic_irq_timer_3(void);
  */
 void fic_irq_dma(void);
 
+/**
+ * @brief driver hook of the dma fast interrupt, called before fic_irq_dma.
+ * `fast_intr_ctrl.c` provides an empty weak definition of this symbol, which
+ * is overridden by the driver servicing the interrupt (dma_async), so the
+ * application handler stays free for the user.
+ */
+void fic_driver_irq_dma(void);
+
 /**
  * @brief fast interrupt controller irq for spi
  * `fast_intr_ctrl.c` provides a weak definition of this symbol, which can 
@@ -164,6 +172,13 @@ void fic_irq_dma(void);
  */
 void fic_irq_spi(void);
 
+/**
+ * @brief driver hook of the spi fast interrupt, called before fic_irq_spi.
+ * `fast_intr_ctrl.c` provides an empty weak definition of this symbol, which
+ * is overridden by the driver servicing the interrupt (spi_async).
+ */
+void fic_driver_irq_spi(void);
+
 /**
  * @brief fast interrupt controller irq for spi flash
  * `fast_intr_ctrl.c` provides a weak definition of this symbol, which can 
@@ -172,6 +187,13 @@ void fic_irq_spi(void);
  */
 void fic_irq_spi_flash(void);
 
+/**
+ * @brief driver hook of the spi flash fast interrupt, called before fic_irq_spi_flash.
+ * `fast_intr_ctrl.c` provides an empty weak definition of this symbol, which
+ * is overridden by the driver servicing the interrupt (spi_async).
+ */
+void fic_driver_irq_spi_flash(void);
+
 /**
  * @brief fast interrupt controller irq for gpio 0 
  * `fast_intr_ctrl.c` provides a weak definition of this symbol, which can 
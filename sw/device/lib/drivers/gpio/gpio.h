@@ -261,9 +261,9 @@ gpio_result_t gpio_write(const gpio_t *gpio, gpio_pin_t pin,
  * @param state Output modes of the pins.
  * @return The result of the operation.
  */
-gpio_result_t gpio_input_set_enabled(const gpio_t *gpio,
+gpio_result_t gpio_output_set_enabled(const gpio_t *gpio,
                                                   gpio_pin_t pin,
-                                                  gpio_state_t state);
+                                                  gpio_toggle_t state);
 /**
  * Enable sampling on GPIO
  * *
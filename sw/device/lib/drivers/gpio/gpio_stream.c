@@ -0,0 +1,82 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gpio_stream.h"
+
+#include "core_v_mini_mcu.h"
+#include "dma.h"
+#include "rv_timer.h"
+#include "gpio_regs.h"  // Generated.
+
+// Largest tick period of the rv_timer, in clock cycles (12-bit prescaler)
+#define GPIO_STREAM_MAX_PERIOD 4096
+
+// Hart 1 of the always-on rv_timer only, hart 0 is left untouched
+static const rv_timer_t gpio_stream_timer = {
+  .base_addr = {.base = (void *)RV_TIMER_AO_START_ADDRESS},
+  .config = {.hart_count = 2, .comparator_count = 1},
+};
+
+// No DMA job for 0 samples, nor for a size in bytes which does not fit
+static inline bool gpio_stream_valid_size(uint32_t num_samples) {
+  return num_samples != 0 && num_samples <= UINT32_MAX / sizeof(uint32_t);
+}
+
+bool gpio_stream_clock_start(uint32_t clk_freq_hz, uint32_t sample_freq_hz) {
+  if (sample_freq_hz == 0) {
+    return false;
+  }
+  uint32_t period = clk_freq_hz / sample_freq_hz;
+  if (period == 0 || period > GPIO_STREAM_MAX_PERIOD) {
+    return false;
+  }
+
+  // The tick parameters can only be changed with the counter stopped
+  rv_timer_counter_set_enabled(&gpio_stream_timer, GPIO_STREAM_TIMER_HART, kRvTimerDisabled);
+  rv_timer_set_tick_params(&gpio_stream_timer, GPIO_STREAM_TIMER_HART,
+                           (rv_timer_tick_params_t){.prescale = period - 1, .tick_step = 1});
+  rv_timer_counter_set_enabled(&gpio_stream_timer, GPIO_STREAM_TIMER_HART, kRvTimerEnabled);
+  return true;
+}
+
+void gpio_stream_clock_stop(void) {
+  rv_timer_counter_set_enabled(&gpio_stream_timer, GPIO_STREAM_TIMER_HART, kRvTimerDisabled);
+}
+
+dma_job_id_t gpio_stream_play(const gpio_t *gpio, const uint32_t *samples,
+                              uint32_t num_samples, dma_callback_t cb, void *ctx) {
+  if (!gpio_stream_valid_size(num_samples)) {
+    return DMA_ASYNC_INVALID_JOB;
+  }
+  dma_job_t job = {
+    .src = (uint32_t)samples,
+    .dst = (uint32_t)gpio->params.base_addr.base + GPIO_GPIO_OUT_REG_OFFSET,
+    .size = num_samples * sizeof(uint32_t),
+    .src_inc = 4,
+    .dst_inc = 0,
+    // The samples are read ahead, each write waits for a tick
+    .tx_slot_mask = DMA_TIMER_TX_SLOT,
+  };
+  return dma_submit(&job, cb, ctx);
+}
+
+dma_job_id_t gpio_stream_capture(const gpio_t *gpio, uint32_t *samples,
+                                 uint32_t num_samples, dma_callback_t cb, void *ctx) {
+  if (!gpio_stream_valid_size(num_samples)) {
+    return DMA_ASYNC_INVALID_JOB;
+  }
+  dma_job_t job = {
+    .src = (uint32_t)gpio->params.base_addr.base + GPIO_GPIO_IN_REG_OFFSET,
+    .dst = (uint32_t)samples,
+    .size = num_samples * sizeof(uint32_t),
+    .src_inc = 0,
+    .dst_inc = 4,
+    // Each read waits for a tick, the samples are written as they come
+    .rx_slot_mask = DMA_TIMER_RX_SLOT,
+  };
+  return dma_submit(&job, cb, ctx);
+}
@@ -0,0 +1,74 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Timed GPIO pattern generation and capture through the DMA
+
+#ifndef _DRIVERS_GPIO_STREAM_H_
+#define _DRIVERS_GPIO_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio.h"
+#include "dma_async.h"
+
+/**
+ * Hart of the always-on rv_timer whose tick paces the DMA
+ * (DMA_TIMER_RX_SLOT and DMA_TIMER_TX_SLOT).
+ */
+#define GPIO_STREAM_TIMER_HART 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start the sample clock: the always-on rv_timer 1 ticks every
+ * clk_freq_hz / sample_freq_hz cycles, at most 4096 (12-bit prescaler).
+ * Its counter is used as the sample clock only, mtime of hart 1 is not kept.
+ * @param clk_freq_hz System clock frequency.
+ * @param sample_freq_hz Samples per second.
+ * @return false if the period is not between 1 and 4096 cycles.
+ */
+bool gpio_stream_clock_start(uint32_t clk_freq_hz, uint32_t sample_freq_hz);
+
+/**
+ * Stop the sample clock, the DMA jobs waiting for it stall.
+ */
+void gpio_stream_clock_stop(void);
+
+/**
+ * Write the samples to the output register of the GPIO, one per tick of the
+ * sample clock. The pins driven must be outputs (gpio_output_set_enabled),
+ * each sample gives the value of all the pins.
+ * @param gpio GPIO, e.g. at GPIO_START_ADDRESS or GPIO_AO_START_ADDRESS.
+ * @param samples Samples played, kept until the callback.
+ * @param num_samples Number of samples.
+ * @param cb Completion callback, from the DMA interrupt, can be NULL.
+ * @param ctx Argument given to the callback.
+ * @return The DMA job identifier (see dma_wait), DMA_ASYNC_INVALID_JOB if
+ * num_samples is 0 (the callback is not called) or the job cannot be queued.
+ */
+dma_job_id_t gpio_stream_play(const gpio_t *gpio, const uint32_t *samples,
+                              uint32_t num_samples, dma_callback_t cb, void *ctx);
+
+/**
+ * Read the input register of the GPIO into the samples, one per tick of the
+ * sample clock. The pins sampled must be enabled (gpio_input_enabled).
+ * @param gpio GPIO, e.g. at GPIO_START_ADDRESS or GPIO_AO_START_ADDRESS.
+ * @param samples Samples captured, valid once the job is done.
+ * @param num_samples Number of samples.
+ * @param cb Completion callback, from the DMA interrupt, can be NULL.
+ * @param ctx Argument given to the callback.
+ * @return The DMA job identifier (see dma_wait), DMA_ASYNC_INVALID_JOB if
+ * num_samples is 0 (the callback is not called) or the job cannot be queued.
+ */
+dma_job_id_t gpio_stream_capture(const gpio_t *gpio, uint32_t *samples,
+                                 uint32_t num_samples, dma_callback_t cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_GPIO_STREAM_H_
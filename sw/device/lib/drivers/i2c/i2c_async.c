@@ -0,0 +1,390 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "i2c_async.h"
+
+#include "bitfield.h"
+#include "mmio.h"
+#include "csr.h"
+#include "hart.h"
+#include "rv_plic.h"
+#include "core_v_mini_mcu.h"
+
+#include "i2c_regs.h"  // Generated.
+
+// Depth of the FMT FIFO of the I2C host
+#define I2C_ASYNC_FMT_DEPTH 32
+// Maximum number of bytes of one read command, 0 encodes 256
+#define I2C_ASYNC_READ_MAX 256
+// mie.MEIE
+#define I2C_ASYNC_MIE_MEIE (1 << 11)
+// mstatus.MIE
+#define I2C_ASYNC_MSTATUS_MIE (1 << 3)
+
+// Interrupts serviced by the driver, also its PLIC sources from
+// INTR_FMT_WATERMARK to INTR_TRANS_COMPLETE
+#define I2C_ASYNC_ERRORS                                                     \
+  ((1 << I2C_INTR_STATE_FMT_OVERFLOW_BIT) |                                  \
+   (1 << I2C_INTR_STATE_RX_OVERFLOW_BIT) | (1 << I2C_INTR_STATE_NAK_BIT) |   \
+   (1 << I2C_INTR_STATE_SCL_INTERFERENCE_BIT) |                              \
+   (1 << I2C_INTR_STATE_SDA_INTERFERENCE_BIT) |                              \
+   (1 << I2C_INTR_STATE_STRETCH_TIMEOUT_BIT) |                               \
+   (1 << I2C_INTR_STATE_SDA_UNSTABLE_BIT))
+#define I2C_ASYNC_INTRS                                                      \
+  (I2C_ASYNC_ERRORS | (1 << I2C_INTR_STATE_FMT_WATERMARK_BIT) |              \
+   (1 << I2C_INTR_STATE_RX_WATERMARK_BIT) |                                  \
+   (1 << I2C_INTR_STATE_TRANS_COMPLETE_BIT))
+
+// FMT entries of a transaction, generated one at a time
+enum {
+  kI2cAsyncWriteAddr = 0,
+  kI2cAsyncWriteData,
+  kI2cAsyncReadAddr,
+  kI2cAsyncReadCmd,
+  kI2cAsyncFmtDone,
+};
+
+static i2c_async_t *i2c_async_queue;
+
+static inline uint32_t i2c_async_lock(void) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_CLEAR_BITS(CSR_REG_MSTATUS, I2C_ASYNC_MSTATUS_MIE);
+  return mstatus;
+}
+
+static inline void i2c_async_unlock(uint32_t mstatus) {
+  if (mstatus & I2C_ASYNC_MSTATUS_MIE) {
+    CSR_SET_BITS(CSR_REG_MSTATUS, I2C_ASYNC_MSTATUS_MIE);
+  }
+}
+
+static inline uint32_t i2c_async_fifo_status(const i2c_async_t *q) {
+  return mmio_region_read32(q->i2c.params.base_addr, I2C_FIFO_STATUS_REG_OFFSET);
+}
+
+static inline void i2c_async_push(const i2c_async_t *q, uint8_t byte,
+                                  bool start, bool stop, bool read, bool rcont) {
+  uint32_t reg = bitfield_field32_write(0, I2C_FDATA_FBYTE_FIELD, byte);
+  reg = bitfield_bit32_write(reg, I2C_FDATA_START_BIT, start);
+  reg = bitfield_bit32_write(reg, I2C_FDATA_STOP_BIT, stop);
+  reg = bitfield_bit32_write(reg, I2C_FDATA_READ_BIT, read);
+  reg = bitfield_bit32_write(reg, I2C_FDATA_RCONT_BIT, rcont);
+  mmio_region_write32(q->i2c.params.base_addr, I2C_FDATA_REG_OFFSET, reg);
+}
+
+// Push the next FMT entry of the transaction, false once they are all pushed.
+static bool i2c_async_next_fmt(i2c_async_t *q, const i2c_transaction_t *t) {
+  uint32_t write_len = t->reg_len + t->tx_len;
+
+  switch (q->phase) {
+    case kI2cAsyncWriteAddr:
+      q->fmt_pos = 0;
+      if (write_len == 0) {
+        q->phase = kI2cAsyncReadAddr;
+        return i2c_async_next_fmt(q, t);
+      }
+      i2c_async_push(q, t->addr << 1, true, false, false, false);
+      q->phase = kI2cAsyncWriteData;
+      return true;
+
+    case kI2cAsyncWriteData: {
+      uint8_t byte = q->fmt_pos < t->reg_len ? t->reg[q->fmt_pos]
+                                             : t->tx[q->fmt_pos - t->reg_len];
+      q->fmt_pos++;
+      bool last = q->fmt_pos == write_len;
+      i2c_async_push(q, byte, false, last && t->rx_len == 0, false, false);
+      if (last) {
+        q->phase = kI2cAsyncReadAddr;
+      }
+      return true;
+    }
+
+    case kI2cAsyncReadAddr:
+      q->fmt_pos = 0;
+      if (t->rx_len == 0) {
+        q->phase = kI2cAsyncFmtDone;
+        return false;
+      }
+      // Repeated START after the write
+      i2c_async_push(q, (t->addr << 1) | 1, true, false, false, false);
+      q->phase = kI2cAsyncReadCmd;
+      return true;
+
+    case kI2cAsyncReadCmd: {
+      uint32_t len = t->rx_len - q->fmt_pos;
+      if (len > I2C_ASYNC_READ_MAX) {
+        len = I2C_ASYNC_READ_MAX;
+      }
+      q->fmt_pos += len;
+      bool last = q->fmt_pos == t->rx_len;
+      // The last byte is NAKed by the host, the others are ACKed
+      i2c_async_push(q, len & 0xFF, false, last, true, !last);
+      if (last) {
+        q->phase = kI2cAsyncFmtDone;
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+static void i2c_async_fill_fmt(i2c_async_t *q, const i2c_transaction_t *t) {
+  uint32_t level = bitfield_field32_read(i2c_async_fifo_status(q), I2C_FIFO_STATUS_FMTLVL_FIELD);
+  while (level < I2C_ASYNC_FMT_DEPTH && i2c_async_next_fmt(q, t)) {
+    level++;
+  }
+}
+
+// Watermark level for the bytes left to read, the largest one not above them.
+static uint32_t i2c_async_rx_level(uint32_t left) {
+  if (left >= 30) {
+    return I2C_FIFO_CTRL_RXILVL_VALUE_RXLVL30;
+  } else if (left >= 16) {
+    return I2C_FIFO_CTRL_RXILVL_VALUE_RXLVL16;
+  } else if (left >= 8) {
+    return I2C_FIFO_CTRL_RXILVL_VALUE_RXLVL8;
+  } else if (left >= 4) {
+    return I2C_FIFO_CTRL_RXILVL_VALUE_RXLVL4;
+  }
+  return I2C_FIFO_CTRL_RXILVL_VALUE_RXLVL1;
+}
+
+static void i2c_async_drain_rx(i2c_async_t *q, const i2c_transaction_t *t) {
+  uint32_t level = bitfield_field32_read(i2c_async_fifo_status(q), I2C_FIFO_STATUS_RXLVL_FIELD);
+  while (level != 0 && q->rx_pos < t->rx_len) {
+    t->rx[q->rx_pos++] = mmio_region_read32(q->i2c.params.base_addr, I2C_RDATA_REG_OFFSET);
+    level--;
+  }
+
+  if (q->rx_pos < t->rx_len) {
+    // Changing the level raises the watermark if the FIFO is already above it
+    uint32_t reg = mmio_region_read32(q->i2c.params.base_addr, I2C_FIFO_CTRL_REG_OFFSET);
+    reg = bitfield_bit32_write(reg, I2C_FIFO_CTRL_RXRST_BIT, false);
+    reg = bitfield_bit32_write(reg, I2C_FIFO_CTRL_FMTRST_BIT, false);
+    reg = bitfield_field32_write(reg, I2C_FIFO_CTRL_RXILVL_FIELD,
+                                 i2c_async_rx_level(t->rx_len - q->rx_pos));
+    mmio_region_write32(q->i2c.params.base_addr, I2C_FIFO_CTRL_REG_OFFSET, reg);
+  }
+}
+
+static void i2c_async_complete(i2c_async_t *q, i2c_async_status_t status) {
+  i2c_transaction_t *t = q->queue[q->head];
+
+  q->head = (q->head + 1) % I2C_ASYNC_QUEUE_SIZE;
+  q->count--;
+  q->phase = kI2cAsyncWriteAddr;
+  q->rx_pos = 0;
+  q->stop_seen = false;
+
+  t->status = status;
+  if (t->cb != NULL) {
+    t->cb(t);
+  }
+}
+
+// Drop what is left of the failed transaction and release the bus with an
+// address only transfer, the next transaction waits for its STOP.
+static void i2c_async_abort(i2c_async_t *q, i2c_async_status_t status) {
+  uint8_t addr = q->queue[q->head]->addr;
+
+  i2c_reset_fmt_fifo(&q->i2c);
+  i2c_reset_rx_fifo(&q->i2c);
+  uint32_t reg = bitfield_field32_write(0, I2C_FDATA_FBYTE_FIELD, addr << 1);
+  reg = bitfield_bit32_write(reg, I2C_FDATA_START_BIT, true);
+  reg = bitfield_bit32_write(reg, I2C_FDATA_STOP_BIT, true);
+  reg = bitfield_bit32_write(reg, I2C_FDATA_NAKOK_BIT, true);
+  mmio_region_write32(q->i2c.params.base_addr, I2C_FDATA_REG_OFFSET, reg);
+  q->recovering = true;
+
+  i2c_async_complete(q, status);
+}
+
+static i2c_async_status_t i2c_async_error(uint32_t state) {
+  if (bitfield_bit32_read(state, I2C_INTR_STATE_NAK_BIT)) {
+    return kI2cAsyncNak;
+  } else if (bitfield_bit32_read(state, I2C_INTR_STATE_STRETCH_TIMEOUT_BIT)) {
+    return kI2cAsyncTimeout;
+  }
+  return kI2cAsyncBusError;
+}
+
+// Must be called with interrupts disabled.
+static void i2c_async_service(i2c_async_t *q) {
+  uint32_t state = mmio_region_read32(q->i2c.params.base_addr, I2C_INTR_STATE_REG_OFFSET);
+  mmio_region_write32(q->i2c.params.base_addr, I2C_INTR_STATE_REG_OFFSET, state & I2C_ASYNC_INTRS);
+  bool stop = bitfield_bit32_read(state, I2C_INTR_STATE_TRANS_COMPLETE_BIT);
+
+  if (q->recovering) {
+    if (!stop) {
+      return;
+    }
+    q->recovering = false;
+    stop = false;
+  }
+
+  while (q->count != 0) {
+    i2c_transaction_t *t = q->queue[q->head];
+
+    if (state & I2C_ASYNC_ERRORS) {
+      i2c_async_abort(q, i2c_async_error(state));
+      return;
+    }
+
+    i2c_async_fill_fmt(q, t);
+    i2c_async_drain_rx(q, t);
+
+    if (q->phase != kI2cAsyncFmtDone || q->rx_pos < t->rx_len) {
+      return;
+    }
+    // Done once the last entry left the FMT FIFO and the STOP was sent
+    uint32_t status = mmio_region_read32(q->i2c.params.base_addr, I2C_STATUS_REG_OFFSET);
+    q->stop_seen |= stop && bitfield_bit32_read(status, I2C_STATUS_FMTEMPTY_BIT);
+    if (!q->stop_seen) {
+      return;
+    }
+    i2c_async_complete(q, kI2cAsyncOk);
+    state = 0;
+    stop = false;
+  }
+}
+
+void i2c_async_init(i2c_async_t *q, const i2c_t *i2c, uint32_t stretch_timeout) {
+  uint32_t mstatus = i2c_async_lock();
+  q->i2c = *i2c;
+  q->head = 0;
+  q->count = 0;
+  q->phase = kI2cAsyncWriteAddr;
+  q->rx_pos = 0;
+  q->stop_seen = false;
+  q->recovering = false;
+  i2c_async_queue = q;
+
+  uint32_t reg = bitfield_field32_write(0, I2C_TIMEOUT_CTRL_VAL_FIELD, stretch_timeout);
+  reg = bitfield_bit32_write(reg, I2C_TIMEOUT_CTRL_EN_BIT, stretch_timeout != 0);
+  mmio_region_write32(i2c->params.base_addr, I2C_TIMEOUT_CTRL_REG_OFFSET, reg);
+
+  i2c_reset_fmt_fifo(i2c);
+  i2c_reset_rx_fifo(i2c);
+  i2c_set_watermarks(i2c, kDifI2cLevel1Byte, kDifI2cLevel8Byte);
+  mmio_region_write32(i2c->params.base_addr, I2C_INTR_STATE_REG_OFFSET, I2C_ASYNC_INTRS);
+  mmio_region_write32(i2c->params.base_addr, I2C_INTR_ENABLE_REG_OFFSET, I2C_ASYNC_INTRS);
+
+  for (uint32_t id = INTR_FMT_WATERMARK; id <= INTR_TRANS_COMPLETE; id++) {
+    plic_irq_set_priority(id, 1);
+    plic_irq_set_enabled(id, kPlicToggleEnabled);
+  }
+  CSR_SET_BITS(CSR_REG_MIE, I2C_ASYNC_MIE_MEIE);
+  i2c_async_unlock(mstatus);
+}
+
+bool i2c_async_submit(i2c_async_t *q, i2c_transaction_t *transaction) {
+  if (transaction->reg_len + transaction->tx_len + transaction->rx_len == 0) {
+    return false;
+  }
+
+  uint32_t mstatus = i2c_async_lock();
+  if (q->count == I2C_ASYNC_QUEUE_SIZE) {
+    i2c_async_unlock(mstatus);
+    return false;
+  }
+  transaction->status = kI2cAsyncPending;
+  q->queue[(q->head + q->count) % I2C_ASYNC_QUEUE_SIZE] = transaction;
+  q->count++;
+  // Starts it right away if the queue was empty
+  if (q->count == 1) {
+    i2c_async_service(q);
+  }
+  i2c_async_unlock(mstatus);
+  return true;
+}
+
+i2c_async_status_t i2c_async_wait(i2c_async_t *q, i2c_transaction_t *transaction) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+
+  while (transaction->status == kI2cAsyncPending) {
+    // Check again with interrupts disabled so the completion cannot be missed,
+    // wfi still wakes up on a pending interrupt.
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, I2C_ASYNC_MSTATUS_MIE);
+    if (transaction->status == kI2cAsyncPending) {
+      wait_for_interrupt();
+    }
+    CSR_SET_BITS(CSR_REG_MSTATUS, I2C_ASYNC_MSTATUS_MIE);
+  }
+
+  // Interrupts are needed to make progress, restore the caller state
+  if ((mstatus & I2C_ASYNC_MSTATUS_MIE) == 0) {
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, I2C_ASYNC_MSTATUS_MIE);
+  }
+  return transaction->status;
+}
+
+bool i2c_async_write_read(i2c_async_t *q, i2c_transaction_t *transaction,
+                          uint8_t addr, const uint8_t *tx, uint32_t tx_len,
+                          uint8_t *rx, uint32_t rx_len) {
+  transaction->addr = addr;
+  transaction->reg_len = 0;
+  transaction->tx = tx;
+  transaction->tx_len = tx_len;
+  transaction->rx = rx;
+  transaction->rx_len = rx_len;
+  return i2c_async_submit(q, transaction);
+}
+
+bool i2c_async_write(i2c_async_t *q, i2c_transaction_t *transaction,
+                     uint8_t addr, const uint8_t *data, uint32_t len) {
+  return i2c_async_write_read(q, transaction, addr, data, len, NULL, 0);
+}
+
+bool i2c_async_read(i2c_async_t *q, i2c_transaction_t *transaction,
+                    uint8_t addr, uint8_t *data, uint32_t len) {
+  return i2c_async_write_read(q, transaction, addr, NULL, 0, data, len);
+}
+
+bool i2c_async_reg_write(i2c_async_t *q, i2c_transaction_t *transaction,
+                         uint8_t addr, uint8_t reg, const uint8_t *data,
+                         uint32_t len) {
+  transaction->addr = addr;
+  transaction->reg_len = 1;
+  transaction->reg[0] = reg;
+  transaction->tx = data;
+  transaction->tx_len = len;
+  transaction->rx = NULL;
+  transaction->rx_len = 0;
+  return i2c_async_submit(q, transaction);
+}
+
+bool i2c_async_reg_read(i2c_async_t *q, i2c_transaction_t *transaction,
+                        uint8_t addr, uint8_t reg, uint8_t *data, uint32_t len) {
+  if (len == 0) {
+    return false;
+  }
+  transaction->addr = addr;
+  transaction->reg_len = 1;
+  transaction->reg[0] = reg;
+  transaction->tx = NULL;
+  transaction->tx_len = 0;
+  transaction->rx = data;
+  transaction->rx_len = len;
+  return i2c_async_submit(q, transaction);
+}
+
+void i2c_async_irq_handler(void) {
+  if (i2c_async_queue == NULL) {
+    // The I2C host is used directly, not through the queue
+    return;
+  }
+  i2c_async_service(i2c_async_queue);
+}
+
+// Serviced from the PLIC interrupt of the I2C host, before the user handler_irq_i2c
+void plic_driver_irq_i2c(void) {
+  i2c_async_irq_handler();
+}
@@ -0,0 +1,199 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Queued I2C host transactions, run from the I2C interrupts of the PLIC
+
+#ifndef _DRIVERS_I2C_ASYNC_H_
+#define _DRIVERS_I2C_ASYNC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+/**
+ * Number of transactions that can be waiting in the queue, including the one
+ * running. Can be overriden at compile time.
+ */
+#ifndef I2C_ASYNC_QUEUE_SIZE
+#define I2C_ASYNC_QUEUE_SIZE 8
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Status of a transaction.
+ */
+typedef enum i2c_async_status {
+  /**
+   * Submitted, not done yet.
+   */
+  kI2cAsyncPending = 0,
+  /**
+   * All the bytes were sent and received.
+   */
+  kI2cAsyncOk,
+  /**
+   * The target did not acknowledge its address or a byte written.
+   */
+  kI2cAsyncNak,
+  /**
+   * The target stretched the clock for longer than the timeout given to
+   * i2c_async_init.
+   */
+  kI2cAsyncTimeout,
+  /**
+   * Interference or unstable lines on SCL or SDA, or a FIFO overflow.
+   */
+  kI2cAsyncBusError,
+} i2c_async_status_t;
+
+struct i2c_transaction;
+
+/**
+ * Completion callback, called from the interrupt handler once the
+ * transaction is done and before the next one starts.
+ */
+typedef void (*i2c_async_callback_t)(struct i2c_transaction *transaction);
+
+/**
+ * Write then read transaction to a target: START, address, the register
+ * address and tx bytes, then a repeated START, address and rx_len bytes read,
+ * then STOP. Either part can be empty.
+ *
+ * The transaction is owned by the driver from i2c_async_submit to the
+ * callback, it and its buffers must be kept until then.
+ */
+typedef struct i2c_transaction {
+  /**
+   * 7-bit target address.
+   */
+  uint8_t addr;
+  /**
+   * Number of bytes of reg (0, 1 or 2), sent before tx.
+   */
+  uint8_t reg_len;
+  /**
+   * Register address, most significant byte first.
+   */
+  uint8_t reg[2];
+  const uint8_t *tx;
+  uint32_t tx_len;
+  uint8_t *rx;
+  uint32_t rx_len;
+  /**
+   * Completion callback, can be NULL.
+   */
+  i2c_async_callback_t cb;
+  /**
+   * Free for the caller, e.g. to find its context in the callback.
+   */
+  void *ctx;
+  /**
+   * Set by the driver, kI2cAsyncPending until the transaction is done.
+   */
+  volatile i2c_async_status_t status;
+} i2c_transaction_t;
+
+/**
+ * Transaction queue of the I2C host. The fields are private.
+ */
+typedef struct i2c_async {
+  i2c_t i2c;
+  i2c_transaction_t *queue[I2C_ASYNC_QUEUE_SIZE];
+  volatile uint32_t head;
+  volatile uint32_t count;
+  // Progress of the transaction at the head of the queue
+  uint32_t phase;
+  uint32_t fmt_pos;
+  uint32_t rx_pos;
+  bool stop_seen;
+  bool recovering;
+} i2c_async_t;
+
+/**
+ * Initialize the transaction queue of the I2C host and enable its interrupts
+ * in the I2C host and in the PLIC. The I2C host must be configured and enabled
+ * (i2c_configure, i2c_host_set_enabled).
+ * Machine-level interrupts still have to be enabled globally (mstatus.MIE).
+ * @param queue Transaction queue, owned by the driver from now on.
+ * @param i2c I2C host.
+ * @param stretch_timeout Clock cycles a target can stretch SCL for before the
+ * transaction fails with kI2cAsyncTimeout, 0 to wait forever.
+ */
+void i2c_async_init(i2c_async_t *queue, const i2c_t *i2c, uint32_t stretch_timeout);
+
+/**
+ * Submit a transaction. It is started as soon as the transactions submitted
+ * before it are done.
+ * @param queue Transaction queue of the I2C host.
+ * @param transaction Transaction, not copied.
+ * @return false if the queue is full or the transaction is empty.
+ */
+bool i2c_async_submit(i2c_async_t *queue, i2c_transaction_t *transaction);
+
+/**
+ * Wait for a transaction to be done, sleeping with wfi in between interrupts.
+ * @param queue Transaction queue of the I2C host.
+ * @param transaction Transaction given to i2c_async_submit.
+ * @return Status of the transaction.
+ */
+i2c_async_status_t i2c_async_wait(i2c_async_t *queue, i2c_transaction_t *transaction);
+
+/**
+ * Write bytes to a target.
+ * The cb and ctx fields of the transaction are kept, the others are set.
+ * @return false if the queue is full or len is 0.
+ */
+bool i2c_async_write(i2c_async_t *queue, i2c_transaction_t *transaction,
+                     uint8_t addr, const uint8_t *data, uint32_t len);
+
+/**
+ * Burst read of bytes from a target.
+ * The cb and ctx fields of the transaction are kept, the others are set.
+ * @return false if the queue is full or len is 0.
+ */
+bool i2c_async_read(i2c_async_t *queue, i2c_transaction_t *transaction,
+                    uint8_t addr, uint8_t *data, uint32_t len);
+
+/**
+ * Write bytes then read bytes from a target, with a repeated START in between.
+ * The cb and ctx fields of the transaction are kept, the others are set.
+ * @return false if the queue is full or both lengths are 0.
+ */
+bool i2c_async_write_read(i2c_async_t *queue, i2c_transaction_t *transaction,
+                          uint8_t addr, const uint8_t *tx, uint32_t tx_len,
+                          uint8_t *rx, uint32_t rx_len);
+
+/**
+ * Write to consecutive registers of a target with 8-bit register addresses.
+ * The cb and ctx fields of the transaction are kept, the others are set.
+ * @return false if the queue is full.
+ */
+bool i2c_async_reg_write(i2c_async_t *queue, i2c_transaction_t *transaction,
+                         uint8_t addr, uint8_t reg, const uint8_t *data,
+                         uint32_t len);
+
+/**
+ * Read consecutive registers of a target with 8-bit register addresses.
+ * The cb and ctx fields of the transaction are kept, the others are set.
+ * @return false if the queue is full or len is 0.
+ */
+bool i2c_async_reg_read(i2c_async_t *queue, i2c_transaction_t *transaction,
+                        uint8_t addr, uint8_t reg, uint8_t *data, uint32_t len);
+
+/**
+ * Refills the FMT FIFO, drains the RX FIFO and completes the transactions.
+ * Called through the plic_driver_irq_i2c hook of the PLIC interrupt handler,
+ * before handler_irq_i2c.
+ */
+void i2c_async_irq_handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_I2C_ASYNC_H_
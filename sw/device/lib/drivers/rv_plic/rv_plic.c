@@ -142,6 +142,10 @@ __attribute__((weak, optimize("O0"))) void handler_irq_uart(void) {
 
 } 
 
+__attribute__((weak, optimize("O0"))) void plic_driver_irq_uart(void) {
+  /* Overridden by the driver servicing the interrupt, if linked */
+}
+
 __attribute__((weak, optimize("O0"))) void handler_irq_gpio(void) {
   
 }
@@ -150,6 +154,10 @@ __attribute__((weak, optimize("O0"))) void handler_irq_i2c(void) {
   
 }
 
+__attribute__((weak, optimize("O0"))) void plic_driver_irq_i2c(void) {
+  /* Overridden by the driver servicing the interrupt, if linked */
+}
+
 __attribute__((weak, optimize("O0"))) void handler_irq_spi(void) {
   
 }
@@ -171,6 +179,16 @@ void handler_irq_external(void)
 
   if(type != IRQ_BAD)
   {
+    // The driver hooks (UART buffers, I2C transactions) are called first
+    if(type == IRQ_UART_SRC)
+    {
+      plic_driver_irq_uart();
+    }
+    else if(type == IRQ_I2C_SRC)
+    {
+      plic_driver_irq_i2c();
+    }
+
     // Calls the proper handler
     handlers[type]();
     plic_intr_flag = 1;
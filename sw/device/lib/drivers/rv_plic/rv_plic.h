@@ -227,6 +227,14 @@ extern uint8_t plic_intr_flag;
 */
 void handler_irq_uart(void);
 
+/**
+ * Driver hook of the UART interrupts, called before handler_irq_uart.
+ * `rv_plic.c` provides an empty weak definition of this symbol, which is
+ * overridden by the driver servicing the interrupt (the UART TX and RX
+ * buffers of uart.c), so handler_irq_uart stays free for the user.
+*/
+void plic_driver_irq_uart(void);
+
 /**
  * IRQ handler for GPIO 
 */
@@ -237,6 +245,13 @@ void handler_irq_gpio(void);
 */
 void handler_irq_i2c(void);
 
+/**
+ * Driver hook of the I2C interrupts, called before handler_irq_i2c.
+ * `rv_plic.c` provides an empty weak definition of this symbol, which is
+ * overridden by the driver servicing the interrupt (i2c_async).
+*/
+void plic_driver_irq_i2c(void);
+
 /**
  * IRQ handler for SPI 
 */
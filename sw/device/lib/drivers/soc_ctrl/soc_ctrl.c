@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "bitfield.h"
 #include "mmio.h"
 
 #include "soc_ctrl_regs.h"  // Generated.
@@ -35,3 +36,18 @@ void soc_ctrl_select_spi_host(const soc_ctrl_t *soc_ctrl) {
   mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_ENABLE_SPI_SEL_REG_OFFSET), 0x1);
   mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_USE_SPIMEMIO_REG_OFFSET), 0x0);
 }
+
+void soc_ctrl_set_bus_priorities(const soc_ctrl_t *soc_ctrl, const soc_ctrl_bus_priorities_t *priorities) {
+  uint32_t bus_qos = 0;
+  bus_qos = bitfield_field32_write(bus_qos, SOC_CTRL_BUS_QOS_CORE_INSTR_FIELD, priorities->core_instr);
+  bus_qos = bitfield_field32_write(bus_qos, SOC_CTRL_BUS_QOS_CORE_DATA_FIELD, priorities->core_data);
+  bus_qos = bitfield_field32_write(bus_qos, SOC_CTRL_BUS_QOS_DEBUG_FIELD, priorities->debug);
+  bus_qos = bitfield_field32_write(bus_qos, SOC_CTRL_BUS_QOS_DMA_READ_FIELD, priorities->dma_read);
+  bus_qos = bitfield_field32_write(bus_qos, SOC_CTRL_BUS_QOS_DMA_WRITE_FIELD, priorities->dma_write);
+  bus_qos = bitfield_bit32_write(bus_qos, SOC_CTRL_BUS_QOS_OVERRIDE_BIT, true);
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_BUS_QOS_REG_OFFSET), bus_qos);
+}
+
+void soc_ctrl_clear_bus_priorities(const soc_ctrl_t *soc_ctrl) {
+  mmio_region_write32(soc_ctrl->base_addr, (ptrdiff_t)(SOC_CTRL_BUS_QOS_REG_OFFSET), 0x0);
+}
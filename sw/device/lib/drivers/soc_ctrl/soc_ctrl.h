@@ -56,6 +56,32 @@ void soc_ctrl_select_spi_memio(const soc_ctrl_t *soc_ctrl);
  */
 void soc_ctrl_select_spi_host(const soc_ctrl_t *soc_ctrl);
 
+/**
+ * Priorities of the system bus masters, from 0 to 3, a higher priority is
+ * granted first and equal priorities are served round-robin.
+ */
+typedef struct soc_ctrl_bus_priorities {
+  uint8_t core_instr;
+  uint8_t core_data;
+  uint8_t debug;
+  uint8_t dma_read;
+  uint8_t dma_write;
+} soc_ctrl_bus_priorities_t;
+
+/**
+ * Use the given system bus priorities instead of the ones of mcu_cfg.hjson.
+ * The budgets of mcu_cfg.hjson still apply.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ * @param priorities Priorities of the masters.
+ */
+void soc_ctrl_set_bus_priorities(const soc_ctrl_t *soc_ctrl, const soc_ctrl_bus_priorities_t *priorities);
+
+/**
+ * Go back to the system bus priorities of mcu_cfg.hjson.
+ * @param soc_ctrl Pointer to soc_ctrl_t represting the target SOC CTRL.
+ */
+void soc_ctrl_clear_bus_priorities(const soc_ctrl_t *soc_ctrl);
+
 #ifdef __cplusplus
 }
 #endif
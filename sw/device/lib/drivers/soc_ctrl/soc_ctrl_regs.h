@@ -48,6 +48,31 @@ extern "C" {
 // system is running (in Hz)
 #define SOC_CTRL_SYSTEM_FREQUENCY_HZ_REG_OFFSET 0x1c
 
+// Bus QoS - Priorities (0 to 3, higher first) of the system bus masters,
+// used instead of the ones of mcu_cfg.hjson when OVERRIDE is set
+#define SOC_CTRL_BUS_QOS_REG_OFFSET 0x20
+#define SOC_CTRL_BUS_QOS_CORE_INSTR_MASK 0x3
+#define SOC_CTRL_BUS_QOS_CORE_INSTR_OFFSET 0
+#define SOC_CTRL_BUS_QOS_CORE_INSTR_FIELD \
+  ((bitfield_field32_t) { .mask = SOC_CTRL_BUS_QOS_CORE_INSTR_MASK, .index = SOC_CTRL_BUS_QOS_CORE_INSTR_OFFSET })
+#define SOC_CTRL_BUS_QOS_CORE_DATA_MASK 0x3
+#define SOC_CTRL_BUS_QOS_CORE_DATA_OFFSET 2
+#define SOC_CTRL_BUS_QOS_CORE_DATA_FIELD \
+  ((bitfield_field32_t) { .mask = SOC_CTRL_BUS_QOS_CORE_DATA_MASK, .index = SOC_CTRL_BUS_QOS_CORE_DATA_OFFSET })
+#define SOC_CTRL_BUS_QOS_DEBUG_MASK 0x3
+#define SOC_CTRL_BUS_QOS_DEBUG_OFFSET 4
+#define SOC_CTRL_BUS_QOS_DEBUG_FIELD \
+  ((bitfield_field32_t) { .mask = SOC_CTRL_BUS_QOS_DEBUG_MASK, .index = SOC_CTRL_BUS_QOS_DEBUG_OFFSET })
+#define SOC_CTRL_BUS_QOS_DMA_READ_MASK 0x3
+#define SOC_CTRL_BUS_QOS_DMA_READ_OFFSET 6
+#define SOC_CTRL_BUS_QOS_DMA_READ_FIELD \
+  ((bitfield_field32_t) { .mask = SOC_CTRL_BUS_QOS_DMA_READ_MASK, .index = SOC_CTRL_BUS_QOS_DMA_READ_OFFSET })
+#define SOC_CTRL_BUS_QOS_DMA_WRITE_MASK 0x3
+#define SOC_CTRL_BUS_QOS_DMA_WRITE_OFFSET 8
+#define SOC_CTRL_BUS_QOS_DMA_WRITE_FIELD \
+  ((bitfield_field32_t) { .mask = SOC_CTRL_BUS_QOS_DMA_WRITE_MASK, .index = SOC_CTRL_BUS_QOS_DMA_WRITE_OFFSET })
+#define SOC_CTRL_BUS_QOS_OVERRIDE_BIT 16
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,459 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "spi_flash.h"
+
+#include <stddef.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "dma.h"
+#include "fast_intr_ctrl.h"
+#include "hart.h"
+
+// mie bit of the fast interrupts, from their fast_intr_ctrl number
+#define SPI_FLASH_FAST_INTR_MASK(fic) (1 << (16 + (fic)))
+// mstatus.MIE
+#define SPI_FLASH_MSTATUS_MIE (1 << 3)
+// The address bytes are sent to the flash in reverse order
+#define REVERT_24b_ADDR(addr)                                   \
+  ((((uint32_t)(addr)&0xff0000) >> 16) | ((uint32_t)(addr)&0xff00) | \
+   (((uint32_t)(addr)&0xff) << 16))
+
+#define SPI_FLASH_STATUS_POLL_WORDS (SPI_FLASH_STATUS_POLL_BYTES / 4)
+
+static const uint8_t kReadCmd[] = {
+    SPI_FLASH_CMD_READ,
+    SPI_FLASH_CMD_FAST_READ,
+    SPI_FLASH_CMD_DUAL_OUTPUT_READ,
+    SPI_FLASH_CMD_QUAD_OUTPUT_READ,
+};
+
+static const spi_speed_e kReadSpeed[] = {
+    kSpiSpeedStandard,
+    kSpiSpeedStandard,
+    kSpiSpeedDual,
+    kSpiSpeedQuad,
+};
+
+static const uint8_t kEraseCmd[] = {
+    SPI_FLASH_CMD_SECTOR_ERASE,
+    SPI_FLASH_CMD_BLOCK_ERASE_32K,
+    SPI_FLASH_CMD_BLOCK_ERASE_64K,
+    SPI_FLASH_CMD_CHIP_ERASE,
+};
+
+static inline bool spi_flash_on_flash_host(const spi_flash_t *flash) {
+  return (uintptr_t)flash->spi.base_addr.base == SPI_FLASH_START_ADDRESS;
+}
+
+static inline uint32_t spi_flash_fic(const spi_flash_t *flash) {
+  return spi_flash_on_flash_host(flash) ? kSpiFlash_fic_e : kSpi_fic_e;
+}
+
+static inline bool spi_flash_tx_full(const spi_host_t *spi) {
+  return mmio_region_get_bit32(spi->base_addr, SPI_HOST_STATUS_REG_OFFSET,
+                               SPI_HOST_STATUS_TXFULL_BIT);
+}
+
+/**
+ * Queue a command segment, once the command FIFO has room.
+ */
+static void spi_flash_segment(const spi_host_t *spi, uint32_t len, bool csaat,
+                              spi_speed_e speed, spi_dir_e direction) {
+  spi_wait_for_ready(spi);
+  spi_set_command(spi, spi_create_command((spi_command_t){
+                           .len = len - 1,
+                           .csaat = csaat,
+                           .speed = speed,
+                           .direction = direction,
+                       }));
+}
+
+/**
+ * Send up to 4 bytes at standard speed, the first one in the low byte.
+ */
+static void spi_flash_send(const spi_host_t *spi, uint32_t word, uint32_t len,
+                           bool csaat) {
+  spi_write_word(spi, word);
+  spi_flash_segment(spi, len, csaat, kSpiSpeedStandard, kSpiDirTxOnly);
+}
+
+static inline void spi_flash_send_cmd_addr(const spi_host_t *spi, uint8_t cmd,
+                                           uint32_t addr, bool csaat) {
+  spi_flash_send(spi, (REVERT_24b_ADDR(addr) << 8) | cmd, 4, csaat);
+}
+
+/**
+ * Queue the read command, its address, the dummy cycles and the reception of
+ * len bytes.
+ */
+static void spi_flash_send_read(const spi_host_t *spi, uint32_t addr,
+                                uint32_t len, spi_flash_read_mode_t mode) {
+  spi_flash_send_cmd_addr(spi, kReadCmd[mode], addr, true);
+  if (mode != kSpiFlashReadStandard) {
+    spi_flash_segment(spi, SPI_FLASH_READ_DUMMY_CYCLES, true,
+                      kReadSpeed[mode], kSpiDirDummy);
+  }
+  spi_flash_segment(spi, len, false, kReadSpeed[mode], kSpiDirRxOnly);
+}
+
+static void spi_flash_wait_idle(const spi_host_t *spi) {
+  spi_wait_for_ready(spi);
+  while (spi_get_active(spi)) {
+  }
+}
+
+static uint32_t spi_flash_receive_word(const spi_host_t *spi) {
+  uint32_t word;
+  while (spi_get_rx_queue_depth(spi) == 0) {
+  }
+  spi_read_word(spi, &word);
+  return word;
+}
+
+/**
+ * Set up the DMA for a transfer to or from a FIFO of the SPI host, if it can
+ * be borrowed (dma_borrow). Called with the interrupts disabled, the transfer
+ * is waited for and the DMA configuration restored by dma_release.
+ */
+static bool spi_flash_dma_start(const dma_t *dma, dma_borrow_t *saved,
+                                uint32_t src, uint32_t dst, uint32_t src_inc,
+                                uint32_t dst_inc, uint16_t rx_slot,
+                                uint16_t tx_slot, uint32_t size) {
+  if (!dma_borrow(dma, saved)) {
+    return false;
+  }
+  dma_set_read_ptr(dma, src);
+  dma_set_write_ptr(dma, dst);
+  dma_set_read_ptr_inc(dma, src_inc);
+  dma_set_write_ptr_inc(dma, dst_inc);
+  dma_set_slot(dma, rx_slot, tx_slot);
+  dma_set_data_type(dma, 0);
+  dma_set_extend(dma, false, false);
+  dma_set_fill(dma, false, 0);
+  dma_set_cnt_start(dma, size);
+  return true;
+}
+
+static inline uint32_t spi_flash_irq_disable(void) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_CLEAR_BITS(CSR_REG_MSTATUS, SPI_FLASH_MSTATUS_MIE);
+  return mstatus;
+}
+
+static inline void spi_flash_irq_restore(uint32_t mstatus) {
+  if (mstatus & SPI_FLASH_MSTATUS_MIE) {
+    CSR_SET_BITS(CSR_REG_MSTATUS, SPI_FLASH_MSTATUS_MIE);
+  }
+}
+
+static inline bool spi_flash_in_range(const spi_flash_t *flash, uint32_t addr,
+                                      uint32_t len) {
+  return addr < flash->size && len <= flash->size - addr;
+}
+
+spi_flash_result_t spi_flash_init(spi_flash_t *flash, uint32_t core_clk,
+                                  uint32_t max_clk) {
+  const spi_host_t *spi = &flash->spi;
+  spi_flash_jedec_id_t id;
+
+  // SPI_CLK = CORE_CLK/(2 + 2 * CLK_DIV) <= max_clk
+  uint16_t clk_div = 0;
+  if (max_clk < core_clk / 2) {
+    clk_div = (core_clk / max_clk - 2) / 2;
+    if (core_clk / (2 + 2 * clk_div) > max_clk) {
+      clk_div += 1;
+    }
+  }
+
+  spi_set_enable(spi, true);
+  spi_output_enable(spi, true);
+  spi_set_configopts(spi, flash->csid,
+                     spi_create_configopts((spi_configopts_t){
+                         .clkdiv = clk_div,
+                         .csnidle = 0xF,
+                         .csntrail = 0xF,
+                         .csnlead = 0xF,
+                         .fullcyc = false,
+                         .cpha = 0,
+                         .cpol = 0,
+                     }));
+  spi_set_csid(spi, flash->csid);
+
+  spi_flash_send(spi, SPI_FLASH_CMD_CONTINUOUS_READ_RESET * 0x01010101u, 4,
+                 false);
+  spi_flash_send(spi, SPI_FLASH_CMD_POWER_UP, 1, false);
+  spi_flash_wait_idle(spi);
+
+  flash->size = 0;
+  if (spi_flash_read_jedec_id(flash, &id) != kSpiFlashOk) {
+    return kSpiFlashErrorNoDevice;
+  }
+  flash->size = id.capacity < 32 ? 1u << id.capacity : 0;
+  return kSpiFlashOk;
+}
+
+spi_flash_result_t spi_flash_read_jedec_id(const spi_flash_t *flash,
+                                           spi_flash_jedec_id_t *id) {
+  const spi_host_t *spi = &flash->spi;
+
+  spi_flash_send(spi, SPI_FLASH_CMD_JEDEC_ID, 1, true);
+  spi_flash_segment(spi, 3, false, kSpiSpeedStandard, kSpiDirRxOnly);
+  uint32_t word = spi_flash_receive_word(spi) & 0xffffff;
+
+  id->manufacturer = word & 0xff;
+  id->memory_type = (word >> 8) & 0xff;
+  id->capacity = (word >> 16) & 0xff;
+  if (word == 0 || word == 0xffffff) {
+    return kSpiFlashErrorNoDevice;
+  }
+  return kSpiFlashOk;
+}
+
+spi_flash_result_t spi_flash_read(const spi_flash_t *flash, uint32_t addr,
+                                  void *dst, uint32_t len,
+                                  spi_flash_read_mode_t mode) {
+  const spi_host_t *spi = &flash->spi;
+  dma_t dma = {
+      .base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS),
+  };
+  dma_borrow_t saved;
+  uint32_t mstatus = 0;
+  uint8_t *dst8 = (uint8_t *)dst;
+  uint32_t done = 0;
+  bool use_dma = false;
+
+  if (mode > kSpiFlashReadQuad || !spi_flash_in_range(flash, addr, len)) {
+    return kSpiFlashErrorParam;
+  }
+  if (len == 0) {
+    return kSpiFlashOk;
+  }
+
+  // the DMA moves the whole words, the CPU the last bytes
+  if (flash->use_dma && ((uintptr_t)dst & 3) == 0 && len >= 4) {
+    mstatus = spi_flash_irq_disable();
+    use_dma = spi_flash_dma_start(
+        &dma, &saved,
+        (uint32_t)spi->base_addr.base + SPI_HOST_RXDATA_REG_OFFSET,
+        (uint32_t)dst, 0, 4,
+        spi_flash_on_flash_host(flash) ? DMA_SPI_FLASH_RX_SLOT
+                                       : DMA_SPI_RX_SLOT,
+        0, len & ~3u);
+    if (!use_dma) {
+      spi_flash_irq_restore(mstatus);
+    }
+  }
+
+  spi_flash_send_read(spi, addr, len, mode);
+
+  if (use_dma) {
+    dma_release(&dma, &saved);
+    spi_flash_irq_restore(mstatus);
+    done = len & ~3u;
+  }
+
+  while (done < len) {
+    uint32_t word = spi_flash_receive_word(spi);
+    for (uint32_t i = 0; i < 4 && done < len; ++i, ++done) {
+      dst8[done] = word >> (8 * i);
+    }
+  }
+  spi_flash_wait_idle(spi);
+  return kSpiFlashOk;
+}
+
+spi_flash_result_t spi_flash_read_start(const spi_flash_t *flash,
+                                        uint32_t addr, uint32_t len,
+                                        spi_flash_read_mode_t mode) {
+  if (mode > kSpiFlashReadQuad || !spi_flash_in_range(flash, addr, len)) {
+    return kSpiFlashErrorParam;
+  }
+  if (len != 0) {
+    spi_flash_send_read(&flash->spi, addr, len, mode);
+  }
+  return kSpiFlashOk;
+}
+
+/**
+ * Program up to a page, the data must not cross the end of the page.
+ */
+static void spi_flash_program_page(const spi_flash_t *flash, uint32_t addr,
+                                   const uint8_t *src, uint32_t len) {
+  const spi_host_t *spi = &flash->spi;
+  dma_t dma = {
+      .base_addr = mmio_region_from_addr((uintptr_t)DMA_START_ADDRESS),
+  };
+  dma_borrow_t saved;
+  uint32_t mstatus = 0;
+  uint32_t done = 0;
+  bool use_dma = false;
+
+  spi_flash_send(spi, SPI_FLASH_CMD_WRITE_ENABLE, 1, false);
+  spi_flash_send_cmd_addr(spi, SPI_FLASH_CMD_PAGE_PROGRAM, addr, true);
+
+  // the DMA pushes the whole words, the CPU the last bytes. The SPI host
+  // stalls the clock if the TX FIFO runs empty.
+  if (flash->use_dma && ((uintptr_t)src & 3) == 0 && len >= 4) {
+    mstatus = spi_flash_irq_disable();
+    use_dma = spi_flash_dma_start(
+        &dma, &saved, (uint32_t)src,
+        (uint32_t)spi->base_addr.base + SPI_HOST_TXDATA_REG_OFFSET, 4, 0, 0,
+        spi_flash_on_flash_host(flash) ? DMA_SPI_FLASH_TX_SLOT
+                                       : DMA_SPI_TX_SLOT,
+        len & ~3u);
+    if (!use_dma) {
+      spi_flash_irq_restore(mstatus);
+    }
+  }
+
+  spi_flash_segment(spi, len, false, kSpiSpeedStandard, kSpiDirTxOnly);
+
+  if (use_dma) {
+    dma_release(&dma, &saved);
+    spi_flash_irq_restore(mstatus);
+    done = len & ~3u;
+  }
+
+  while (done < len) {
+    uint32_t word = 0;
+    for (uint32_t i = 0; i < 4 && done < len; ++i, ++done) {
+      word |= (uint32_t)src[done] << (8 * i);
+    }
+    while (spi_flash_tx_full(spi)) {
+    }
+    spi_write_word(spi, word);
+  }
+  spi_flash_wait_idle(spi);
+  spi_flash_wait_ready(flash);
+}
+
+spi_flash_result_t spi_flash_write(const spi_flash_t *flash, uint32_t addr,
+                                   const void *src, uint32_t len) {
+  const uint8_t *src8 = (const uint8_t *)src;
+
+  if (!spi_flash_in_range(flash, addr, len)) {
+    return kSpiFlashErrorParam;
+  }
+
+  while (len > 0) {
+    // a page program wraps around at the end of the page
+    uint32_t chunk = SPI_FLASH_PAGE_SIZE - (addr % SPI_FLASH_PAGE_SIZE);
+    if (chunk > len) {
+      chunk = len;
+    }
+    spi_flash_program_page(flash, addr, src8, chunk);
+    addr += chunk;
+    src8 += chunk;
+    len -= chunk;
+  }
+  return kSpiFlashOk;
+}
+
+spi_flash_result_t spi_flash_erase(const spi_flash_t *flash, uint32_t addr,
+                                   spi_flash_erase_t erase) {
+  const spi_host_t *spi = &flash->spi;
+
+  if (erase > kSpiFlashEraseChip ||
+      (erase != kSpiFlashEraseChip && !spi_flash_in_range(flash, addr, 1))) {
+    return kSpiFlashErrorParam;
+  }
+
+  spi_flash_send(spi, SPI_FLASH_CMD_WRITE_ENABLE, 1, false);
+  if (erase == kSpiFlashEraseChip) {
+    spi_flash_send(spi, SPI_FLASH_CMD_CHIP_ERASE, 1, false);
+  } else {
+    spi_flash_send_cmd_addr(spi, kEraseCmd[erase], addr, false);
+  }
+  spi_flash_wait_idle(spi);
+  spi_flash_wait_ready(flash);
+  return kSpiFlashOk;
+}
+
+static uint8_t spi_flash_read_register(const spi_host_t *spi, uint8_t cmd) {
+  spi_flash_send(spi, cmd, 1, true);
+  spi_flash_segment(spi, 1, false, kSpiSpeedStandard, kSpiDirRxOnly);
+  return spi_flash_receive_word(spi) & 0xff;
+}
+
+uint8_t spi_flash_read_status(const spi_flash_t *flash) {
+  return spi_flash_read_register(&flash->spi, SPI_FLASH_CMD_READ_STATUS_1);
+}
+
+void spi_flash_wait_ready(const spi_flash_t *flash) {
+  const spi_host_t *spi = &flash->spi;
+  uint32_t fic = spi_flash_fic(flash);
+  uint32_t mstatus, mie, control, intr_enable, event_enable;
+  uint32_t status;
+
+  // wfi wakes up on the pending SPI event with the interrupts disabled
+  mstatus = spi_flash_irq_disable();
+  CSR_READ(CSR_REG_MIE, &mie);
+  CSR_SET_BITS(CSR_REG_MIE, SPI_FLASH_FAST_INTR_MASK(fic));
+  control = mmio_region_read32(spi->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
+  intr_enable =
+      mmio_region_read32(spi->base_addr, SPI_HOST_INTR_ENABLE_REG_OFFSET);
+  event_enable =
+      mmio_region_read32(spi->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET);
+
+  spi_set_rx_watermark(spi, SPI_FLASH_STATUS_POLL_WORDS);
+  mmio_region_write32(spi->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                      1 << SPI_HOST_EVENT_ENABLE_RXWM_BIT);
+  spi_enable_evt_intr(spi, true);
+
+  spi_flash_send(spi, SPI_FLASH_CMD_READ_STATUS_1, 1, true);
+  do {
+    spi_flash_segment(spi, SPI_FLASH_STATUS_POLL_BYTES, true,
+                      kSpiSpeedStandard, kSpiDirRxOnly);
+    while (spi_get_rx_queue_depth(spi) < SPI_FLASH_STATUS_POLL_WORDS) {
+      wait_for_interrupt();
+    }
+    for (uint32_t i = 0; i < SPI_FLASH_STATUS_POLL_WORDS; ++i) {
+      spi_read_word(spi, &status);
+    }
+    mmio_region_write32(spi->base_addr, SPI_HOST_INTR_STATE_REG_OFFSET,
+                        1 << SPI_HOST_INTR_STATE_SPI_EVENT_BIT);
+    clear_fast_interrupt(fic);
+    // the last status read
+  } while ((status >> 24) & (1 << SPI_FLASH_STATUS_1_BUSY_BIT));
+
+  // release the chip select
+  spi_flash_segment(spi, 1, false, kSpiSpeedStandard, kSpiDirRxOnly);
+  spi_flash_receive_word(spi);
+  spi_flash_wait_idle(spi);
+
+  mmio_region_write32(spi->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                      event_enable);
+  mmio_region_write32(spi->base_addr, SPI_HOST_INTR_ENABLE_REG_OFFSET,
+                      intr_enable);
+  mmio_region_write32(spi->base_addr, SPI_HOST_CONTROL_REG_OFFSET, control);
+  mmio_region_write32(spi->base_addr, SPI_HOST_INTR_STATE_REG_OFFSET,
+                      1 << SPI_HOST_INTR_STATE_SPI_EVENT_BIT);
+  clear_fast_interrupt(fic);
+  CSR_WRITE(CSR_REG_MIE, mie);
+  spi_flash_irq_restore(mstatus);
+}
+
+void spi_flash_set_quad_enable(const spi_flash_t *flash, bool enable) {
+  const spi_host_t *spi = &flash->spi;
+  uint8_t status_2 =
+      spi_flash_read_register(spi, SPI_FLASH_CMD_READ_STATUS_2);
+
+  if (((status_2 >> SPI_FLASH_STATUS_2_QE_BIT) & 1) == enable) {
+    return;
+  }
+  status_2 ^= 1 << SPI_FLASH_STATUS_2_QE_BIT;
+  spi_flash_send(spi, SPI_FLASH_CMD_WRITE_ENABLE, 1, false);
+  spi_flash_send(spi, SPI_FLASH_CMD_WRITE_STATUS_2 | (status_2 << 8), 2,
+                 false);
+  spi_flash_wait_idle(spi);
+  spi_flash_wait_ready(flash);
+}
+
+void spi_flash_power_down(const spi_flash_t *flash) {
+  spi_flash_send(&flash->spi, SPI_FLASH_CMD_POWER_DOWN, 1, false);
+  spi_flash_wait_idle(&flash->spi);
+}
@@ -0,0 +1,235 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// SPI NOR flash commands on top of the OpenTitan SPI host (JEDEC ID, reads,
+// page program, erase), e.g. for the W25Q128JV of the EPFL programmer
+
+#ifndef _DRIVERS_SPI_FLASH_H_
+#define _DRIVERS_SPI_FLASH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "spi_host.h"
+
+/**
+ * Flash commands.
+ */
+#define SPI_FLASH_CMD_WRITE_ENABLE 0x06
+#define SPI_FLASH_CMD_READ_STATUS_1 0x05
+#define SPI_FLASH_CMD_READ_STATUS_2 0x35
+#define SPI_FLASH_CMD_WRITE_STATUS_2 0x31
+#define SPI_FLASH_CMD_READ 0x03
+#define SPI_FLASH_CMD_FAST_READ 0x0B
+#define SPI_FLASH_CMD_DUAL_OUTPUT_READ 0x3B
+#define SPI_FLASH_CMD_QUAD_OUTPUT_READ 0x6B
+#define SPI_FLASH_CMD_PAGE_PROGRAM 0x02
+#define SPI_FLASH_CMD_SECTOR_ERASE 0x20
+#define SPI_FLASH_CMD_BLOCK_ERASE_32K 0x52
+#define SPI_FLASH_CMD_BLOCK_ERASE_64K 0xD8
+#define SPI_FLASH_CMD_CHIP_ERASE 0xC7
+#define SPI_FLASH_CMD_JEDEC_ID 0x9F
+#define SPI_FLASH_CMD_POWER_UP 0xAB
+#define SPI_FLASH_CMD_POWER_DOWN 0xB9
+#define SPI_FLASH_CMD_CONTINUOUS_READ_RESET 0xFF
+
+/**
+ * Status register bits.
+ */
+#define SPI_FLASH_STATUS_1_BUSY_BIT 0
+#define SPI_FLASH_STATUS_1_WEL_BIT 1
+#define SPI_FLASH_STATUS_2_QE_BIT 1
+
+#define SPI_FLASH_PAGE_SIZE 256
+#define SPI_FLASH_SECTOR_SIZE (4 * 1024)
+
+/**
+ * Dummy cycles of the fast, dual and quad output read commands.
+ */
+#define SPI_FLASH_READ_DUMMY_CYCLES 8
+
+/**
+ * Status register reads per wake-up while waiting for the end of a program
+ * or an erase (see spi_flash_wait_ready).
+ */
+#define SPI_FLASH_STATUS_POLL_BYTES 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum spi_flash_result {
+  kSpiFlashOk = 0,
+  /**
+   * Invalid argument, e.g. an address beyond the end of the flash.
+   */
+  kSpiFlashErrorParam = 1,
+  /**
+   * No flash answered the JEDEC ID command.
+   */
+  kSpiFlashErrorNoDevice = 2,
+} spi_flash_result_t;
+
+/**
+ * Read command, the data is received at the given width. The flash must have
+ * its quad enable bit set for kSpiFlashReadQuad (see spi_flash_set_quad_enable).
+ */
+typedef enum spi_flash_read_mode {
+  kSpiFlashReadStandard = 0, /*!< Read (0x03). */
+  kSpiFlashReadFast = 1,     /*!< Fast read (0x0B). */
+  kSpiFlashReadDual = 2,     /*!< Dual output fast read (0x3B). */
+  kSpiFlashReadQuad = 3,     /*!< Quad output fast read (0x6B). */
+} spi_flash_read_mode_t;
+
+typedef enum spi_flash_erase {
+  kSpiFlashErase4K = 0,  /*!< Sector erase (0x20). */
+  kSpiFlashErase32K = 1, /*!< Block erase (0x52). */
+  kSpiFlashErase64K = 2, /*!< Block erase (0xD8). */
+  kSpiFlashEraseChip = 3 /*!< Chip erase (0xC7), the address is ignored. */
+} spi_flash_erase_t;
+
+/**
+ * JEDEC ID of the flash.
+ */
+typedef struct spi_flash_jedec_id {
+  uint8_t manufacturer;
+  uint8_t memory_type;
+  /**
+   * Size of the flash, log2 of the number of bytes.
+   */
+  uint8_t capacity;
+} spi_flash_jedec_id_t;
+
+/**
+ * Flash attached to one of the SPI hosts.
+ */
+typedef struct spi_flash {
+  /**
+   * SPI host the flash is attached to (SPI_FLASH_START_ADDRESS or
+   * SPI_HOST_START_ADDRESS). Set before calling spi_flash_init.
+   */
+  spi_host_t spi;
+  /**
+   * Chip select of the flash. Set before calling spi_flash_init.
+   */
+  uint32_t csid;
+  /**
+   * Move the data with the DMA, when it is idle and its hardware start
+   * (dma_set_ext_start) is disabled. Can be changed between calls.
+   */
+  bool use_dma;
+  /**
+   * Size in bytes, from the JEDEC ID. Set by spi_flash_init.
+   */
+  uint32_t size;
+} spi_flash_t;
+
+/**
+ * Set the SPI clock and chip select of the flash, take it out of the
+ * continuous read mode of the memory mapped flash, wake it up from power down
+ * and read its JEDEC ID.
+ * The SPI flash host must be connected to the flash pads, which are shared with
+ * the memory mapped flash (see soc_ctrl_select_spi_host).
+ * @param flash Pointer to spi_flash_t with the spi, csid and use_dma fields set.
+ * @param core_clk Core clock frequency in Hz (see soc_ctrl_get_frequency).
+ * @param max_clk Maximum SPI clock frequency of the flash in Hz.
+ * @return kSpiFlashErrorNoDevice if no JEDEC ID is read.
+ */
+spi_flash_result_t spi_flash_init(spi_flash_t *flash, uint32_t core_clk, uint32_t max_clk);
+
+/**
+ * Read the JEDEC ID (0x9F).
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ * @param id Filled with the ID.
+ * @return kSpiFlashErrorNoDevice if the ID is all 0s or all 1s.
+ */
+spi_flash_result_t spi_flash_read_jedec_id(const spi_flash_t *flash, spi_flash_jedec_id_t *id);
+
+/**
+ * Read from the flash. The words are moved from the RX FIFO by the DMA if
+ * use_dma is set, the DMA is idle with its hardware start disabled and dst is
+ * word aligned, by the CPU otherwise. The interrupts are disabled while the
+ * DMA is used.
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ * @param addr Address in the flash.
+ * @param dst Destination buffer.
+ * @param len Number of bytes.
+ * @param mode Read command.
+ * @return kSpiFlashErrorParam if the read goes beyond the end of the flash.
+ */
+spi_flash_result_t spi_flash_read(const spi_flash_t *flash, uint32_t addr, void *dst,
+                                  uint32_t len, spi_flash_read_mode_t mode);
+
+/**
+ * Start a read from the flash without moving the data: the len bytes are
+ * received in the RX FIFO of the SPI host, to be emptied by the caller, e.g.
+ * with the DMA set up beforehand on the SPI (flash) RX slot while the CPU
+ * sleeps. Returns once the command is queued.
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ * @param addr Address in the flash.
+ * @param len Number of bytes.
+ * @param mode Read command.
+ * @return kSpiFlashErrorParam if the read goes beyond the end of the flash.
+ */
+spi_flash_result_t spi_flash_read_start(const spi_flash_t *flash, uint32_t addr,
+                                        uint32_t len, spi_flash_read_mode_t mode);
+
+/**
+ * Program the flash, split in as many page programs (0x02) as the pages the
+ * data spans. Returns once the last page is programmed. The bytes to program
+ * must be erased.
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ * @param addr Address in the flash.
+ * @param src Data to program.
+ * @param len Number of bytes.
+ * @return kSpiFlashErrorParam if the data goes beyond the end of the flash.
+ */
+spi_flash_result_t spi_flash_write(const spi_flash_t *flash, uint32_t addr, const void *src,
+                                   uint32_t len);
+
+/**
+ * Erase a sector, a block or the whole flash, to 0xFF. Returns once the
+ * erase is done.
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ * @param addr Address in the sector or block, rounded down to its start.
+ * @param erase Size of the erase.
+ * @return kSpiFlashErrorParam if the address is beyond the end of the flash.
+ */
+spi_flash_result_t spi_flash_erase(const spi_flash_t *flash, uint32_t addr, spi_flash_erase_t erase);
+
+/**
+ * Read the status register 1 (0x05).
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ * @return Status register 1.
+ */
+uint8_t spi_flash_read_status(const spi_flash_t *flash);
+
+/**
+ * Wait for the end of a program or an erase. The flash sends its status
+ * register repeatedly while it is selected, the CPU sleeps while the SPI host
+ * receives SPI_FLASH_STATUS_POLL_BYTES of them and is woken up by the SPI
+ * event interrupt (the interrupt is not taken, no handler is needed).
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ */
+void spi_flash_wait_ready(const spi_flash_t *flash);
+
+/**
+ * Set or clear the quad enable bit (bit 1 of the status register 2, as in the
+ * Winbond W25Q flashes), needed by kSpiFlashReadQuad.
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ * @param enable Value of the bit.
+ */
+void spi_flash_set_quad_enable(const spi_flash_t *flash, bool enable);
+
+/**
+ * Put the flash in power down (0xB9), spi_flash_init wakes it up.
+ * @param flash Pointer to spi_flash_t representing the target flash.
+ */
+void spi_flash_power_down(const spi_flash_t *flash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_SPI_FLASH_H_
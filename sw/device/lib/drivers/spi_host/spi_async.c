@@ -0,0 +1,357 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "spi_async.h"
+
+#include "bitfield.h"
+#include "csr.h"
+#include "hart.h"
+#include "core_v_mini_mcu.h"
+#include "dma_async.h"
+#include "fast_intr_ctrl.h"
+
+// mstatus.MIE
+#define SPI_ASYNC_MSTATUS_MIE (1 << 3)
+
+static spi_async_t *spi_async_queues[kSpiAsyncNum];
+
+static const uint32_t spi_async_base[kSpiAsyncNum] = {
+    SPI_HOST_START_ADDRESS, SPI_FLASH_START_ADDRESS
+};
+
+static const fast_intr_ctrl_fast_interrupt_t spi_async_fic[kSpiAsyncNum] = {
+    kSpi_fic_e, kSpiFlash_fic_e
+};
+
+static const uint16_t spi_async_rx_slot[kSpiAsyncNum] = {
+    DMA_SPI_RX_SLOT, DMA_SPI_FLASH_RX_SLOT
+};
+
+static inline uint32_t spi_async_lock(void) {
+    uint32_t mstatus;
+    CSR_READ(CSR_REG_MSTATUS, &mstatus);
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, SPI_ASYNC_MSTATUS_MIE);
+    return mstatus;
+}
+
+static inline void spi_async_unlock(uint32_t mstatus) {
+    if (mstatus & SPI_ASYNC_MSTATUS_MIE) {
+        CSR_SET_BITS(CSR_REG_MSTATUS, SPI_ASYNC_MSTATUS_MIE);
+    }
+}
+
+static inline uint32_t spi_async_tx_level(const spi_async_t *q) {
+    return bitfield_field32_read(spi_get_status(&q->spi), SPI_HOST_STATUS_TXQD_FIELD);
+}
+
+static inline uint32_t spi_async_rx_level(const spi_async_t *q) {
+    return bitfield_field32_read(spi_get_status(&q->spi), SPI_HOST_STATUS_RXQD_FIELD);
+}
+
+// Push the bytes of the segment while there is room in the TX FIFO. The
+// unused bytes of the last word are dropped by the SPI host.
+static void spi_async_tx(spi_async_t *q, const spi_segment_t *seg) {
+    const uint8_t *tx = seg->tx;
+
+    do {
+        uint32_t level = spi_async_tx_level(q);
+        while (q->tx_pos < seg->len && level < SPI_HOST_PARAM_TX_DEPTH) {
+            uint32_t word;
+            if (((uintptr_t)&tx[q->tx_pos] & 3) == 0) {
+                word = *(const uint32_t *)&tx[q->tx_pos];
+            } else {
+                word = 0;
+                for (uint32_t i = 0; i < 4 && q->tx_pos + i < seg->len; i++) {
+                    word |= (uint32_t)tx[q->tx_pos + i] << (8 * i);
+                }
+            }
+            mmio_region_write32(q->spi.base_addr, SPI_HOST_TXDATA_REG_OFFSET, word);
+            q->tx_pos = seg->len - q->tx_pos > 4 ? q->tx_pos + 4 : seg->len;
+            level++;
+        }
+      // The TX watermark event only fires when the level goes below it
+    } while (q->tx_pos < seg->len && spi_async_tx_level(q) < SPI_ASYNC_TX_WATERMARK);
+}
+
+// Pop the received words of the segment.
+static void spi_async_rx(spi_async_t *q, const spi_segment_t *seg) {
+    uint8_t *rx = seg->rx;
+
+    do {
+        uint32_t level = spi_async_rx_level(q);
+        while (q->rx_pos < seg->len && level != 0) {
+            uint32_t word = mmio_region_read32(q->spi.base_addr, SPI_HOST_RXDATA_REG_OFFSET);
+            if (((uintptr_t)&rx[q->rx_pos] & 3) == 0 && seg->len - q->rx_pos >= 4) {
+                *(uint32_t *)&rx[q->rx_pos] = word;
+                q->rx_pos += 4;
+            } else {
+                for (uint32_t i = 0; i < 4 && q->rx_pos < seg->len; i++) {
+                    rx[q->rx_pos++] = word >> (8 * i);
+                }
+            }
+            level--;
+        }
+        if (q->rx_pos == seg->len) {
+            return;
+        }
+        // Wake up for the last words of the segment, below the usual watermark
+        uint32_t words = (seg->len - q->rx_pos + 3) / 4;
+        spi_set_rx_watermark(&q->spi, words < SPI_ASYNC_RX_WATERMARK ? words : SPI_ASYNC_RX_WATERMARK);
+      // The RX watermark event only fires when the level reaches it
+    } while (spi_async_rx_level(q) != 0);
+}
+
+static void spi_async_service(spi_async_t *q);
+
+// DMA completion callback, the RX data of the segment is in memory.
+static void spi_async_dma_done(void *ctx) {
+    spi_async_t *q = ctx;
+    q->rx_pos = q->queue[q->head].segments[q->seg].len;
+    q->rx_dma = false;
+    spi_async_service(q);
+}
+
+// Start the RX DMA of the segment, false if the CPU has to pop the data.
+static bool spi_async_start_dma(spi_async_t *q, const spi_segment_t *seg) {
+    if (!q->use_dma || ((uintptr_t)seg->rx & 3) != 0 || (seg->len & 3) != 0) {
+        return false;
+    }
+
+    dma_job_t job = {
+        .src = (uint32_t)q->spi.base_addr.base + SPI_HOST_RXDATA_REG_OFFSET,
+        .dst = (uint32_t)seg->rx,
+        .size = seg->len,
+        .src_inc = 0,
+        .dst_inc = 4,
+        .src_type = 0,
+        .dst_type = 0,
+        .rx_slot_mask = spi_async_rx_slot[q->host],
+    };
+    q->rx_dma = true;
+    if (dma_submit(&job, spi_async_dma_done, q) == DMA_ASYNC_INVALID_JOB) {
+        q->rx_dma = false;
+    }
+    return q->rx_dma;
+}
+
+// Pop the transaction at the head of the queue and call its callback.
+static void spi_async_complete(spi_async_t *q) {
+    spi_transaction_t transaction = q->queue[q->head];
+
+    q->head = (q->head + 1) % SPI_ASYNC_QUEUE_SIZE;
+    q->count--;
+    q->seg = 0;
+    q->cmd_issued = false;
+
+    if (transaction.cb != NULL) {
+        transaction.cb(transaction.ctx);
+    }
+}
+
+// Move the data and issue the commands as far as possible, then return to
+// wait for an event (ready, TX or RX watermark, idle) or for the DMA.
+// Must be called with interrupts disabled.
+static void spi_async_service(spi_async_t *q) {
+    while (q->count != 0) {
+        const spi_transaction_t *transaction = &q->queue[q->head];
+
+        if (q->seg == transaction->num_segments) {
+            // All the data is moved, wait for the end of the last command
+            if (bitfield_bit32_read(spi_get_status(&q->spi), SPI_HOST_STATUS_ACTIVE_BIT)) {
+                return;
+            }
+            spi_async_complete(q);
+            continue;
+        }
+
+        const spi_segment_t *seg = &transaction->segments[q->seg];
+        bool tx = seg->dir == kSpiDirTxOnly || seg->dir == kSpiDirBidir;
+        bool rx = seg->dir == kSpiDirRxOnly || seg->dir == kSpiDirBidir;
+
+        if (!q->cmd_issued) {
+            if (!spi_get_ready(&q->spi)) {
+                return;
+            }
+            if (q->seg == 0) {
+                spi_set_csid(&q->spi, transaction->csid);
+            }
+            q->tx_pos = 0;
+            q->rx_pos = 0;
+            if (rx) {
+                spi_async_start_dma(q, seg);
+            }
+            // The command stalls on an empty TX FIFO, fill it first
+            if (tx) {
+                spi_async_tx(q, seg);
+            }
+            spi_set_command(&q->spi, spi_create_command((spi_command_t){
+                .len        = seg->len - 1,
+                .csaat      = q->seg + 1 < transaction->num_segments,
+                .speed      = seg->speed,
+                .direction  = seg->dir
+            }));
+            q->cmd_issued = true;
+        }
+
+        if (tx) {
+            spi_async_tx(q, seg);
+        }
+        if (rx && !q->rx_dma) {
+            spi_async_rx(q, seg);
+        }
+        if ((tx && q->tx_pos < seg->len) || (rx && q->rx_pos < seg->len)) {
+            return;
+        }
+
+        // The next command is queued while this one ends, with CS asserted
+        q->seg++;
+        q->cmd_issued = false;
+    }
+}
+
+static int32_t spi_async_find(const spi_async_t *q, spi_async_id_t id) {
+    for (uint32_t i = 0; i < q->count; i++) {
+        if (q->ids[(q->head + i) % SPI_ASYNC_QUEUE_SIZE] == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// A segment moves at least one byte (or cycle), from or to a buffer.
+static bool spi_async_valid(const spi_transaction_t *transaction) {
+    if (transaction->num_segments == 0 || transaction->segments == NULL) {
+        return false;
+    }
+    for (uint32_t i = 0; i < transaction->num_segments; i++) {
+        const spi_segment_t *seg = &transaction->segments[i];
+        if (seg->len == 0) {
+            return false;
+        }
+        if ((seg->dir == kSpiDirTxOnly || seg->dir == kSpiDirBidir) && seg->tx == NULL) {
+            return false;
+        }
+        if ((seg->dir == kSpiDirRxOnly || seg->dir == kSpiDirBidir) && seg->rx == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool spi_async_init(spi_async_t *q, const spi_host_t *spi, bool use_dma) {
+    spi_async_host_e host;
+    for (host = 0; host < kSpiAsyncNum; host++) {
+        if ((uint32_t)spi->base_addr.base == spi_async_base[host]) {
+            break;
+        }
+    }
+    if (host == kSpiAsyncNum) {
+        return false;
+    }
+
+    uint32_t mstatus = spi_async_lock();
+    q->spi = *spi;
+    q->host = host;
+    q->use_dma = use_dma;
+    q->head = 0;
+    q->count = 0;
+    q->next_id = 1;
+    q->seg = 0;
+    q->cmd_issued = false;
+    q->rx_dma = false;
+    spi_async_queues[host] = q;
+
+    spi_set_tx_watermark(spi, SPI_ASYNC_TX_WATERMARK);
+    spi_set_rx_watermark(spi, SPI_ASYNC_RX_WATERMARK);
+    uint32_t events = 0;
+    events = bitfield_bit32_write(events, SPI_HOST_EVENT_ENABLE_RXWM_BIT, true);
+    events = bitfield_bit32_write(events, SPI_HOST_EVENT_ENABLE_TXWM_BIT, true);
+    events = bitfield_bit32_write(events, SPI_HOST_EVENT_ENABLE_READY_BIT, true);
+    events = bitfield_bit32_write(events, SPI_HOST_EVENT_ENABLE_IDLE_BIT, true);
+    mmio_region_write32(spi->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET, events);
+    spi_enable_evt_intr(spi, true);
+
+    enable_fast_interrupt(spi_async_fic[host], true);
+    CSR_SET_BITS(CSR_REG_MIE, 1 << (16 + spi_async_fic[host]));
+    spi_async_unlock(mstatus);
+    return true;
+}
+
+spi_async_id_t spi_async_submit(spi_async_t *q, const spi_transaction_t *transaction) {
+    spi_async_id_t id = SPI_ASYNC_INVALID_ID;
+    if (!spi_async_valid(transaction)) {
+        return id;
+    }
+
+    uint32_t mstatus = spi_async_lock();
+
+    if (q->count < SPI_ASYNC_QUEUE_SIZE) {
+        uint32_t tail = (q->head + q->count) % SPI_ASYNC_QUEUE_SIZE;
+        id = q->next_id++;
+        if (q->next_id == SPI_ASYNC_INVALID_ID) {
+            q->next_id++;
+        }
+        q->queue[tail] = *transaction;
+        q->ids[tail] = id;
+        q->count++;
+        // Starts it right away if the queue was empty
+        spi_async_service(q);
+    }
+
+    spi_async_unlock(mstatus);
+    return id;
+}
+
+bool spi_async_done(spi_async_t *q, spi_async_id_t id) {
+    uint32_t mstatus = spi_async_lock();
+    bool done = spi_async_find(q, id) < 0;
+    spi_async_unlock(mstatus);
+    return done;
+}
+
+void spi_async_wait(spi_async_t *q, spi_async_id_t id) {
+    uint32_t mstatus;
+    CSR_READ(CSR_REG_MSTATUS, &mstatus);
+
+    while (!spi_async_done(q, id)) {
+        // Check again with interrupts disabled so the completion cannot be missed,
+        // wfi still wakes up on a pending interrupt.
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, SPI_ASYNC_MSTATUS_MIE);
+        if (spi_async_find(q, id) >= 0) {
+            wait_for_interrupt();
+        }
+        CSR_SET_BITS(CSR_REG_MSTATUS, SPI_ASYNC_MSTATUS_MIE);
+    }
+
+    // Interrupts are needed to make progress, restore the caller state
+    if ((mstatus & SPI_ASYNC_MSTATUS_MIE) == 0) {
+        CSR_CLEAR_BITS(CSR_REG_MSTATUS, SPI_ASYNC_MSTATUS_MIE);
+    }
+}
+
+void spi_async_irq_handler(spi_async_host_e host) {
+    spi_async_t *q = spi_async_queues[host];
+    if (q == NULL) {
+        // The SPI host is used directly, not through the queue
+        return;
+    }
+
+    // Clear the event before servicing, the next edges raise it again
+    uint32_t reg = bitfield_bit32_write(0, SPI_HOST_INTR_STATE_SPI_EVENT_BIT, true);
+    mmio_region_write32(q->spi.base_addr, SPI_HOST_INTR_STATE_REG_OFFSET, reg);
+    spi_async_service(q);
+}
+
+// Serviced from the SPI fast interrupt, before the user fic_irq_spi
+void fic_driver_irq_spi(void) {
+    spi_async_irq_handler(kSpiAsyncHost);
+}
+
+// Serviced from the SPI flash fast interrupt, before the user fic_irq_spi_flash
+void fic_driver_irq_spi_flash(void) {
+    spi_async_irq_handler(kSpiAsyncFlash);
+}
@@ -0,0 +1,184 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Queued SPI transactions, run from the SPI event interrupt
+
+#ifndef _DRIVERS_SPI_ASYNC_H_
+#define _DRIVERS_SPI_ASYNC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "spi_host.h"
+
+/**
+ * Number of transactions that can be waiting in the queue of a SPI host,
+ * including the one running. Can be overriden at compile time.
+ */
+#ifndef SPI_ASYNC_QUEUE_SIZE
+#define SPI_ASYNC_QUEUE_SIZE 4
+#endif
+
+/**
+ * Invalid transaction identifier, returned when a transaction cannot be
+ * submitted.
+ */
+#define SPI_ASYNC_INVALID_ID 0
+
+/**
+ * TX FIFO level, in words, below which the TX FIFO is refilled.
+ */
+#define SPI_ASYNC_TX_WATERMARK 16
+
+/**
+ * RX FIFO level, in words, above which the RX FIFO is emptied by the CPU.
+ */
+#define SPI_ASYNC_RX_WATERMARK 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * SPI hosts with a transaction queue, each has its fast interrupt and its DMA
+ * trigger slots.
+ */
+typedef enum spi_async_host {
+    kSpiAsyncHost  = 0, /*!< SPI_HOST_START_ADDRESS. */
+    kSpiAsyncFlash = 1, /*!< SPI_FLASH_START_ADDRESS. */
+    kSpiAsyncNum   = 2
+} spi_async_host_e;
+
+/**
+ * One command of a transaction.
+ */
+typedef struct spi_segment {
+    /**
+     * kSpiDirDummy (len clock cycles without data), kSpiDirRxOnly,
+     * kSpiDirTxOnly or kSpiDirBidir.
+     */
+    spi_dir_e   dir;
+    spi_speed_e speed;
+    /**
+     * Number of bytes, or of clock cycles for kSpiDirDummy.
+     */
+    uint32_t    len;
+    /**
+     * Data sent, for kSpiDirTxOnly and kSpiDirBidir.
+     */
+    const void  *tx;
+    /**
+     * Data received, for kSpiDirRxOnly and kSpiDirBidir. Moved by the DMA if
+     * the queue uses it, rx is word aligned and len is a multiple of 4.
+     */
+    void        *rx;
+} spi_segment_t;
+
+/**
+ * Completion callback, called from the interrupt handler once the
+ * transaction is done and before the next one starts.
+ */
+typedef void (*spi_async_callback_t)(void *ctx);
+
+/**
+ * Sequence of segments sent with the chip select kept asserted in between.
+ */
+typedef struct spi_transaction {
+    /**
+     * Segments, read while the transaction runs: they and their buffers must be
+     * kept until the transaction is done.
+     */
+    const spi_segment_t  *segments;
+    uint32_t             num_segments;
+    /**
+     * Chip select, configured with spi_set_configopts.
+     */
+    uint32_t             csid;
+    /**
+     * Completion callback, can be NULL.
+     */
+    spi_async_callback_t cb;
+    /**
+     * Argument given to the callback.
+     */
+    void                 *ctx;
+} spi_transaction_t;
+
+/**
+ * Identifier of a submitted transaction.
+ */
+typedef uint32_t spi_async_id_t;
+
+/**
+ * Transaction queue of a SPI host. The fields are private.
+ */
+typedef struct spi_async {
+    spi_host_t        spi;
+    spi_async_host_e  host;
+    bool              use_dma;
+    spi_transaction_t queue[SPI_ASYNC_QUEUE_SIZE];
+    spi_async_id_t    ids[SPI_ASYNC_QUEUE_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t count;
+    spi_async_id_t    next_id;
+    // Progress of the segment at the head of the queue
+    uint32_t          seg;
+    bool              cmd_issued;
+    uint32_t          tx_pos;
+    uint32_t          rx_pos;
+    volatile bool     rx_dma;
+} spi_async_t;
+
+/**
+ * Initialize the transaction queue of a SPI host and enable its events and its
+ * fast interrupt. The SPI host must be enabled and its chip selects configured
+ * (spi_set_enable, spi_output_enable, spi_set_configopts).
+ * Machine-level interrupts still have to be enabled globally (mstatus.MIE).
+ * @param queue Transaction queue, owned by the driver from now on.
+ * @param spi SPI host, at SPI_HOST_START_ADDRESS or SPI_FLASH_START_ADDRESS.
+ * @param use_dma Receive through the DMA, with dma_async (see dma_async_init),
+ * while the CPU refills the TX FIFO from the interrupt.
+ * @return false if spi is not one of the SPI hosts with a fast interrupt.
+ */
+bool spi_async_init(spi_async_t *queue, const spi_host_t *spi, bool use_dma);
+
+/**
+ * Submit a transaction. It is copied into the queue and started as soon as
+ * the transactions submitted before it are done.
+ * @param queue Transaction queue of the SPI host.
+ * @param transaction Segments and chip select, the segments are not copied.
+ * @return The transaction identifier, SPI_ASYNC_INVALID_ID if the queue is
+ * full, the transaction has no segment, a segment has a len of 0 or a
+ * segment moving data has no tx or rx buffer.
+ */
+spi_async_id_t spi_async_submit(spi_async_t *queue, const spi_transaction_t *transaction);
+
+/**
+ * Check if a transaction is done.
+ * @param queue Transaction queue of the SPI host.
+ * @param id Identifier returned by spi_async_submit.
+ */
+bool spi_async_done(spi_async_t *queue, spi_async_id_t id);
+
+/**
+ * Wait for a transaction to be done, sleeping with wfi in between interrupts.
+ * @param queue Transaction queue of the SPI host.
+ * @param id Identifier returned by spi_async_submit.
+ */
+void spi_async_wait(spi_async_t *queue, spi_async_id_t id);
+
+/**
+ * Moves the data of the running transaction and starts the next segments.
+ * Called through the fic_driver_irq_spi and fic_driver_irq_spi_flash hooks
+ * of the fast SPI interrupt handlers, before fic_irq_spi and
+ * fic_irq_spi_flash.
+ * @param host SPI host of the interrupt.
+ */
+void spi_async_irq_handler(spi_async_host_e host);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _DRIVERS_SPI_ASYNC_H_
@@ -0,0 +1,51 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "spi_memio.h"
+
+#include <stddef.h>
+
+#include "bitfield.h"
+
+void spi_memio_cache_enable(const spi_memio_t *spi_memio, bool enable) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_ENABLE_REG_OFFSET), enable ? 0x1 : 0x0);
+}
+
+void spi_memio_cache_flush(const spi_memio_t *spi_memio) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_FLUSH_REG_OFFSET), 0x1);
+}
+
+void spi_memio_cache_get_stats(const spi_memio_t *spi_memio, uint32_t *hits, uint32_t *misses) {
+  *hits = mmio_region_read32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_HITS_REG_OFFSET));
+  *misses = mmio_region_read32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_MISSES_REG_OFFSET));
+}
+
+void spi_memio_cache_clear_stats(const spi_memio_t *spi_memio) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CACHE_STAT_CLEAR_REG_OFFSET), 0x1);
+}
+
+void spi_memio_set_mode(const spi_memio_t *spi_memio, spi_memio_mode_t mode, bool continuous, uint8_t dummy_cycles) {
+  uint32_t cfg = mmio_region_read32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET));
+  // spimemio reads back the pins in the low bits, only keep the memory mapped mode
+  cfg = bitfield_bit32_write(0, SPI_MEMIO_CFG_EN_BIT, bitfield_bit32_read(cfg, SPI_MEMIO_CFG_EN_BIT));
+  cfg = bitfield_bit32_write(cfg, SPI_MEMIO_CFG_DDR_BIT, mode == kSpiMemioModeDual || mode == kSpiMemioModeQuadDdr);
+  cfg = bitfield_bit32_write(cfg, SPI_MEMIO_CFG_QSPI_BIT, mode == kSpiMemioModeQuad || mode == kSpiMemioModeQuadDdr);
+  cfg = bitfield_bit32_write(cfg, SPI_MEMIO_CFG_CONT_BIT, continuous);
+  cfg = bitfield_field32_write(cfg, (bitfield_field32_t){ .mask = SPI_MEMIO_CFG_DUMMY_MASK, .index = SPI_MEMIO_CFG_DUMMY_OFFSET }, dummy_cycles);
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET), cfg);
+}
+
+spi_memio_mode_t spi_memio_get_mode(const spi_memio_t *spi_memio) {
+  uint32_t cfg = mmio_region_read32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET));
+  bool ddr = bitfield_bit32_read(cfg, SPI_MEMIO_CFG_DDR_BIT);
+  bool qspi = bitfield_bit32_read(cfg, SPI_MEMIO_CFG_QSPI_BIT);
+  if (qspi) {
+    return ddr ? kSpiMemioModeQuadDdr : kSpiMemioModeQuad;
+  }
+  return ddr ? kSpiMemioModeDual : kSpiMemioModeStandard;
+}
+
+void spi_memio_prefetch_enable(const spi_memio_t *spi_memio, bool enable) {
+  mmio_region_write32(spi_memio->base_addr, (ptrdiff_t)(OBI_SPIMEMIO_PREFETCH_ENABLE_REG_OFFSET), enable ? 0x1 : 0x0);
+}
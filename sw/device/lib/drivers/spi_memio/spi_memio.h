@@ -2,20 +2,59 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
-// Basic device functions for opentitan SPI host
+// Basic device functions for the memory mapped flash (YosysHW SPI)
 
 #ifndef _DRIVERS_SPI_MEMIO_H_
 #define _DRIVERS_SPI_MEMIO_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "mmio.h"
-#include "spimem_regs.h"
+#include "spi_memio_regs.h"
+
+/**
+ * Fields of the YosysHQ spimemio configuration register (CFG_SPIMEM).
+ */
+#define SPI_MEMIO_CFG_EN_BIT 31
+#define SPI_MEMIO_CFG_DDR_BIT 22
+#define SPI_MEMIO_CFG_QSPI_BIT 21
+#define SPI_MEMIO_CFG_CONT_BIT 20
+#define SPI_MEMIO_CFG_DUMMY_MASK 0xf
+#define SPI_MEMIO_CFG_DUMMY_OFFSET 16
+
+/**
+ * Default number of dummy cycles of the dual and quad read commands.
+ */
+#define SPI_MEMIO_DEFAULT_DUMMY_CYCLES 8
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Read command used by the memory mapped flash.
+ */
+typedef enum spi_memio_mode {
+    /**
+    * Read (0x03), one bit per clock.
+    */
+    kSpiMemioModeStandard = 0,
+    /**
+    * Dual I/O fast read (0xBB), two bits per clock.
+    */
+    kSpiMemioModeDual     = 1,
+    /**
+    * Quad I/O fast read (0xEB), four bits per clock. The flash must have
+    * its quad enable bit set.
+    */
+    kSpiMemioModeQuad     = 2,
+    /**
+    * Quad I/O DDR fast read (0xED), eight bits per clock.
+    */
+    kSpiMemioModeQuadDdr  = 3,
+} spi_memio_mode_t;
+
 /**
  * Initialization parameters for SPI MEMIO.
  *
@@ -27,6 +66,61 @@ typedef struct spi_memio {
     mmio_region_t base_addr;
 } spi_memio_t;
 
+/**
+ * Enable or disable the flash cache (FLASH_CACHE_SIZE != 0), when disabled
+ * all the reads go to the flash.
+ * @param spi_memio Pointer to spi_memio_t representing the target SPI MEMIO.
+ * @param enable true to use the cache.
+ */
+void spi_memio_cache_enable(const spi_memio_t *spi_memio, bool enable);
+
+/**
+ * Invalidate all the lines of the flash cache, to be called after the flash
+ * is written (e.g. with the OpenTitan SPI host).
+ * @param spi_memio Pointer to spi_memio_t representing the target SPI MEMIO.
+ */
+void spi_memio_cache_flush(const spi_memio_t *spi_memio);
+
+/**
+ * Read the flash cache counters.
+ * @param spi_memio Pointer to spi_memio_t representing the target SPI MEMIO.
+ * @param hits Number of reads found in the cache.
+ * @param misses Number of reads which fetched a line from the flash.
+ */
+void spi_memio_cache_get_stats(const spi_memio_t *spi_memio, uint32_t *hits, uint32_t *misses);
+
+/**
+ * Reset the flash cache counters to 0.
+ * @param spi_memio Pointer to spi_memio_t representing the target SPI MEMIO.
+ */
+void spi_memio_cache_clear_stats(const spi_memio_t *spi_memio);
+
+/**
+ * Select the read command of the memory mapped flash. The transfer in progress
+ * is restarted, so this can be called while executing from flash.
+ * @param spi_memio Pointer to spi_memio_t representing the target SPI MEMIO.
+ * @param mode Read command.
+ * @param continuous true to send the command only once and then just the
+ * addresses (continuous read mode, dual and quad modes only).
+ * @param dummy_cycles Dummy cycles of the dual and quad read commands (0 to 15,
+ * SPI_MEMIO_DEFAULT_DUMMY_CYCLES at reset).
+ */
+void spi_memio_set_mode(const spi_memio_t *spi_memio, spi_memio_mode_t mode, bool continuous, uint8_t dummy_cycles);
+
+/**
+ * Get the read command of the memory mapped flash.
+ * @param spi_memio Pointer to spi_memio_t representing the target SPI MEMIO.
+ */
+spi_memio_mode_t spi_memio_get_mode(const spi_memio_t *spi_memio);
+
+/**
+ * Enable or disable the prefetch of the next sequential word after each read,
+ * while the flash stays selected.
+ * @param spi_memio Pointer to spi_memio_t representing the target SPI MEMIO.
+ * @param enable true to prefetch.
+ */
+void spi_memio_prefetch_enable(const spi_memio_t *spi_memio, bool enable);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,29 @@ extern "C" {
 // Cfg SPIMEM
 #define OBI_SPIMEMIO_CFG_SPIMEM_REG_OFFSET 0x4
 
+// Flash cache enable, when 0 all the accesses go to the flash
+#define OBI_SPIMEMIO_CACHE_ENABLE_REG_OFFSET 0x8
+#define OBI_SPIMEMIO_CACHE_ENABLE_CACHE_ENABLE_BIT 0
+
+// Flash cache flush, to be used after the flash is written
+#define OBI_SPIMEMIO_CACHE_FLUSH_REG_OFFSET 0xc
+#define OBI_SPIMEMIO_CACHE_FLUSH_CACHE_FLUSH_BIT 0
+
+// Number of reads found in the flash cache
+#define OBI_SPIMEMIO_CACHE_HITS_REG_OFFSET 0x10
+
+// Number of reads which fetched a line from the flash
+#define OBI_SPIMEMIO_CACHE_MISSES_REG_OFFSET 0x14
+
+// Clear the flash cache counters
+#define OBI_SPIMEMIO_CACHE_STAT_CLEAR_REG_OFFSET 0x18
+#define OBI_SPIMEMIO_CACHE_STAT_CLEAR_CACHE_STAT_CLEAR_BIT 0
+
+// Flash prefetch enable, when 1 the next sequential word is read while the
+// flash stays selected
+#define OBI_SPIMEMIO_PREFETCH_ENABLE_REG_OFFSET 0x1c
+#define OBI_SPIMEMIO_PREFETCH_ENABLE_PREFETCH_ENABLE_BIT 0
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -13,6 +13,10 @@
 #include "bitfield.h"
 #include "mmio.h"
 #include "error.h"
+#include "csr.h"
+#include "hart.h"
+#include "rv_plic.h"
+#include "core_v_mini_mcu.h"
 
 #include "uart_regs.h"  // Generated.
 
@@ -20,6 +24,54 @@
 _Static_assert((1UL << NCO_WIDTH) - 1 == UART_CTRL_NCO_MASK,
                "Bad value for NCO_WIDTH");
 
+// Depth of the TX FIFO of the UART
+#define UART_TX_FIFO_DEPTH 32
+// mie.MEIE
+#define UART_MIE_MEIE (1 << 11)
+// mstatus.MIE
+#define UART_MSTATUS_MIE (1 << 3)
+
+// TX buffer, empty when uart_tx_size is 0
+static uart_t uart_tx_periph;
+static uint8_t *uart_tx_buf;
+static size_t uart_tx_size = 0;
+static volatile size_t uart_tx_head;
+static volatile size_t uart_tx_count;
+static volatile size_t uart_tx_drop_count;
+static uart_tx_overflow_t uart_tx_overflow;
+
+// RX buffer, empty when uart_rx_size is 0
+static uart_t uart_rx_periph;
+static uint8_t *uart_rx_buf;
+static size_t uart_rx_size = 0;
+static volatile size_t uart_rx_head;
+static volatile size_t uart_rx_count;
+static volatile size_t uart_rx_overflow_count;
+static uint32_t uart_rx_idle_bits;
+static uart_rx_callback_t uart_rx_idle_cb;
+static void *uart_rx_idle_ctx;
+
+static void uart_rx_drain(void);
+
+static inline uint32_t uart_lock(void) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_CLEAR_BITS(CSR_REG_MSTATUS, UART_MSTATUS_MIE);
+  return mstatus;
+}
+
+static inline void uart_unlock(uint32_t mstatus) {
+  if (mstatus & UART_MSTATUS_MIE) {
+    CSR_SET_BITS(CSR_REG_MSTATUS, UART_MSTATUS_MIE);
+  }
+}
+
+// Position `pos` bytes after `head` in a ring buffer of `size` bytes.
+static inline size_t uart_ring_index(size_t head, size_t pos, size_t size) {
+  pos += head;
+  return pos >= size ? pos - size : pos;
+}
+
 static void uart_reset(const uart_t *uart) {
   mmio_region_write32(uart->base_addr, UART_CTRL_REG_OFFSET, 0u);
 
@@ -35,6 +87,41 @@ static void uart_reset(const uart_t *uart) {
   mmio_region_write32(uart->base_addr, UART_INTR_STATE_REG_OFFSET, UINT32_MAX);
 }
 
+// Refill the TX FIFO when it is half empty.
+static void uart_tx_enable_irq(const uart_t *uart) {
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_RXRST_BIT, false);
+  reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_TXRST_BIT, false);
+  reg = bitfield_field32_write(reg, UART_FIFO_CTRL_TXILVL_FIELD,
+                               UART_FIFO_CTRL_TXILVL_VALUE_TXLVL16);
+  mmio_region_write32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET, reg);
+
+  reg = mmio_region_read32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, UART_INTR_ENABLE_TX_WATERMARK_BIT, true);
+  mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, reg);
+}
+
+// Empty the RX FIFO when it is half full, or when no byte was received for
+// uart_rx_idle_bits bit times.
+static void uart_rx_enable_irq(const uart_t *uart) {
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_RXRST_BIT, false);
+  reg = bitfield_bit32_write(reg, UART_FIFO_CTRL_TXRST_BIT, false);
+  reg = bitfield_field32_write(reg, UART_FIFO_CTRL_RXILVL_FIELD,
+                               UART_FIFO_CTRL_RXILVL_VALUE_RXLVL16);
+  mmio_region_write32(uart->base_addr, UART_FIFO_CTRL_REG_OFFSET, reg);
+
+  reg = bitfield_field32_write(0, UART_TIMEOUT_CTRL_VAL_FIELD, uart_rx_idle_bits);
+  reg = bitfield_bit32_write(reg, UART_TIMEOUT_CTRL_EN_BIT, true);
+  mmio_region_write32(uart->base_addr, UART_TIMEOUT_CTRL_REG_OFFSET, reg);
+
+  reg = mmio_region_read32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, UART_INTR_ENABLE_RX_WATERMARK_BIT, true);
+  reg = bitfield_bit32_write(reg, UART_INTR_ENABLE_RX_TIMEOUT_BIT, true);
+  reg = bitfield_bit32_write(reg, UART_INTR_ENABLE_RX_OVERFLOW_BIT, true);
+  mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, reg);
+}
+
 system_error_t uart_init(const uart_t *uart) {
   if (uart == NULL) {
     return kErrorUartInvalidArgument;
@@ -56,6 +143,16 @@ system_error_t uart_init(const uart_t *uart) {
     return kErrorUartBadBaudRate;
   }
 
+  // The buffered bytes would be lost by the FIFO reset
+  if (uart_tx_size != 0) {
+    uart_flush(uart);
+  }
+  if (uart_rx_size != 0) {
+    uint32_t mstatus = uart_lock();
+    uart_rx_drain();
+    uart_unlock(mstatus);
+  }
+
   // Must be called before the first write to any of the UART registers.
   uart_reset(uart);
 
@@ -67,8 +164,16 @@ system_error_t uart_init(const uart_t *uart) {
   reg = bitfield_bit32_write(reg, UART_CTRL_RX_BIT, true);
   mmio_region_write32(uart->base_addr, UART_CTRL_REG_OFFSET, reg);
 
-  // Disable interrupts.
+  // Disable interrupts, but the ones of the TX and RX buffers.
   mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, 0u);
+  if (uart_tx_size != 0) {
+    uart_tx_periph = *uart;
+    uart_tx_enable_irq(uart);
+  }
+  if (uart_rx_size != 0) {
+    uart_rx_periph = *uart;
+    uart_rx_enable_irq(uart);
+  }
   return kErrorOk;
 }
 
@@ -93,10 +198,6 @@ void uart_putchar(const uart_t *uart, uint8_t byte) {
   }
   uint32_t reg = bitfield_field32_write(0, UART_WDATA_WDATA_FIELD, byte);
   mmio_region_write32(uart->base_addr, UART_WDATA_REG_OFFSET, reg);
-
-  // If the transmitter is active, wait.
-  while (!uart_tx_idle(uart)) {
-  }
 }
 
 static uint8_t uart_rx_fifo_read(const uart_t *uart) {
@@ -105,41 +206,301 @@ static uint8_t uart_rx_fifo_read(const uart_t *uart) {
   return bitfield_field32_read(reg, UART_RDATA_RDATA_FIELD);
 }
 
+// Move the buffered bytes to the TX FIFO until it is full.
+// Must be called with interrupts disabled.
+static void uart_tx_fill(void) {
+  const uart_t *uart = &uart_tx_periph;
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_FIFO_STATUS_REG_OFFSET);
+  uint32_t level = bitfield_field32_read(reg, UART_FIFO_STATUS_TXLVL_FIELD);
+
+  while (uart_tx_count != 0 && level < UART_TX_FIFO_DEPTH) {
+    reg = bitfield_field32_write(0, UART_WDATA_WDATA_FIELD, uart_tx_buf[uart_tx_head]);
+    mmio_region_write32(uart->base_addr, UART_WDATA_REG_OFFSET, reg);
+    uart_tx_head = uart_ring_index(uart_tx_head, 1, uart_tx_size);
+    uart_tx_count--;
+    level++;
+  }
+}
+
+// Move the received bytes to the RX buffer until it is full, the others stay
+// in the RX FIFO. Must be called with interrupts disabled.
+static void uart_rx_drain(void) {
+  const uart_t *uart = &uart_rx_periph;
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_FIFO_STATUS_REG_OFFSET);
+  uint32_t level = bitfield_field32_read(reg, UART_FIFO_STATUS_RXLVL_FIELD);
+
+  while (level != 0 && uart_rx_count != uart_rx_size) {
+    uart_rx_buf[uart_ring_index(uart_rx_head, uart_rx_count, uart_rx_size)] =
+        uart_rx_fifo_read(uart);
+    uart_rx_count++;
+    level--;
+  }
+}
+
+// Wait for the next UART interrupt, called with interrupts disabled and the
+// mstatus of the caller. If the caller has interrupts disabled, the handler
+// cannot run and the FIFOs are serviced here.
+static void uart_sleep(uint32_t mstatus) {
+  if (mstatus & UART_MSTATUS_MIE) {
+    // wfi still wakes up on a pending interrupt, then let the handler run
+    wait_for_interrupt();
+    CSR_SET_BITS(CSR_REG_MSTATUS, UART_MSTATUS_MIE);
+    CSR_CLEAR_BITS(CSR_REG_MSTATUS, UART_MSTATUS_MIE);
+  } else {
+    if (uart_tx_size != 0) {
+      uart_tx_fill();
+    }
+    if (uart_rx_size != 0) {
+      uart_rx_drain();
+    }
+  }
+}
+
 /**
-* Read 1 byte from the RX FIFO.
+* Read 1 byte from the RX FIFO, or from the RX buffer.
 */
 size_t uart_getchar(const uart_t *uart, uint8_t *data) {
-  while (uart_rx_empty(uart));
-  *data = uart_rx_fifo_read(uart);
-  return 1;
+  if (uart_rx_size == 0) {
+    while (uart_rx_empty(uart));
+    *data = uart_rx_fifo_read(uart);
+    return 1;
+  }
+
+  uint32_t mstatus = uart_lock();
+  uart_rx_drain();
+  while (uart_rx_count == 0) {
+    uart_sleep(mstatus);
+  }
+  uart_unlock(mstatus);
+  return uart_read(uart, data, 1);
+}
+
+static size_t uart_tx_buffer_write(const uint8_t *data, size_t len) {
+  uint32_t mstatus = uart_lock();
+
+  for (size_t i = 0; i < len; i++) {
+    if (uart_tx_count == uart_tx_size) {
+      uart_tx_fill();
+    }
+    if (uart_tx_count == uart_tx_size) {
+      if (uart_tx_overflow == kUartTxOverflowDrop) {
+        // Nothing can make room until interrupts are enabled again
+        uart_tx_drop_count += len - i;
+        break;
+      } else if (uart_tx_overflow == kUartTxOverflowOverwrite) {
+        uart_tx_head = uart_ring_index(uart_tx_head, 1, uart_tx_size);
+        uart_tx_count--;
+        uart_tx_drop_count++;
+      } else {
+        while (uart_tx_count == uart_tx_size) {
+          uart_sleep(mstatus);
+        }
+      }
+    }
+    uart_tx_buf[uart_ring_index(uart_tx_head, uart_tx_count, uart_tx_size)] = data[i];
+    uart_tx_count++;
+  }
+
+  // Start the transmission, the tx_watermark interrupt takes over once the
+  // FIFO is full
+  uart_tx_fill();
+  uart_unlock(mstatus);
+  return len;
 }
 
 /**
  * Write `len` bytes to the UART TX FIFO.
  */
 size_t uart_write(const uart_t *uart, const uint8_t *data, size_t len) {
+  if (uart_tx_size != 0) {
+    return uart_tx_buffer_write(data, len);
+  }
+
   size_t total = len;
   while (len) {
     uart_putchar(uart, *data);
     data++;
     len--;
   }
+
+  // The caller may reset the UART next (see _write), wait for the last byte.
+  while (!uart_tx_idle(uart)) {
+  }
   return total;
 }
 
 /**
- * Read `len` bytes from the UART RX FIFO.
+ * Read up to `len` bytes from the UART RX FIFO, or from the RX buffer.
  */
-size_t uart_read(const uart_t *uart, const uint8_t *data, size_t len) {
-  size_t total = len;
-  while (len) {
-    uart_getchar(uart, data);
-    data++;
-    len--;
+size_t uart_read(const uart_t *uart, uint8_t *data, size_t len) {
+  size_t n = 0;
+
+  if (uart_rx_size == 0) {
+    while (n < len && !uart_rx_empty(uart)) {
+      data[n++] = uart_rx_fifo_read(uart);
+    }
+    return n;
   }
-  return total;
+
+  uint32_t mstatus = uart_lock();
+  uart_rx_drain();
+  while (n < len && uart_rx_count != 0) {
+    data[n++] = uart_rx_buf[uart_rx_head];
+    uart_rx_head = uart_ring_index(uart_rx_head, 1, uart_rx_size);
+    uart_rx_count--;
+  }
+  // Make room for the bytes left in the RX FIFO
+  uart_rx_drain();
+  uart_unlock(mstatus);
+  return n;
 }
 
 size_t uart_sink(void *uart, const char *data, size_t len) {
   return uart_write((const uart_t *)uart, (const uint8_t *)data, len);
 }
+
+system_error_t uart_tx_buffer_init(const uart_t *uart, uint8_t *buffer,
+                                   size_t size, uart_tx_overflow_t overflow) {
+  if (uart == NULL || buffer == NULL || size == 0) {
+    return kErrorUartInvalidArgument;
+  }
+
+  uint32_t mstatus = uart_lock();
+  uart_tx_periph = *uart;
+  uart_tx_buf = buffer;
+  uart_tx_size = size;
+  uart_tx_head = 0;
+  uart_tx_count = 0;
+  uart_tx_drop_count = 0;
+  uart_tx_overflow = overflow;
+
+  uart_tx_enable_irq(uart);
+  plic_irq_set_priority(UART_INTR_TX_WATERMARK, 1);
+  plic_irq_set_enabled(UART_INTR_TX_WATERMARK, kPlicToggleEnabled);
+  plic_irq_set_priority(UART_INTR_TX_EMPTY, 1);
+  plic_irq_set_enabled(UART_INTR_TX_EMPTY, kPlicToggleEnabled);
+  CSR_SET_BITS(CSR_REG_MIE, UART_MIE_MEIE);
+
+  uart_unlock(mstatus);
+  return kErrorOk;
+}
+
+bool uart_tx_buffered(void) {
+  return uart_tx_size != 0;
+}
+
+size_t uart_tx_dropped(void) {
+  return uart_tx_drop_count;
+}
+
+void uart_flush(const uart_t *uart) {
+  if (uart_tx_size == 0) {
+    while (!uart_tx_idle(uart)) {
+    }
+    return;
+  }
+
+  uart = &uart_tx_periph;
+  uint32_t mstatus = uart_lock();
+
+  // tx_empty wakes up once the last byte is sent
+  uint32_t reg = mmio_region_read32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET);
+  reg = bitfield_bit32_write(reg, UART_INTR_ENABLE_TX_EMPTY_BIT, true);
+  mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, reg);
+
+  while (uart_tx_count != 0 || !uart_tx_idle(uart)) {
+    uart_sleep(mstatus);
+  }
+
+  reg = bitfield_bit32_write(reg, UART_INTR_ENABLE_TX_EMPTY_BIT, false);
+  mmio_region_write32(uart->base_addr, UART_INTR_ENABLE_REG_OFFSET, reg);
+  uart_unlock(mstatus);
+}
+
+system_error_t uart_rx_buffer_init(const uart_t *uart, uint8_t *buffer,
+                                   size_t size, uint32_t idle_bits) {
+  if (uart == NULL || buffer == NULL || size == 0 ||
+      idle_bits == 0 || idle_bits > UART_TIMEOUT_CTRL_VAL_MASK) {
+    return kErrorUartInvalidArgument;
+  }
+
+  uint32_t mstatus = uart_lock();
+  uart_rx_periph = *uart;
+  uart_rx_buf = buffer;
+  uart_rx_size = size;
+  uart_rx_head = 0;
+  uart_rx_count = 0;
+  uart_rx_overflow_count = 0;
+  uart_rx_idle_bits = idle_bits;
+
+  uart_rx_enable_irq(uart);
+  plic_irq_set_priority(UART_INTR_RX_WATERMARK, 1);
+  plic_irq_set_enabled(UART_INTR_RX_WATERMARK, kPlicToggleEnabled);
+  plic_irq_set_priority(UART_INTR_RX_TIMEOUT, 1);
+  plic_irq_set_enabled(UART_INTR_RX_TIMEOUT, kPlicToggleEnabled);
+  plic_irq_set_priority(UART_INTR_RX_OVERFLOW, 1);
+  plic_irq_set_enabled(UART_INTR_RX_OVERFLOW, kPlicToggleEnabled);
+  CSR_SET_BITS(CSR_REG_MIE, UART_MIE_MEIE);
+
+  uart_unlock(mstatus);
+  return kErrorOk;
+}
+
+void uart_rx_set_idle_callback(uart_rx_callback_t cb, void *ctx) {
+  uint32_t mstatus = uart_lock();
+  uart_rx_idle_cb = cb;
+  uart_rx_idle_ctx = ctx;
+  uart_unlock(mstatus);
+}
+
+size_t uart_rx_available(void) {
+  if (uart_rx_size == 0) {
+    return 0;
+  }
+
+  uint32_t mstatus = uart_lock();
+  uart_rx_drain();
+  size_t count = uart_rx_count;
+  uart_unlock(mstatus);
+  return count;
+}
+
+size_t uart_rx_overflows(void) {
+  return uart_rx_overflow_count;
+}
+
+void uart_irq_handler(void) {
+  // Clear the events before servicing the FIFOs, so the next watermark
+  // crossing raises the interrupt again
+  if (uart_tx_size != 0) {
+    uint32_t reg = 0;
+    reg = bitfield_bit32_write(reg, UART_INTR_STATE_TX_WATERMARK_BIT, true);
+    reg = bitfield_bit32_write(reg, UART_INTR_STATE_TX_EMPTY_BIT, true);
+    mmio_region_write32(uart_tx_periph.base_addr, UART_INTR_STATE_REG_OFFSET, reg);
+    uart_tx_fill();
+  }
+
+  if (uart_rx_size != 0) {
+    uint32_t state = mmio_region_read32(uart_rx_periph.base_addr, UART_INTR_STATE_REG_OFFSET);
+    uint32_t reg = 0;
+    reg = bitfield_bit32_write(reg, UART_INTR_STATE_RX_WATERMARK_BIT, true);
+    reg = bitfield_bit32_write(reg, UART_INTR_STATE_RX_TIMEOUT_BIT, true);
+    reg = bitfield_bit32_write(reg, UART_INTR_STATE_RX_OVERFLOW_BIT, true);
+    mmio_region_write32(uart_rx_periph.base_addr, UART_INTR_STATE_REG_OFFSET, reg);
+    uart_rx_drain();
+
+    if (bitfield_bit32_read(state, UART_INTR_STATE_RX_OVERFLOW_BIT)) {
+      uart_rx_overflow_count++;
+    }
+    // The line is idle, e.g. at the end of a frame
+    if (bitfield_bit32_read(state, UART_INTR_STATE_RX_TIMEOUT_BIT) &&
+        uart_rx_idle_cb != NULL) {
+      uart_rx_idle_cb(uart_rx_idle_ctx);
+    }
+  }
+}
+
+// Serviced from the PLIC interrupt of the UART, before the user handler_irq_uart
+void plic_driver_irq_uart(void) {
+  uart_irq_handler();
+}
@@ -8,6 +8,7 @@
 #ifndef _DRIVERS_UART_H_
 #define _DRIVERS_UART_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -37,6 +38,29 @@ typedef struct uart {
   uint32_t clk_freq_hz;
 } uart_t;
 
+/**
+ * What uart_write does when the TX buffer is full (see uart_tx_buffer_init).
+ */
+typedef enum uart_tx_overflow {
+  /**
+   * Wait for the interrupt handler to make room.
+   */
+  kUartTxOverflowBlock = 0,
+  /**
+   * Drop the bytes that do not fit.
+   */
+  kUartTxOverflowDrop = 1,
+  /**
+   * Drop the oldest bytes of the buffer to make room.
+   */
+  kUartTxOverflowOverwrite = 2,
+} uart_tx_overflow_t;
+
+/**
+ * Called from the UART interrupt handler when the RX line is idle.
+ */
+typedef void (*uart_rx_callback_t)(void *ctx);
+
 /**
  * Initialize the UART with the request parameters.
  *
@@ -46,7 +70,7 @@ typedef struct uart {
 system_error_t uart_init(const uart_t *uart);
 
 /**
- * Write a single byte to the UART.
+ * Write a single byte to the UART TX FIFO, waiting only if it is full.
  *
  * @param uart Pointer to uart_t represting the target UART.
  * @param byte Byte to send.
@@ -56,12 +80,16 @@ void uart_putchar(const uart_t *uart, uint8_t byte);
 /**
  * Write a buffer to the UART.
  *
- * Writes the complete buffer to the UART and wait for transmision to complete.
+ * Without TX buffer, writes the complete buffer to the UART and wait for
+ * transmision to complete.
+ * With a TX buffer, copies the data in it and returns, the FIFO is refilled by
+ * the UART interrupts. Waits only if the buffer is full and the overflow policy
+ * is kUartTxOverflowBlock.
  *
  * @param uart Pointer to uart_t represting the target UART.
  * @param data Pointer to buffer to write.
  * @param len Length of the buffer to write.
- * @return Number of bytes written.
+ * @return Number of bytes written, including the ones dropped on overflow.
  */
 size_t uart_write(const uart_t *uart, const uint8_t *data, size_t len);
 
@@ -76,12 +104,114 @@ size_t uart_write(const uart_t *uart, const uint8_t *data, size_t len);
  * @param len Length of the buffer to write.
  * @return Number of bytes written.
  */
+size_t uart_sink(void *uart, const char *data, size_t len);
 
+/**
+ * Read a single byte, waiting for it.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param data Pointer to the byte read.
+ * @return Number of bytes read.
+ */
 size_t uart_getchar(const uart_t *uart, uint8_t *data);
 
-size_t uart_read(const uart_t *uart, const uint8_t *data, size_t len);
+/**
+ * Read the bytes already received, without waiting. They are taken from the
+ * RX buffer if there is one (see uart_rx_buffer_init), from the RX FIFO
+ * otherwise.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param data Pointer to buffer to read into.
+ * @param len Maximum number of bytes to read.
+ * @return Number of bytes read, can be 0.
+ */
+size_t uart_read(const uart_t *uart, uint8_t *data, size_t len);
+
+/**
+ * Buffer the data of uart_write, the TX FIFO is refilled by the tx_watermark
+ * interrupt. Enables the UART TX interrupts in the UART and in the PLIC, and
+ * the machine external interrupt (mie.MEIE). Machine-level interrupts still have
+ * to be enabled globally (mstatus.MIE), without them the FIFO is refilled by
+ * uart_write and uart_flush only.
+ * The UART must be initialized (uart_init). There is one TX buffer, for the
+ * UART given.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param buffer Memory of the buffer, owned by the driver from now on.
+ * @param size Size of the buffer in bytes.
+ * @param overflow What uart_write does when the buffer is full.
+ * @return kErrorOk if successful, else an error code.
+ */
+system_error_t uart_tx_buffer_init(const uart_t *uart, uint8_t *buffer,
+                                   size_t size, uart_tx_overflow_t overflow);
 
-size_t uart_sink(void *uart, const char *data, size_t len);
+/**
+ * Check if uart_write goes through the TX buffer.
+ */
+bool uart_tx_buffered(void);
+
+/**
+ * Number of bytes dropped by the overflow policy since uart_tx_buffer_init.
+ */
+size_t uart_tx_dropped(void);
+
+/**
+ * Wait for the buffered data to be sent and the transmitter to be idle,
+ * sleeping until the tx_watermark or tx_empty interrupts if interrupts are
+ * enabled.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ */
+void uart_flush(const uart_t *uart);
+
+/**
+ * Receive in a ring buffer, emptied from the RX FIFO by the rx_watermark
+ * (half full FIFO) and rx_timeout (idle line) interrupts. Enables them in the
+ * UART and in the PLIC, and the machine external interrupt (mie.MEIE).
+ * Machine-level interrupts still have to be enabled globally (mstatus.MIE).
+ * When the buffer is full the bytes stay in the RX FIFO, then are lost when it
+ * overflows (see uart_rx_overflows).
+ * The UART must be initialized (uart_init). There is one RX buffer, for the
+ * UART given.
+ *
+ * @param uart Pointer to uart_t represting the target UART.
+ * @param buffer Memory of the buffer, owned by the driver from now on.
+ * @param size Size of the buffer in bytes.
+ * @param idle_bits Bit times without a new byte after which the line is idle
+ * and the RX FIFO is emptied, e.g. 40 for 4 characters.
+ * @return kErrorOk if successful, else an error code.
+ */
+system_error_t uart_rx_buffer_init(const uart_t *uart, uint8_t *buffer,
+                                   size_t size, uint32_t idle_bits);
+
+/**
+ * Call `cb` from the interrupt handler each time the RX line becomes idle,
+ * with the received bytes already in the RX buffer, e.g. to process a
+ * complete frame. NULL to remove it.
+ *
+ * @param cb Callback.
+ * @param ctx Argument given to the callback.
+ */
+void uart_rx_set_idle_callback(uart_rx_callback_t cb, void *ctx);
+
+/**
+ * Number of bytes that uart_read can return right away, 0 without RX buffer.
+ */
+size_t uart_rx_available(void);
+
+/**
+ * Number of RX FIFO overflows since uart_rx_buffer_init, at least one byte
+ * was lost for each.
+ */
+size_t uart_rx_overflows(void);
+
+/**
+ * Refills the TX FIFO from the TX buffer and empties the RX FIFO into the RX
+ * buffer.
+ * Called through the plic_driver_irq_uart hook of the PLIC interrupt handler,
+ * before handler_irq_uart.
+ */
+void uart_irq_handler(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,256 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bank_heap.h"
+
+#define BANK_HEAP_NUM_BANKS RAM_BANKS_DATA
+
+// Free blocks are kept in one address ordered list per bank. Allocated blocks
+// keep the header, only the size is used.
+typedef struct bank_heap_block {
+  uint32_t size;
+  struct bank_heap_block *next;
+} bank_heap_block_t;
+
+#define BANK_HEAP_HEADER_SIZE sizeof(bank_heap_block_t)
+// Do not split a free block if what is left cannot hold a header and a word
+#define BANK_HEAP_MIN_SPLIT (BANK_HEAP_HEADER_SIZE + BANK_HEAP_ALIGN)
+
+typedef struct bank_heap_bank {
+  uintptr_t start;
+  uintptr_t end;
+  bank_heap_block_t *free_list;
+  uint32_t used;
+  uint32_t allocations;
+  bool pinned;
+  power_manager_sel_state_t state;
+} bank_heap_bank_t;
+
+static const uint32_t bank_heap_bank_starts[] = RAM_BANK_START_ADDRESSES;
+static const uint32_t bank_heap_bank_sizes[] = RAM_BANK_SIZES;
+
+static bank_heap_bank_t bank_heap_banks[BANK_HEAP_NUM_BANKS];
+static power_manager_t bank_heap_power_manager;
+static power_manager_counters_t bank_heap_counters;
+
+// End of the static data, the stack is after the heap sections unless it has
+// its own bank
+#ifdef RAM_STACK_BANK
+extern char __heap_end[];
+#define BANK_HEAP_STATIC_END ((uintptr_t)__heap_end)
+#else
+extern char __stack_end[];
+#define BANK_HEAP_STATIC_END ((uintptr_t)__stack_end)
+#endif
+
+static inline uintptr_t bank_heap_align(uintptr_t value) {
+  return (value + BANK_HEAP_ALIGN - 1) & ~(uintptr_t)(BANK_HEAP_ALIGN - 1);
+}
+
+static inline bool bank_heap_managed(const bank_heap_bank_t *bank) {
+  return bank->end > bank->start;
+}
+
+static void bank_heap_reset_bank(bank_heap_bank_t *bank) {
+  bank->free_list = NULL;
+  bank->used = 0;
+  bank->allocations = 0;
+  if (bank->end - bank->start >= BANK_HEAP_MIN_SPLIT) {
+    bank->free_list = (bank_heap_block_t *)bank->start;
+    bank->free_list->size = bank->end - bank->start;
+    bank->free_list->next = NULL;
+  }
+}
+
+static void bank_heap_set_state(uint32_t index, power_manager_sel_state_t state) {
+  bank_heap_bank_t *bank = &bank_heap_banks[index];
+
+  if (bank->state == state) {
+    return;
+  }
+  // Leave the previous state first
+  if (bank->state == kRetOn_e) {
+    power_gate_ram_block(&bank_heap_power_manager, index, kRetOff_e,
+                         &bank_heap_counters);
+  } else if (bank->state == kOff_e) {
+    power_gate_ram_block(&bank_heap_power_manager, index, kOn_e,
+                         &bank_heap_counters);
+    while (ram_block_power_domain_is_off(&bank_heap_power_manager, index))
+      ;
+  }
+  if (state == kOff_e) {
+    power_gate_ram_block(&bank_heap_power_manager, index, kOff_e,
+                         &bank_heap_counters);
+  } else if (state == kRetOn_e) {
+    power_gate_ram_block(&bank_heap_power_manager, index, kRetOn_e,
+                         &bank_heap_counters);
+  }
+  bank->state = state;
+}
+
+static void *bank_heap_alloc_from(uint32_t index, uint32_t size) {
+  bank_heap_bank_t *bank = &bank_heap_banks[index];
+  bank_heap_block_t **prev = &bank->free_list;
+
+  // A released bank is empty, switch it on only if the block fits
+  if (bank->state != kOn_e) {
+    if (bank->end - bank->start < size) {
+      return NULL;
+    }
+    bank_heap_set_state(index, kOn_e);
+    bank_heap_reset_bank(bank);
+  }
+
+  for (bank_heap_block_t *block = bank->free_list; block != NULL;
+       prev = &block->next, block = block->next) {
+    if (block->size < size) {
+      continue;
+    }
+    if (block->size - size >= BANK_HEAP_MIN_SPLIT) {
+      bank_heap_block_t *rest = (bank_heap_block_t *)((uintptr_t)block + size);
+      rest->size = block->size - size;
+      rest->next = block->next;
+      block->size = size;
+      *prev = rest;
+    } else {
+      *prev = block->next;
+    }
+    bank->used += block->size;
+    bank->allocations++;
+    return (void *)((uintptr_t)block + BANK_HEAP_HEADER_SIZE);
+  }
+  return NULL;
+}
+
+void bank_heap_init(const power_manager_t *power_manager,
+                    const power_manager_counters_t *counters) {
+  uintptr_t static_end = bank_heap_align(BANK_HEAP_STATIC_END);
+
+  bank_heap_power_manager = *power_manager;
+  bank_heap_counters = *counters;
+
+  for (uint32_t i = 0; i < BANK_HEAP_NUM_BANKS; i++) {
+    bank_heap_bank_t *bank = &bank_heap_banks[i];
+    uintptr_t end = bank_heap_bank_starts[i] + bank_heap_bank_sizes[i];
+
+    bank->start = bank_heap_bank_starts[i];
+    bank->end = end;
+    bank->pinned = false;
+    bank->state = kOn_e;
+    if (static_end >= end) {
+      // Only static data in this bank
+      bank->end = bank->start;
+      bank->pinned = true;
+    } else if (static_end > bank->start) {
+      bank->start = static_end;
+      bank->pinned = true;
+    }
+    bank_heap_reset_bank(bank);
+  }
+}
+
+void *bank_heap_alloc(size_t size) {
+  if (size == 0) {
+    return NULL;
+  }
+  uint32_t block_size = bank_heap_align(size + BANK_HEAP_HEADER_SIZE);
+
+  // Lowest bank first, so that the last ones stay empty
+  for (uint32_t i = 0; i < BANK_HEAP_NUM_BANKS; i++) {
+    if (!bank_heap_managed(&bank_heap_banks[i])) {
+      continue;
+    }
+    void *ptr = bank_heap_alloc_from(i, block_size);
+    if (ptr != NULL) {
+      return ptr;
+    }
+  }
+  return NULL;
+}
+
+void bank_heap_free(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+  bank_heap_block_t *block =
+      (bank_heap_block_t *)((uintptr_t)ptr - BANK_HEAP_HEADER_SIZE);
+  bank_heap_bank_t *bank = NULL;
+
+  for (uint32_t i = 0; i < BANK_HEAP_NUM_BANKS; i++) {
+    if ((uintptr_t)block >= bank_heap_banks[i].start &&
+        (uintptr_t)block < bank_heap_banks[i].end) {
+      bank = &bank_heap_banks[i];
+      break;
+    }
+  }
+  if (bank == NULL) {
+    return;
+  }
+
+  bank->used -= block->size;
+  bank->allocations--;
+
+  // Insert in address order and merge with the neighbours
+  bank_heap_block_t *prev = NULL;
+  bank_heap_block_t *next = bank->free_list;
+  while (next != NULL && next < block) {
+    prev = next;
+    next = next->next;
+  }
+  if (next != NULL && (uintptr_t)block + block->size == (uintptr_t)next) {
+    block->size += next->size;
+    block->next = next->next;
+  } else {
+    block->next = next;
+  }
+  if (prev != NULL && (uintptr_t)prev + prev->size == (uintptr_t)block) {
+    prev->size += block->size;
+    prev->next = block->next;
+  } else if (prev != NULL) {
+    prev->next = block;
+  } else {
+    bank->free_list = block;
+  }
+}
+
+uint32_t bank_heap_num_banks(void) { return BANK_HEAP_NUM_BANKS; }
+
+bool bank_heap_bank_info(uint32_t bank, bank_heap_bank_info_t *info) {
+  if (bank >= BANK_HEAP_NUM_BANKS ||
+      !bank_heap_managed(&bank_heap_banks[bank])) {
+    return false;
+  }
+  info->heap_size = bank_heap_banks[bank].end - bank_heap_banks[bank].start;
+  info->used = bank_heap_banks[bank].used;
+  info->allocations = bank_heap_banks[bank].allocations;
+  info->pinned = bank_heap_banks[bank].pinned;
+  info->state = bank_heap_banks[bank].state;
+  return true;
+}
+
+uint32_t bank_heap_compact_and_release(power_manager_sel_state_t state) {
+  uint32_t released = 0;
+
+  if (state != kOff_e && state != kRetOn_e) {
+    return 0;
+  }
+
+  for (uint32_t i = 0; i < BANK_HEAP_NUM_BANKS; i++) {
+    bank_heap_bank_t *bank = &bank_heap_banks[i];
+    if (!bank_heap_managed(bank) || bank->allocations != 0) {
+      continue;
+    }
+    // The free blocks of an empty bank are merged anyway, start over clean
+    if (bank->state == kOn_e) {
+      bank_heap_reset_bank(bank);
+    }
+    // Switching an off bank to retention would only increase the leakage
+    if (bank->pinned || bank->state == state || bank->state == kOff_e) {
+      continue;
+    }
+    bank_heap_set_state(i, state);
+    released++;
+  }
+  return released;
+}
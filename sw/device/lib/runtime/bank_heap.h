@@ -0,0 +1,114 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _RUNTIME_BANK_HEAP_H_
+#define _RUNTIME_BANK_HEAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core_v_mini_mcu.h"
+#include "power_manager.h"
+
+/**
+ * Bank-aware heap.
+ *
+ * The heap covers the continuous RAM banks after the static data and the
+ * stack (and before the banks with their own linker section). Allocations
+ * never span two banks and are served from the lowest bank with enough free
+ * space, so the higher banks stay empty as long as possible and can be
+ * switched off with bank_heap_compact_and_release().
+ *
+ * The heap is not reentrant, do not use it from interrupt handlers.
+ */
+
+/**
+ * Alignment of the returned pointers.
+ */
+#define BANK_HEAP_ALIGN 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Occupancy of one bank.
+ */
+typedef struct bank_heap_bank_info {
+  /**
+   * Bytes of the bank managed by the heap (less than the bank size for the
+   * bank holding the end of the static data).
+   */
+  uint32_t heap_size;
+  /**
+   * Bytes allocated, headers included.
+   */
+  uint32_t used;
+  /**
+   * Number of live allocations.
+   */
+  uint32_t allocations;
+  /**
+   * The bank also holds static data or the stack and is never released.
+   */
+  bool pinned;
+  /**
+   * Current state of the bank: kOn_e, kOff_e or kRetOn_e.
+   */
+  power_manager_sel_state_t state;
+} bank_heap_bank_info_t;
+
+/**
+ * Initialize the heap. All the banks are expected to be on.
+ * @param power_manager Pointer to power_manager_t represting the power
+ * manager, used to release the empty banks.
+ * @param counters Counters used to switch the banks on and off.
+ */
+void bank_heap_init(const power_manager_t *power_manager,
+                    const power_manager_counters_t *counters);
+
+/**
+ * Allocate memory, switching on the bank it is taken from if it was
+ * released.
+ * @param size Number of bytes.
+ * @return Pointer aligned to BANK_HEAP_ALIGN, NULL if no bank has a free
+ * block large enough.
+ */
+void *bank_heap_alloc(size_t size);
+
+/**
+ * Free memory returned by bank_heap_alloc. Adjacent free blocks are merged.
+ * @param ptr Pointer returned by bank_heap_alloc, can be NULL.
+ */
+void bank_heap_free(void *ptr);
+
+/**
+ * Number of RAM banks, the bank index is the same as the power manager one.
+ */
+uint32_t bank_heap_num_banks(void);
+
+/**
+ * Get the occupancy of a bank.
+ * @param bank Bank index.
+ * @param info Filled with the bank occupancy.
+ * @return false if the bank is not managed by the heap.
+ */
+bool bank_heap_bank_info(uint32_t bank, bank_heap_bank_info_t *info);
+
+/**
+ * Reset the free list of the banks without live allocations and switch them
+ * off (kOff_e) or put them in retention (kRetOn_e) through the power manager.
+ * They are switched back on by the next allocation taken from them. Banks
+ * already off are left off. The banks holding static data are never released.
+ * @param state kOff_e or kRetOn_e.
+ * @return The number of banks released by this call.
+ */
+uint32_t bank_heap_compact_and_release(power_manager_sel_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _RUNTIME_BANK_HEAP_H_
@@ -10,6 +10,56 @@ extern "C" {
 #endif  // __cplusplus
 
 #define MEMORY_BANKS ${ram_numbanks}
+#define MEMORY_BANKS_IL ${ram_numbanks_il}
+
+#define RAM_START_ADDRESS 0x${'{:08X}'.format(int(ram_start_address,16))}
+#define RAM_SIZE 0x${ram_size_address}
+#define RAM_END_ADDRESS (RAM_START_ADDRESS + RAM_SIZE)
+
+//the interleaved banks all start at the interleaved region and hold one word every MEMORY_BANKS_IL words
+% for bank in range(ram_numbanks):
+#define RAM${bank}_START_ADDRESS 0x${'{:08X}'.format(ram_bank_start_addresses[bank])}
+#define RAM${bank}_SIZE 0x${'{:08X}'.format(ram_bank_sizes[bank])}
+% if bank < ram_numbanks_cont:
+#define RAM${bank}_END_ADDRESS (RAM${bank}_START_ADDRESS + RAM${bank}_SIZE)
+% endif
+% endfor
+
+//continuous banks only, as arrays initializers
+#define RAM_BANK_START_ADDRESSES {${', '.join('0x{:08X}'.format(ram_bank_start_addresses[bank]) for bank in range(ram_numbanks_cont))}}
+#define RAM_BANK_SIZES {${', '.join('0x{:08X}'.format(ram_bank_sizes[bank]) for bank in range(ram_numbanks_cont))}}
+//continuous banks before the ones with their own linker section
+#define RAM_BANKS_DATA ${linker_onchip_banks[0] if len(linker_onchip_banks) > 0 else ram_numbanks_cont}
+% if ram_numbanks_il != 0:
+
+#define RAM_IL_START_ADDRESS 0x${'{:08X}'.format(ram_il_start_address)}
+#define RAM_IL_SIZE 0x${'{:08X}'.format(ram_il_size)}
+#define RAM_IL_END_ADDRESS (RAM_IL_START_ADDRESS + RAM_IL_SIZE)
+% endif
+
+//place a buffer in a bank that has its own section in the on-chip linker script (linker_script.onchip_ls.banks),
+//e.g. uint32_t buffer[256] RAM_BANK_SECTION(3);
+//the section is not loaded: the buffer is neither initialized nor zeroed
+#define RAM_BANK_SECTION(bank) __attribute__((section(".bank" #bank), aligned(4)))
+//same for initialized data, which is part of the images (and copied at boot with the flash linker scripts)
+#define RAM_BANK_DATA_SECTION(bank) __attribute__((section(".bank_data" #bank), aligned(4)))
+% for bank in linker_onchip_banks:
+#define RAM_BANK${bank}_HAS_SECTION
+% endfor
+% if linker_onchip_stack_bank != -1:
+#define RAM_STACK_BANK ${linker_onchip_stack_bank}
+% endif
+
+//place a variable in the interleaved banks
+#define RAM_IL_SECTION __attribute__((section(".data_interleaved"), aligned(4)))
+
+//run a function from RAM when executing from flash (LINKER=flash_exec), it is copied by crt0.S,
+//e.g. __ramfunc void filter(int16_t *samples, uint32_t len);
+//functions it calls are not moved and need their own __ramfunc
+#define __ramfunc __attribute__((section(".ramfunc"), noinline, aligned(4)))
+
+//code overlays of the flash_load linker script (linker_script.flash_load_ls.overlays), see overlay.h
+#define FLASH_LOAD_OVERLAYS ${linker_flash_load_overlays}
 
 #define DEBUG_START_ADDRESS 0x${debug_start_address}
 #define DEBUG_SIZE 0x${debug_size_address}
@@ -51,6 +101,16 @@ extern "C" {
 #define FLASH_MEM_START_ADDRESS 0x${flash_mem_start_address}
 #define FLASH_MEM_SIZE 0x${flash_mem_size_address}
 #define FLASH_MEM_END_ADDRESS (FLASH_MEM_START_ADDRESS + FLASH_MEM_SIZE)
+#define FLASH_CACHE_SIZE ${flash_cache_size}
+#define FLASH_CACHE_LINE_SIZE ${flash_cache_line_size}
+
+//boot header of the flash_load images (LINKER=flash_load), written by the linker script in the unused
+//space before the boot address: the boot ROM copies the whole image, of the size given, in one go
+#define FLASH_BOOT_HEADER_ADDRESS 0x170
+#define FLASH_BOOT_HEADER_MAGIC 0x50454548
+//header of the images compressed by util/compress_flash_image.py (COMPRESS=1): magic, image size,
+//LZ4 data size, then the LZ4 data, inflated by the boot ROM
+#define FLASH_BOOT_HEADER_MAGIC_LZ4 0x5A454548
 
 % for key, value in interrupts.items():
 #define ${key.upper()} ${value}
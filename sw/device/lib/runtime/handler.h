@@ -32,7 +32,17 @@ typedef enum exc_id {
 // You only need to use this ABI for handlers that are the first function called
 // in an interrupt handler. Subsequent functions can just use the regular RISC-V
 // calling convention.
+//
+// When executing from flash with RAM_VECTORS, the vectors are copied to RAM and
+// the handlers are placed in the .ramfunc section so that the jump reaches them.
+// A handler overriding a weak one must then be declared with this ABI, e.g. by
+// including this header.
+#if defined(FLASH_EXEC) && defined(RAM_VECTORS)
+#define INTERRUPT_HANDLER_ABI \
+  __attribute__((aligned(4), interrupt, section(".ramfunc")))
+#else
 #define INTERRUPT_HANDLER_ABI __attribute__((aligned(4), interrupt))
+#endif
 
 // The following `handler_*` functions have weak definitions, provided by
 // `handler.c`. This weak definition can be overriden at link-time by providing
@@ -0,0 +1,122 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "overlay.h"
+
+#include <stddef.h>
+
+#include "core_v_mini_mcu.h"
+#include "csr.h"
+#include "spi_flash.h"
+
+// mstatus.MIE
+#define OVERLAY_MSTATUS_MIE (1 << 3)
+
+#define OVERLAY_NUM (FLASH_LOAD_OVERLAYS > 0 ? FLASH_LOAD_OVERLAYS : 1)
+
+static overlay_stats_t overlay_stats[OVERLAY_NUM];
+static int32_t overlay_loaded = OVERLAY_NONE;
+
+#if defined(FLASH_LOAD) && FLASH_LOAD_OVERLAYS != 0
+
+/**
+ * Entry of the table written by the flash_load linker script.
+ */
+typedef struct overlay_entry {
+  uint32_t flash_addr;
+  uint32_t size;
+} overlay_entry_t;
+
+extern const overlay_entry_t __overlay_table[];
+extern uint32_t __overlay_window_start[];
+
+/**
+ * FLASH read with the SPI flash host, at the clock and chip select set up by
+ * the boot ROM. The RX FIFO is emptied by the DMA if it is idle, by the CPU
+ * otherwise.
+ */
+static const spi_flash_t overlay_flash = {
+    .spi = {.base_addr = {.base = (void *)SPI_FLASH_START_ADDRESS}},
+    .csid = 0,
+    .use_dma = true,
+    .size = FLASH_MEM_SIZE,
+};
+
+bool overlay_load(uint32_t id) {
+  uint32_t mstatus, start, end;
+
+  if (id >= FLASH_LOAD_OVERLAYS) {
+    return false;
+  }
+  overlay_stats[id].requests++;
+  if (overlay_loaded == (int32_t)id) {
+    return true;
+  }
+
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  CSR_CLEAR_BITS(CSR_REG_MSTATUS, OVERLAY_MSTATUS_MIE);
+  // count the load cycles
+  CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, 0x1);
+  CSR_READ(CSR_REG_MCYCLE, &start);
+
+  // the window holds no whole overlay until the copy is done
+  overlay_loaded = OVERLAY_NONE;
+  if (__overlay_table[id].size != 0) {
+    spi_flash_read(&overlay_flash,
+                   __overlay_table[id].flash_addr - FLASH_MEM_START_ADDRESS,
+                   __overlay_window_start, __overlay_table[id].size,
+                   kSpiFlashReadStandard);
+  }
+  // fence.i, encoded to build without zifencei in -march, drops the
+  // instructions already fetched from the window
+  asm volatile(".word 0x0000100f" ::: "memory");
+  overlay_loaded = id;
+
+  CSR_READ(CSR_REG_MCYCLE, &end);
+  overlay_stats[id].loads++;
+  overlay_stats[id].cycles += end - start;
+
+  if (mstatus & OVERLAY_MSTATUS_MIE) {
+    CSR_SET_BITS(CSR_REG_MSTATUS, OVERLAY_MSTATUS_MIE);
+  }
+  return true;
+}
+
+uint32_t overlay_get_size(uint32_t id) {
+  if (id >= FLASH_LOAD_OVERLAYS) {
+    return 0;
+  }
+  return __overlay_table[id].size;
+}
+
+#else
+
+// The overlays are linked with the resident code, there is nothing to load.
+bool overlay_load(uint32_t id) {
+  if (id >= FLASH_LOAD_OVERLAYS) {
+    return false;
+  }
+  overlay_stats[id].requests++;
+  overlay_loaded = id;
+  return true;
+}
+
+uint32_t overlay_get_size(uint32_t id) { return 0; }
+
+#endif  // FLASH_LOAD && FLASH_LOAD_OVERLAYS != 0
+
+int32_t overlay_get_loaded(void) { return overlay_loaded; }
+
+void overlay_get_stats(uint32_t id, overlay_stats_t *stats) {
+  if (id >= FLASH_LOAD_OVERLAYS) {
+    return;
+  }
+  *stats = overlay_stats[id];
+}
+
+void overlay_clear_stats(void) {
+  for (uint32_t i = 0; i < OVERLAY_NUM; ++i) {
+    overlay_stats[i] = (overlay_stats_t){0};
+  }
+}
@@ -0,0 +1,111 @@
+// Copyright EPFL contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _RUNTIME_OVERLAY_H_
+#define _RUNTIME_OVERLAY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core_v_mini_mcu.h"
+
+/**
+ * Code overlays for firmware larger than the RAM (LINKER=flash_load).
+ *
+ * The flash_load linker script links the FLASH_LOAD_OVERLAYS overlays
+ * (linker_script.flash_load_ls.overlays in mcu_cfg.hjson) to run in the same
+ * RAM window and stores them in the FLASH after the image copied at boot.
+ * overlay_load() copies an overlay from the FLASH into the window with the
+ * SPI flash host and the DMA, replacing the one loaded before.
+ *
+ * An overlay holds the functions and constants declared with __overlay(id).
+ * Only one overlay is in RAM at a time, so overlays cannot call each other
+ * (the linker rejects it) and their functions must not be running, nor
+ * pointed to, when another overlay is loaded, e.g. from an interrupt handler.
+ *
+ * With the other linker scripts the overlays are linked with the resident
+ * code and overlay_load() only counts the calls. FLASH_LOAD_OVERLAYS is 0 by
+ * default: the __overlay() functions are then resident with every linker
+ * script and overlay_load() rejects every overlay.
+ */
+
+/**
+ * Place a function or a constant in an overlay, e.g.
+ * __overlay(1) void fft(int32_t *samples, uint32_t len);
+ */
+#define __overlay(id) \
+  __attribute__((section(".overlay" #id), noinline, aligned(4)))
+
+/**
+ * Load the overlay, if needed, then call one of its functions, e.g.
+ * OVERLAY_CALL(1, fft, samples, 256);
+ */
+#define OVERLAY_CALL(id, fn, ...) (overlay_load(id), fn(__VA_ARGS__))
+
+/**
+ * Returned by overlay_get_loaded() when the window holds no overlay.
+ */
+#define OVERLAY_NONE (-1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Counters of one overlay, counted until cleared with overlay_clear_stats.
+ */
+typedef struct overlay_stats {
+  /**
+   * Calls to overlay_load().
+   */
+  uint32_t requests;
+  /**
+   * Copies from the FLASH, the other requests found the overlay loaded.
+   */
+  uint32_t loads;
+  /**
+   * Cycles spent copying the overlay from the FLASH (mcycle).
+   */
+  uint32_t cycles;
+} overlay_stats_t;
+
+/**
+ * Copy an overlay into the RAM window if it is not already there.
+ * Blocks until the copy is done, with the interrupts disabled.
+ * @param id Overlay number, from 0 to FLASH_LOAD_OVERLAYS-1.
+ * @return false if the overlay does not exist.
+ */
+bool overlay_load(uint32_t id);
+
+/**
+ * Overlay in the RAM window.
+ * @return Overlay number, OVERLAY_NONE if none was loaded.
+ */
+int32_t overlay_get_loaded(void);
+
+/**
+ * Size of an overlay.
+ * @param id Overlay number, from 0 to FLASH_LOAD_OVERLAYS-1.
+ * @return Size in bytes, 0 if the overlay does not exist or is empty.
+ */
+uint32_t overlay_get_size(uint32_t id);
+
+/**
+ * Read the counters of an overlay.
+ * @param id Overlay number, from 0 to FLASH_LOAD_OVERLAYS-1.
+ * @param stats Filled with the counter values, left untouched if the overlay
+ * does not exist.
+ */
+void overlay_get_stats(uint32_t id, overlay_stats_t *stats);
+
+/**
+ * Resets the counters of all the overlays to 0.
+ */
+void overlay_clear_stats(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // _RUNTIME_OVERLAY_H_
@@ -22,6 +22,7 @@
 #include <unistd.h>
 #include <errno.h>
 #include "uart.h"
+#include "dlog.h"
 #include "soc_ctrl.h"
 #include "core_v_mini_mcu.h"
 #include "error.h"
@@ -96,6 +97,13 @@ void _exit(int exit_status)
 {
     soc_ctrl_t soc_ctrl;
     soc_ctrl.base_addr = mmio_region_from_addr((uintptr_t)SOC_CTRL_START_ADDRESS);
+
+    // Send the deferred logs and the bytes still buffered by uart_write
+    uart_t uart;
+    uart.base_addr = mmio_region_from_addr((uintptr_t)UART_START_ADDRESS);
+    dlog_drain(&uart);
+    uart_flush(&uart);
+
     soc_ctrl_set_exit_value(&soc_ctrl, exit_status);
     soc_ctrl_set_valid(&soc_ctrl, (uint8_t)1);
 
@@ -247,7 +255,8 @@ ssize_t _write(int file, const void *ptr, size_t len)
     uart.baudrate    = UART_BAUDRATE;
     uart.clk_freq_hz = soc_ctrl_get_frequency(&soc_ctrl);
 
-    if (uart_init(&uart) != kErrorOk) {
+    // Reinitializing the UART would wait for the buffered bytes to be sent
+    if (!uart_tx_buffered() && uart_init(&uart) != kErrorOk) {
         errno = ENOSYS;
         return -1;
     }
@@ -25,11 +25,17 @@ MEMORY
 % if ram_numbanks_cont > 1 and ram_numbanks_il > 0:
   ram_il (rwxai) : ORIGIN = 0x${linker_onchip_il_start_address}, LENGTH = 0x${linker_onchip_il_size_address}
 % endif  
+% for bank in linker_onchip_banks:
+  ram_bank${bank} (rwxai) : ORIGIN = 0x${'{:08X}'.format(ram_bank_start_addresses[bank])}, LENGTH = 0x${'{:08X}'.format(ram_bank_sizes[bank])}
+% endfor
 }
 
 /*
  * This linker script try to put data in ram1 and code
- * in ram0.
+ * in ram0. The banks listed in mcu_cfg.hjson (linker_script.onchip_ls.banks)
+ * are kept out of ram1 and only hold their .bank_data<N> and .bank<N> sections
+ * (and the stack if stack_bank is set), so the CPU and the DMA can access them
+ * in parallel.
 */
 
 SECTIONS
@@ -42,6 +48,16 @@ SECTIONS
   PROVIDE(__stack_size = __stack_size);
   __heap_size = DEFINED(__heap_size) ? __heap_size : 0x800;
 
+  /* boundaries of the on-chip memory banks */
+% for bank in range(ram_numbanks_cont):
+  PROVIDE(__ram_bank${bank}_start = 0x${'{:08X}'.format(ram_bank_start_addresses[bank])});
+  PROVIDE(__ram_bank${bank}_end = 0x${'{:08X}'.format(ram_bank_start_addresses[bank] + ram_bank_sizes[bank])});
+% endfor
+% if ram_numbanks_il != 0:
+  PROVIDE(__ram_il_start = 0x${'{:08X}'.format(ram_il_start_address)});
+  PROVIDE(__ram_il_end = 0x${'{:08X}'.format(ram_il_start_address + ram_il_size)});
+% endif
+
   /* Read-only sections, merged into text segment: */
   PROVIDE (__executable_start = SEGMENT_START("text-segment", 0x10000)); . = SEGMENT_START("text-segment", 0x10000) + SIZEOF_HEADERS;
 
@@ -111,6 +127,8 @@ SECTIONS
     *(.text.startup .text.startup.*)
     *(.text.hot .text.hot.*)
     *(.text .stub .text.* .gnu.linkonce.t.*)
+    *(.ramfunc .ramfunc.*)  /* __ramfunc functions, already in RAM */
+    *(.overlay*)            /* overlays, always resident */
     /* .gnu.warning sections are handled specially by elf32.em.  */
     *(.gnu.warning)
   } >ram0
@@ -333,14 +351,43 @@ SECTIONS
    PROVIDE(_sp = .);
    PROVIDE(__stack_end = .);
    PROVIDE(__freertos_irq_stack_top = .);
+% if linker_onchip_stack_bank != -1:
+  } >ram_bank${linker_onchip_stack_bank}
+% else:
   } >ram1
+% endif
+
+% for bank in linker_onchip_banks:
+  /* initialized data placed in bank ${bank} with RAM_BANK_DATA_SECTION(${bank}) */
+  .bank_data${bank}    :
+  {
+    . = ALIGN(4);
+    *(.bank_data${bank} .bank_data${bank}.*)
+    . = ALIGN(4);
+  } >ram_bank${bank}
+
+  /* uninitialized buffers placed in bank ${bank} with RAM_BANK_SECTION(${bank}), not in the images */
+  .bank${bank} (NOLOAD) :
+  {
+    . = ALIGN(4);
+    *(.bank${bank} .bank${bank}.*)
+    . = ALIGN(4);
+  } >ram_bank${bank}
 
+% endfor
 % if ram_numbanks_cont > 1 and ram_numbanks_il > 0:
+  /* data placed in the interleaved banks with RAM_IL_SECTION */
   .data_interleaved :
   {
+    . = ALIGN(4);
+    *(.data_interleaved .data_interleaved.*)
+    . = ALIGN(4);
   } >ram_il
 % endif
 
+  /* format strings of the deferred logs (dlog.h), not loaded, read by util/dlog_decode.py */
+  .dlog_fmt 0 (INFO) : { KEEP(*(.dlog_fmt)) }
+
   /* Stabs debugging sections.  */
   .stab          0 : { *(.stab) }
   .stabstr       0 : { *(.stabstr) }
@@ -21,6 +21,16 @@ SECTIONS {
     PROVIDE(__stack_size = __stack_size);
     __heap_size = DEFINED(__heap_size) ? __heap_size : 0x1000;
 
+    /* boundaries of the on-chip memory banks */
+% for bank in range(ram_numbanks_cont):
+    PROVIDE(__ram_bank${bank}_start = 0x${'{:08X}'.format(ram_bank_start_addresses[bank])});
+    PROVIDE(__ram_bank${bank}_end = 0x${'{:08X}'.format(ram_bank_start_addresses[bank] + ram_bank_sizes[bank])});
+% endfor
+% if ram_numbanks_il != 0:
+    PROVIDE(__ram_il_start = 0x${'{:08X}'.format(ram_il_start_address)});
+    PROVIDE(__ram_il_end = 0x${'{:08X}'.format(ram_il_start_address + ram_il_size)});
+% endif
+
     /* interrupt vectors */
     .vectors (ORIGIN(FLASH)):
     {
@@ -41,6 +51,7 @@ SECTIONS {
         . = ALIGN(4);
         *(.text)           /* .text sections (code) */
         *(.text*)          /* .text* sections (code) */
+        *(.overlay*)       /* overlays, always resident */
         *(.rodata)         /* .rodata sections (constants, strings, etc.) */
         *(.rodata*)        /* .rodata* sections (constants, strings, etc.) */
         *(.srodata)        /* .rodata sections (constants, strings, etc.) */
@@ -49,6 +60,21 @@ SECTIONS {
         _etext = .;        /* define a global symbol at end of code */
     } >FLASH
 
+    /* Functions marked __ramfunc, and the vectors with RAM_VECTORS, run from RAM.
+    The loader puts them in the FLASH and the startup copies them to RAM, as for .data. */
+    .ramfunc :
+    {
+        . = ALIGN(4);
+        _siramfunc = LOADADDR(.ramfunc);
+        _sramfunc = .;
+        PROVIDE(__ram_vector_start = .);
+        KEEP(*(.ramfunc.vectors))   /* first, they must be 256-byte aligned */
+        *(.ramfunc)
+        *(.ramfunc.*)
+        . = ALIGN(4);
+        _eramfunc = .;
+    } >RAM AT >FLASH
+
     /* This is the initialized data section
     The program executes knowing that the data is in the RAM
     but the loader puts the initial values in the FLASH (inidata).
@@ -62,7 +88,8 @@ SECTIONS {
         . = ALIGN(4);
         __DATA_BEGIN__ = .;
         *(.data)           /* .data sections */
-        *(.data*)          /* .data* sections */
+        *(.data*)          /* .data* sections, including .data_interleaved */
+        *(.bank_data*)     /* .bank_data<N> sections, not placed in their bank when loaded from flash */
         __SDATA_BEGIN__ = .;
         *(.sdata)           /* .sdata sections */
         *(.sdata*)          /* .sdata* sections */
@@ -92,6 +119,14 @@ SECTIONS {
         __BSS_END__ = .;
     } >RAM
 
+    /* .bank<N> buffers, uninitialized and not placed in their bank when loaded from flash */
+    .bank (NOLOAD) :
+    {
+        . = ALIGN(4);
+        *(.bank*)
+        . = ALIGN(4);
+    } >RAM
+
     /* The compiler uses this to access data in the .sdata, .data, .sbss and .bss
      sections with fewer instructions (relaxation). This reduces code size. */
     __global_pointer$ = MIN(__SDATA_BEGIN__ + 0x800,
@@ -115,4 +150,7 @@ SECTIONS {
    PROVIDE(__stack_end = .);
    PROVIDE(__freertos_irq_stack_top = .);
   } >RAM
+
+  /* format strings of the deferred logs (dlog.h), not loaded, read by util/dlog_decode.py */
+  .dlog_fmt 0 (INFO) : { KEEP(*(.dlog_fmt)) }
 }
@@ -21,6 +21,16 @@ SECTIONS {
     PROVIDE(__stack_size = __stack_size);
     __heap_size = DEFINED(__heap_size) ? __heap_size : 0x1000;
 
+    /* boundaries of the on-chip memory banks */
+% for bank in range(ram_numbanks_cont):
+    PROVIDE(__ram_bank${bank}_start = 0x${'{:08X}'.format(ram_bank_start_addresses[bank])});
+    PROVIDE(__ram_bank${bank}_end = 0x${'{:08X}'.format(ram_bank_start_addresses[bank] + ram_bank_sizes[bank])});
+% endfor
+% if ram_numbanks_il != 0:
+    PROVIDE(__ram_il_start = 0x${'{:08X}'.format(ram_il_start_address)});
+    PROVIDE(__ram_il_end = 0x${'{:08X}'.format(ram_il_start_address + ram_il_size)});
+% endif
+
     /* interrupt vectors */
     .vectors (ORIGIN(RAM)):
     {
@@ -29,10 +39,15 @@ SECTIONS {
         __VECTORS_AT = .;
     } >RAM AT >FLASH
 
-    /* Fill memory up to __boot_address */
+    /* Fill memory up to __boot_address, with the boot header after the vectors:
+    the boot ROM reads the magic word and the image size (FLASH_BOOT_HEADER_* in core_v_mini_mcu.h)
+    and copies the whole image, up to _edata, before jumping to __boot_address */
     .fill :
     {
         FILL(0xDEADBEEF);
+        . = ORIGIN(RAM) + 0x170;
+        LONG(0x50454548);
+        LONG(_edata - ORIGIN(RAM));
         . = ORIGIN(RAM) + (__boot_address) - 1;
         BYTE(0xEE)
     } >RAM AT >FLASH
@@ -50,10 +65,14 @@ SECTIONS {
         . = ALIGN(4);
         *(.text)           /* .text sections (code) */
         *(.text*)          /* .text* sections (code) */
+        *(.ramfunc*)       /* __ramfunc functions, already in RAM */
         *(.rodata)         /* .rodata sections (constants, strings, etc.) */
         *(.rodata*)        /* .rodata* sections (constants, strings, etc.) */
         *(.srodata)        /* .rodata sections (constants, strings, etc.) */
         *(.srodata*)       /* .rodata* sections (constants, strings, etc.) */
+% if linker_flash_load_overlays == 0:
+        *(.overlay*)       /* no overlays configured, always resident */
+% endif
         . = ALIGN(4);
         _etext = .;        /* define a global symbol at end of code */
     } >RAM AT >FLASH
@@ -71,13 +90,37 @@ SECTIONS {
         . = ALIGN(4);
         __DATA_BEGIN__ = .;
         *(.data)           /* .data sections */
-        *(.data*)          /* .data* sections */
+        *(.data*)          /* .data* sections, including .data_interleaved */
+        *(.bank_data*)     /* .bank_data<N> sections, not placed in their bank when loaded from flash */
         __SDATA_BEGIN__ = .;
         *(.sdata)           /* .sdata sections */
         *(.sdata*)          /* .sdata* sections */
+% if linker_flash_load_overlays != 0:
+        /* overlay table used by overlay_load: FLASH address and size of each overlay */
+        . = ALIGN(4);
+        PROVIDE(__overlay_table = .);
+% for ov in range(linker_flash_load_overlays):
+        LONG(__load_start_overlay${ov}); LONG(__load_stop_overlay${ov} - __load_start_overlay${ov});
+% endfor
+% endif
         . = ALIGN(4);
         _edata = .;        /* define a global symbol at data end; used by startup code in order to initialise the .data section in RAM */
     } >RAM AT >FLASH
+% if linker_flash_load_overlays != 0:
+
+    /* Code overlays: all of them are linked to run in the same RAM window after the data.
+    Their content is stored in the FLASH after the initial values of the data, past _edata,
+    so the startup does not copy them: overlay_load copies one into the window when needed.
+    Overlays cannot reference each other, the calls go through resident code. */
+    PROVIDE(__overlay_window_start = .);
+    OVERLAY : NOCROSSREFS
+    {
+% for ov in range(linker_flash_load_overlays):
+        .overlay${ov} { *(.overlay${ov}) *(.overlay${ov}.*) . = ALIGN(4); }
+% endfor
+    } >RAM AT >FLASH
+    PROVIDE(__overlay_window_end = .);
+% endif
 
     .power_manager : ALIGN(4096)
     {
@@ -101,6 +144,14 @@ SECTIONS {
         __BSS_END__ = .;
     } >RAM
 
+    /* .bank<N> buffers, uninitialized and not placed in their bank when loaded from flash */
+    .bank (NOLOAD) :
+    {
+        . = ALIGN(4);
+        *(.bank*)
+        . = ALIGN(4);
+    } >RAM
+
     /* The compiler uses this to access data in the .sdata, .data, .sbss and .bss
      sections with fewer instructions (relaxation). This reduces code size. */
     __global_pointer$ = MIN(__SDATA_BEGIN__ + 0x800,
@@ -124,4 +175,7 @@ SECTIONS {
        PROVIDE(__stack_end = .);
        PROVIDE(__freertos_irq_stack_top = .);
     } >RAM
+
+    /* format strings of the deferred logs (dlog.h), not loaded, read by util/dlog_decode.py */
+    .dlog_fmt 0 (INFO) : { KEEP(*(.dlog_fmt)) }
 }
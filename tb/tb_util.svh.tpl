@@ -75,14 +75,14 @@ task tb_loadHEX;
 
   stimuli_counter = 0;
 % for bank in range(ram_numbanks_cont):
-  for (i = 0; i < NumBytes / NumBanks; i = i + 4) begin
+  for (i = 0; i < core_v_mini_mcu_pkg::BANK_SIZE[${bank}]; i = i + 4) begin
     tb_writetoSram${bank}(i / 4, stimuli[stimuli_counter+3], stimuli[stimuli_counter+2],
                    stimuli[stimuli_counter+1], stimuli[stimuli_counter]);
     stimuli_counter = stimuli_counter + 4;
   end
 % endfor
 % if ram_numbanks_il != 0:
-  for (i = 0; i < NumBytes / NumBanks; i = i + 4) begin
+  for (i = 0; i < core_v_mini_mcu_pkg::BANK_SIZE[${ram_numbanks_cont}]; i = i + 4) begin
 % for bank in range(ram_numbanks_il):
     tb_writetoSram${int(ram_numbanks_cont) + bank}(i / 4, stimuli[stimuli_counter+3], stimuli[stimuli_counter+2],
                     stimuli[stimuli_counter+1], stimuli[stimuli_counter]);
@@ -81,6 +81,8 @@ module testharness #(
   // External xbar slave example port
   obi_req_t slow_ram_slave_req;
   obi_resp_t slow_ram_slave_resp;
+  core_v_mini_mcu_pkg::ext_axi_req_t ext_axi_slave_req;
+  core_v_mini_mcu_pkg::ext_axi_resp_t ext_axi_slave_resp;
 
   // External interrupts
   logic [NEXT_INT_RND-1:0] intr_vector_ext;
@@ -194,6 +196,8 @@ module testharness #(
       .ext_xbar_master_resp_o(master_resp),
       .ext_xbar_slave_req_o(slave_req),
       .ext_xbar_slave_resp_i(slave_resp),
+      .ext_axi_slave_req_o(ext_axi_slave_req),
+      .ext_axi_slave_resp_i(ext_axi_slave_resp),
       .ext_peripheral_slave_req_o(periph_slave_req),
       .ext_peripheral_slave_resp_i(periph_slave_rsp),
       .external_subsystem_powergate_switch_o(external_subsystem_powergate_switch),
@@ -284,22 +288,39 @@ module testharness #(
 
 `ifdef USE_EXTERNAL_DEVICE_EXAMPLE
   // External xbar slave memory example
-  slow_memory #(
-      .NumWords (128),
-      .DataWidth(32'd32)
-  ) slow_ram_i (
-      .clk_i(clk_i),
-      .rst_ni(rst_ni),
-      .req_i(slow_ram_slave_req.req),
-      .we_i(slow_ram_slave_req.we),
-      .addr_i(slow_ram_slave_req.addr[8:2]),
-      .wdata_i(slow_ram_slave_req.wdata),
-      .be_i(slow_ram_slave_req.be),
-      // output ports
-      .gnt_o(slow_ram_slave_resp.gnt),
-      .rdata_o(slow_ram_slave_resp.rdata),
-      .rvalid_o(slow_ram_slave_resp.rvalid)
-  );
+  if (!core_v_mini_mcu_pkg::EXT_SLAVE_AXI) begin : gen_slow_ram
+    slow_memory #(
+        .NumWords (128),
+        .DataWidth(32'd32)
+    ) slow_ram_i (
+        .clk_i(clk_i),
+        .rst_ni(rst_ni),
+        .req_i(slow_ram_slave_req.req),
+        .we_i(slow_ram_slave_req.we),
+        .addr_i(slow_ram_slave_req.addr[8:2]),
+        .wdata_i(slow_ram_slave_req.wdata),
+        .be_i(slow_ram_slave_req.be),
+        // output ports
+        .gnt_o(slow_ram_slave_resp.gnt),
+        .rdata_o(slow_ram_slave_resp.rdata),
+        .rvalid_o(slow_ram_slave_resp.rvalid)
+    );
+    assign ext_axi_slave_resp = '0;
+  end else begin : gen_axi_slow_ram
+    // same 512 bytes on the AXI external slave port
+    axi_slow_memory #(
+        .NumWords  (512 / (core_v_mini_mcu_pkg::EXT_SLAVE_AXI_DATA_WIDTH / 8)),
+        .DataWidth (core_v_mini_mcu_pkg::EXT_SLAVE_AXI_DATA_WIDTH),
+        .axi_req_t (core_v_mini_mcu_pkg::ext_axi_req_t),
+        .axi_resp_t(core_v_mini_mcu_pkg::ext_axi_resp_t)
+    ) axi_slow_ram_i (
+        .clk_i(clk_i),
+        .rst_ni(rst_ni),
+        .axi_req_i(ext_axi_slave_req),
+        .axi_resp_o(ext_axi_slave_resp)
+    );
+    assign slow_ram_slave_resp = '0;
+  end
 
   // External peripheral example with master port to access memory
   dma #(
@@ -318,6 +339,8 @@ module testharness #(
       .dma_master1_ch0_req_o(master_req[testharness_pkg::EXT_MASTER1_IDX]),
       .dma_master1_ch0_resp_i(master_resp[testharness_pkg::EXT_MASTER1_IDX]),
       .trigger_slot_i('0),
+      .ext_start_i(1'b0),
+      .ext_size_i('0),
       .dma_intr_o(memcopy_intr)
   );
 
@@ -414,6 +437,7 @@ module testharness #(
   assign slow_ram_slave_resp.gnt = '0;
   assign slow_ram_slave_resp.rdata = '0;
   assign slow_ram_slave_resp.rvalid = '0;
+  assign ext_axi_slave_resp = '0;
 
   assign ext_periph_slv_req = '0;
   assign ext_periph_slv_rsp = '0;
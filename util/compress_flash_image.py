@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+
+# Copyright 2023 EPFL
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+# Compress a flash_load image (the binary of the FLASH content) for the boot ROM.
+#
+# The part of the image copied at boot, given by the boot header written by
+# link_flash_load.ld, is compressed with LZ4 (block format). The output keeps
+# the boot header address and replaces the header with:
+#   0x170: FLASH_BOOT_HEADER_MAGIC_LZ4
+#   0x174: size of the decompressed image
+#   0x178: size of the compressed data
+#   0x17C: compressed data
+# The rest of the FLASH content (e.g. the overlays) is kept at its address.
+# The boot ROM copies the compressed data in RAM after the decompressed image
+# and inflates it to address 0.
+
+import argparse
+import struct
+import sys
+
+# keep in sync with core_v_mini_mcu.h
+FLASH_BOOT_HEADER_ADDRESS = 0x170
+FLASH_BOOT_HEADER_MAGIC = 0x50454548
+FLASH_BOOT_HEADER_MAGIC_LZ4 = 0x5A454548
+PAYLOAD_ADDRESS = FLASH_BOOT_HEADER_ADDRESS + 12
+
+# LZ4 block format constraints
+MIN_MATCH = 4
+LAST_LITERALS = 5
+MF_LIMIT = 12
+MAX_OFFSET = 0xFFFF
+
+
+def write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz4_compress(data):
+    out = bytearray()
+    table = {}
+    anchor = 0
+    pos = 0
+    end = len(data)
+    match_limit = end - MF_LIMIT
+
+    while pos < match_limit:
+        key = data[pos:pos + MIN_MATCH]
+        ref = table.get(key)
+        table[key] = pos
+        if ref is None or pos - ref > MAX_OFFSET:
+            pos += 1
+            continue
+
+        # extend the match, the last literals stay out of it
+        length = MIN_MATCH
+        while pos + length < end - LAST_LITERALS and data[ref + length] == data[pos + length]:
+            length += 1
+
+        literals = pos - anchor
+        token = (min(literals, 15) << 4) | min(length - MIN_MATCH, 15)
+        out.append(token)
+        if literals >= 15:
+            write_length(out, literals - 15)
+        out += data[anchor:pos]
+        out += struct.pack('<H', pos - ref)
+        if length - MIN_MATCH >= 15:
+            write_length(out, length - MIN_MATCH - 15)
+
+        for i in range(pos + 1, min(pos + length, match_limit)):
+            table[data[i:i + MIN_MATCH]] = i
+        pos += length
+        anchor = pos
+
+    literals = end - anchor
+    out.append(min(literals, 15) << 4)
+    if literals >= 15:
+        write_length(out, literals - 15)
+    out += data[anchor:]
+    return bytes(out)
+
+
+def lz4_decompress(data):
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+        length = token >> 4
+        if length == 15:
+            while True:
+                pos += 1
+                length += data[pos - 1]
+                if data[pos - 1] != 255:
+                    break
+        out += data[pos:pos + length]
+        pos += length
+        if pos >= len(data):
+            break
+        offset = data[pos] | (data[pos + 1] << 8)
+        pos += 2
+        length = token & 15
+        if length == 15:
+            while True:
+                pos += 1
+                length += data[pos - 1]
+                if data[pos - 1] != 255:
+                    break
+        for _ in range(length + MIN_MATCH):
+            out.append(out[-offset])
+    return bytes(out)
+
+
+def write_verilog_hex(path, segments):
+    with open(path, 'w') as f:
+        for address, data in segments:
+            f.write('@%08X\n' % address)
+            for i in range(0, len(data), 16):
+                f.write(' '.join('%02X' % b for b in data[i:i + 16]) + '\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress a flash_load image for the boot ROM')
+    parser.add_argument('bin', help='FLASH image, e.g. main.bin')
+    parser.add_argument('hex', help='compressed FLASH image, in the verilog hex format of objcopy')
+    parser.add_argument('--bin-out', help='compressed FLASH image, binary')
+    parser.add_argument('--ram-size', type=lambda x: int(x, 0),
+                        help='RAM size (RAM_SIZE of core_v_mini_mcu.h), the image and the compressed data must fit in it')
+    args = parser.parse_args()
+
+    with open(args.bin, 'rb') as f:
+        image = f.read()
+
+    magic, size = struct.unpack_from('<II', image, FLASH_BOOT_HEADER_ADDRESS)
+    if magic != FLASH_BOOT_HEADER_MAGIC:
+        sys.exit('%s has no boot header, is it linked with link_flash_load.ld?' % args.bin)
+
+    raw = image[:size]
+    payload = lz4_compress(raw)
+    if lz4_decompress(payload) != raw:
+        sys.exit('LZ4 round trip failed')
+    if PAYLOAD_ADDRESS + len(payload) > size:
+        sys.exit('%s does not compress (%d bytes into %d)' % (args.bin, size, len(payload)))
+
+    # the boot ROM copies the compressed data after the image, both rounded up to words
+    ram_used = ((size + 3) & ~3) + ((len(payload) + 3) & ~3)
+    if args.ram_size is not None and ram_used > args.ram_size:
+        sys.exit('%s: the image and the compressed data need %d bytes of RAM, only %d available' %
+                 (args.bin, ram_used, args.ram_size))
+
+    header = struct.pack('<III', FLASH_BOOT_HEADER_MAGIC_LZ4, size, len(payload))
+    segments = [(FLASH_BOOT_HEADER_ADDRESS, header + payload)]
+    if len(image) > size:
+        segments.append((size, image[size:]))
+    write_verilog_hex(args.hex, segments)
+
+    if args.bin_out:
+        out = bytearray(b'\xff' * len(image))
+        for address, data in segments:
+            out[address:address + len(data)] = data
+        with open(args.bin_out, 'wb') as f:
+            f.write(out)
+
+    print('boot image: %d bytes compressed into %d (%.1f%%)' % (size, len(payload), 100.0 * len(payload) / size))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+
+# Copyright 2023 EPFL
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+
+# Decode the deferred logs of sw/device/lib/dlog.
+#
+# The UART output (e.g. uart0.log of the simulation, or a capture of the
+# serial port) mixes printf text and binary records. A record is a header
+# word followed by its arguments, little endian:
+#   header[31:28] DLOG_SYNC (0xA), never an ASCII character
+#   header[27:24] number of arguments
+#   header[23:0]  offset of the format string in the .dlog_fmt section of the ELF
+# The format strings and the strings given to %s are read from the ELF, the
+# rest of the input is copied as is.
+
+import argparse
+import re
+import struct
+import sys
+
+# keep in sync with dlog.h
+DLOG_SYNC = 0xA
+DLOG_ID_DROPPED = 0xFFFFFF
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# printf conversions, the length modifiers are dropped
+CONVERSION = re.compile(r'%([-+ #0]*)(\d*|\*)(\.\d+)?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+class Elf:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 1 or self.data[5] != 1:
+            sys.exit('%s is not a 32-bit little endian ELF' % path)
+
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+        headers = [struct.unpack_from('<IIIIIIIIII', self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        strtab = headers[shstrndx]
+
+        # name: (type, flags, address, offset, size)
+        self.sections = {}
+        for name, sh_type, flags, addr, offset, size, _, _, _, _ in headers:
+            end = self.data.index(b'\0', strtab[4] + name)
+            self.sections[self.data[strtab[4] + name:end].decode()] = (sh_type, flags, addr, offset, size)
+
+        if '.dlog_fmt' not in self.sections:
+            sys.exit('%s has no .dlog_fmt section, does it use DLOG?' % path)
+
+    def fmt(self, offset):
+        _, _, _, start, size = self.sections['.dlog_fmt']
+        if offset >= size:
+            return None
+        return self.cstring(start + offset)
+
+    def string(self, address):
+        # string of the program, from the sections loaded in memory
+        for sh_type, flags, addr, offset, size in self.sections.values():
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and addr <= address < addr + size:
+                return self.cstring(offset + address - addr)
+        return '<0x%08x>' % address
+
+    def cstring(self, offset):
+        end = self.data.index(b'\0', offset)
+        return self.data[offset:end].decode(errors='replace')
+
+
+def format_record(elf, fmt, args):
+    args = list(args)
+
+    def convert(m):
+        flags, width, precision, _, conv = m.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = str(args.pop(0)) if args else ''
+        value = args.pop(0) if args else 0
+        spec = '%' + flags + width + (precision or '')
+        if conv in 'di':
+            return (spec + 'd') % (value - (1 << 32) if value & 0x80000000 else value)
+        if conv == 'u':
+            return (spec + 'd') % value
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 's':
+            return (spec + 's') % elf.string(value)
+        if conv == 'p':
+            return (spec + 's') % ('0x%08x' % value)
+        return (spec + conv) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(elf, data, out):
+    pos = 0
+    text = bytearray()
+    while pos < len(data):
+        if pos + 4 <= len(data) and data[pos + 3] >> 4 == DLOG_SYNC:
+            header, = struct.unpack_from('<I', data, pos)
+            nargs = (header >> 24) & 0xF
+            offset = header & 0xFFFFFF
+            end = pos + 4 + 4 * nargs
+            fmt = elf.fmt(offset) if offset != DLOG_ID_DROPPED else '[dlog: %u logs dropped]\n'
+            if fmt is not None and end <= len(data):
+                out.write(text.decode(errors='replace'))
+                text.clear()
+                args = struct.unpack_from('<%dI' % nargs, data, pos + 4)
+                out.write(format_record(elf, fmt, args))
+                pos = end
+                continue
+        text.append(data[pos])
+        pos += 1
+    out.write(text.decode(errors='replace'))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the deferred logs of an X-HEEP application')
+    parser.add_argument('elf', help='ELF of the application, e.g. main.elf')
+    parser.add_argument('log', nargs='?', help='UART output, e.g. uart0.log (default: stdin)')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.log:
+        with open(args.log, 'rb') as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+    decode(elf, data, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
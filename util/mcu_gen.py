@@ -315,7 +315,7 @@ def main():
                         metavar="from 2 to 16",
                         nargs='?',
                         default="",
-                        help="Number of 32KB Banks (default value from cfg file)")
+                        help="Number of continuous Banks, sized by ram.bank_size (default value from cfg file)")
 
     parser.add_argument("--memorybanks_il",
                         metavar="0, 2, 4 or 8",
@@ -323,6 +323,12 @@ def main():
                         default="",
                         help="Number of interleaved memory banks (default value from cfg file)")
 
+    parser.add_argument("--tech",
+                        metavar="generic,sky130",
+                        nargs='?',
+                        default="",
+                        help="Technology of the SRAM macros, to check the bank sizes (default generic)")
+
     parser.add_argument("--external_domains",
                         metavar="from 0 to 32",
                         nargs='?',
@@ -400,6 +406,24 @@ def main():
     else:
         bus_type = obj['bus_type']
 
+    # priority (0 to 3) and budget (grants per window, 0 for no limit) of each system bus master,
+    # the external masters share the 'ext' values
+    bus_qos_masters = ['core_instr', 'core_data', 'debug', 'dma_read', 'dma_write', 'ext']
+    bus_qos = obj.get('bus_qos', {})
+    bus_qos_priority = {}
+    bus_qos_budget = {}
+    for master in bus_qos_masters:
+        bus_qos_priority[master] = int(bus_qos.get('priority', {}).get(master, 0))
+        bus_qos_budget[master] = int(bus_qos.get('budget', {}).get(master, 0))
+        if bus_qos_priority[master] < 0 or bus_qos_priority[master] > 3:
+            exit("bus_qos priority of " + master + " must be between 0 and 3 instead of " + str(bus_qos_priority[master]))
+    bus_qos_window = int(bus_qos.get('window', 64))
+    if bus_qos_window < 1 or bus_qos_window > 65535:
+        exit("bus_qos window must be between 1 and 65535 cycles instead of " + str(bus_qos_window))
+    for master in bus_qos_masters:
+        if bus_qos_budget[master] < 0 or bus_qos_budget[master] > bus_qos_window:
+            exit("bus_qos budget of " + master + " must be between 0 and the window (" + str(bus_qos_window) + ") instead of " + str(bus_qos_budget[master]))
+
     if args.memorybanks != None and args.memorybanks != '':
         ram_numbanks_cont = int(args.memorybanks)
     else:
@@ -421,7 +445,7 @@ def main():
     if ram_numbanks_il != 0 and bus_type == 'onetoM':
         exit("bus type must be 'NtoM' instead 'onetoM' to access the interleaved memory banks in parallel" + str(args.bus))
 
-    if ram_numbanks_cont + ram_numbanks_il < 2 and ram_numbanks_cont + ram_numbanks_il > 16:
+    if ram_numbanks_cont + ram_numbanks_il < 2 or ram_numbanks_cont + ram_numbanks_il > 16:
         exit("ram numbanks must be between 2 and 16 instead of " + str(ram_numbanks_cont + ram_numbanks_il))
     else:
         ram_numbanks = ram_numbanks_cont + ram_numbanks_il
@@ -430,7 +454,40 @@ def main():
     if int(ram_start_address,16) != 0:
         exit("ram start address must be 0 instead of " + str(ram_start_address))
 
-    ram_size_address = '{:08X}'.format(ram_numbanks*32*1024)
+    # bank sizes are given in KB, either one value for all the continuous banks or one value per bank
+    ram_bank_size_cfg = obj['ram'].get('bank_size', 32)
+    if isinstance(ram_bank_size_cfg, list):
+        ram_bank_sizes_kb = [int(size) for size in ram_bank_size_cfg]
+        if len(ram_bank_sizes_kb) != ram_numbanks_cont:
+            exit("ram bank_size must have one value per continuous bank (" + str(ram_numbanks_cont) + ") instead of " + str(len(ram_bank_sizes_kb)))
+    else:
+        ram_bank_sizes_kb = [int(ram_bank_size_cfg)] * ram_numbanks_cont
+
+    # interleaved banks must all have the same size
+    ram_bank_size_il_kb = int(obj['ram'].get('bank_size_interleaved', 32))
+    ram_bank_sizes_kb += [ram_bank_size_il_kb] * ram_numbanks_il
+
+    for size in ram_bank_sizes_kb:
+        if size < 1 or not log2(size).is_integer():
+            exit("ram bank sizes must be a power of 2 number of KB instead of " + str(size))
+
+    # the sky130 SRAM wrapper only comes in 32KB banks
+    if args.tech == 'sky130' and any(size != 32 for size in ram_bank_sizes_kb):
+        exit("ram bank sizes must all be 32KB with the sky130 SRAM macros instead of " + str(ram_bank_sizes_kb))
+
+    ram_bank_sizes = [size*1024 for size in ram_bank_sizes_kb]
+
+    # continuous banks are placed one after the other, the interleaved banks share the region after them
+    ram_bank_start_addresses = []
+    bank_start_address = int(ram_start_address,16)
+    for bank in range(ram_numbanks_cont):
+        ram_bank_start_addresses.append(bank_start_address)
+        bank_start_address += ram_bank_sizes[bank]
+    ram_il_start_address = bank_start_address
+    ram_il_size = ram_bank_size_il_kb*1024*ram_numbanks_il
+    ram_bank_start_addresses += [ram_il_start_address] * ram_numbanks_il
+
+    ram_size_address = '{:08X}'.format(sum(ram_bank_sizes))
 
     if args.external_domains != None and args.external_domains != '':
         external_domains = int(args.external_domains)
@@ -502,33 +559,83 @@ def main():
     ext_slave_start_address = string2int(obj['ext_slaves']['address'])
     ext_slave_size_address = string2int(obj['ext_slaves']['length'])
 
+    posted_writes = obj.get('posted_writes', {})
+    peripheral_posted_writes = int(posted_writes.get('peripherals', 0))
+    ext_slave_posted_writes = int(posted_writes.get('ext_slaves', 0))
+    for depth in [peripheral_posted_writes, ext_slave_posted_writes]:
+        if depth < 0 or depth > 8:
+            exit("posted_writes depth must be between 0 and 8 instead of " + str(depth))
+
+    ext_slave_protocol = obj['ext_slaves'].get('protocol', 'obi')
+    if ext_slave_protocol not in ['obi', 'axi']:
+        exit("ext_slaves protocol must be obi or axi instead of " + str(ext_slave_protocol))
+    ext_slave_axi = ext_slave_protocol == 'axi'
+    ext_slave_axi_data_width = int(obj['ext_slaves'].get('axi_data_width', 32))
+    if ext_slave_axi_data_width not in [32, 64, 128]:
+        exit("ext_slaves axi_data_width must be 32, 64 or 128 instead of " + str(ext_slave_axi_data_width))
+
+    event_matrix = obj.get('event_matrix', {})
+    event_matrix_channels = int(event_matrix.get('channels', 4))
+    # with one channel reggen names the CHANNEL register without its index and reg2hw.channel is not an array
+    if event_matrix_channels < 2 or event_matrix_channels > 32:
+        exit("event_matrix channels must be between 2 and 32 instead of " + str(event_matrix_channels))
+
     flash_mem_start_address  = string2int(obj['flash_mem']['address'])
     flash_mem_size_address  = string2int(obj['flash_mem']['length'])
 
+    flash_cache = obj['flash_mem'].get('cache', {})
+    flash_cache_size = int(flash_cache.get('size', 0))
+    flash_cache_line_size = int(flash_cache.get('line', 16))
+    flash_cache_ways = int(flash_cache.get('ways', 2))
+    if flash_cache_size != 0:
+        if flash_cache_line_size < 4 or not log2(flash_cache_line_size).is_integer():
+            exit("flash_mem cache line must be a power of 2 number of bytes, at least 4, instead of " + str(flash_cache_line_size))
+        if flash_cache_ways < 1 or not log2(flash_cache_size).is_integer() or flash_cache_size < flash_cache_line_size * flash_cache_ways:
+            exit("flash_mem cache size must be a power of 2 holding at least one line per way instead of " + str(flash_cache_size))
+        if not log2(flash_cache_size // (flash_cache_line_size * flash_cache_ways)).is_integer() or flash_cache_size % (flash_cache_line_size * flash_cache_ways) != 0:
+            exit("flash_mem cache size / (line * ways) must be a power of 2")
+
     linker_onchip_code_start_address  = string2int(obj['linker_script']['onchip_ls']['code']['address'])
     linker_onchip_code_size_address  = string2int(obj['linker_script']['onchip_ls']['code']['lenght'])
 
     if int(linker_onchip_code_size_address,16) < 32*1024:
         exit("The code section must be at least 32KB, instead it is " + str(linker_onchip_code_size_address))
 
+    # continuous banks taken out of the data section, each one gets its own .bank<N> section
+    linker_onchip_banks = sorted(int(bank) for bank in obj['linker_script']['onchip_ls'].get('banks', []))
+    if linker_onchip_banks != list(range(ram_numbanks_cont - len(linker_onchip_banks), ram_numbanks_cont)):
+        exit("The linker banks must be the last continuous banks (up to " + str(ram_numbanks_cont - 1) + "), instead they are " + str(linker_onchip_banks))
+    linker_onchip_banks_size = sum(ram_bank_sizes[bank] for bank in linker_onchip_banks)
+
+    linker_onchip_stack_bank = int(obj['linker_script']['onchip_ls'].get('stack_bank', -1))
+    if linker_onchip_stack_bank != -1 and linker_onchip_stack_bank not in linker_onchip_banks:
+        exit("The stack bank must be one of the linker banks " + str(linker_onchip_banks) + " instead of " + str(linker_onchip_stack_bank))
+
     linker_onchip_data_start_address  = string2int(obj['linker_script']['onchip_ls']['data']['address'])
     if (obj['linker_script']['onchip_ls']['data']['lenght'].split()[0].split(",")[0] == "whatisleft"):
         if ram_numbanks_il == 0 or (ram_numbanks_cont == 1 and ram_numbanks_il > 0):
-            linker_onchip_data_size_address  = str('{:08X}'.format(int(ram_size_address,16) - int(linker_onchip_code_size_address,16)))
+            linker_onchip_data_size_address  = str('{:08X}'.format(int(ram_size_address,16) - int(linker_onchip_code_size_address,16) - linker_onchip_banks_size))
         else:
-            linker_onchip_data_size_address  = str('{:08X}'.format(int(ram_size_address,16) - int(linker_onchip_code_size_address,16) - ram_numbanks_il*32*1024))
+            linker_onchip_data_size_address  = str('{:08X}'.format(int(ram_size_address,16) - int(linker_onchip_code_size_address,16) - linker_onchip_banks_size - ram_il_size))
     else:
         if ram_numbanks_il == 0 or (ram_numbanks_cont == 1 and ram_numbanks_il > 0):
             linker_onchip_data_size_address  = string2int(obj['linker_script']['onchip_ls']['data']['lenght'])
         else:
-            linker_onchip_data_size_address  = str('{:08X}'.format(int(string2int(obj['linker_script']['onchip_ls']['data']['lenght']),16) - ram_numbanks_il*32*1024))
+            linker_onchip_data_size_address  = str('{:08X}'.format(int(string2int(obj['linker_script']['onchip_ls']['data']['lenght']),16) - ram_il_size))
 
-    linker_onchip_il_start_address = str('{:08X}'.format(int(linker_onchip_data_start_address,16) + int(linker_onchip_data_size_address,16)))
-    linker_onchip_il_size_address = str('{:08X}'.format(ram_numbanks_il*32*1024))
+    linker_onchip_il_start_address = str('{:08X}'.format(ram_il_start_address))
+    linker_onchip_il_size_address = str('{:08X}'.format(ram_il_size))
 
     if ((int(linker_onchip_data_size_address,16) + int(linker_onchip_code_size_address,16)) > int(ram_size_address,16)):
         exit("The code and data section must fit in the RAM size, instead they takes " + str(linker_onchip_data_size_address + linker_onchip_code_size_address))
 
+    if len(linker_onchip_banks) > 0 and int(linker_onchip_data_start_address,16) + int(linker_onchip_data_size_address,16) > ram_bank_start_addresses[linker_onchip_banks[0]]:
+        exit("The data section must end before the linker banks, at " + '{:08X}'.format(ram_bank_start_addresses[linker_onchip_banks[0]]))
+
+    linker_flash_load_overlays = int(obj['linker_script'].get('flash_load_ls', {}).get('overlays', 0))
+    if linker_flash_load_overlays < 0:
+        exit("The number of flash_load overlays must be positive, instead it is " + str(linker_flash_load_overlays))
+
     plic_used_n_interrupts = len(obj['interrupts']['list'])
     plit_n_interrupts = obj['interrupts']['number']
     ext_int_list = { f"EXT_INTR_{k}": v for k, v in enumerate(range(plic_used_n_interrupts, plit_n_interrupts)) }
@@ -793,11 +900,19 @@ def main():
     kwargs = {
         "cpu_type"                         : cpu_type,
         "bus_type"                         : bus_type,
+        "bus_qos_masters"                  : bus_qos_masters,
+        "bus_qos_priority"                 : bus_qos_priority,
+        "bus_qos_budget"                   : bus_qos_budget,
+        "bus_qos_window"                   : bus_qos_window,
         "ram_start_address"                : ram_start_address,
         "ram_numbanks"                     : ram_numbanks,
         "ram_numbanks_cont"                : ram_numbanks_cont,
         "ram_numbanks_il"                  : ram_numbanks_il,
         "log_ram_numbanks_il"              : log_ram_numbanks_il,
+        "ram_bank_sizes"                   : ram_bank_sizes,
+        "ram_bank_start_addresses"         : ram_bank_start_addresses,
+        "ram_il_start_address"             : ram_il_start_address,
+        "ram_il_size"                      : ram_il_size,
         "external_domains"                 : external_domains,
         "ram_size_address"                 : ram_size_address,
         "debug_start_address"              : debug_start_address,
@@ -812,14 +927,25 @@ def main():
         "peripherals_count"                : peripherals_count,
         "ext_slave_start_address"          : ext_slave_start_address,
         "ext_slave_size_address"           : ext_slave_size_address,
+        "peripheral_posted_writes"         : peripheral_posted_writes,
+        "ext_slave_posted_writes"          : ext_slave_posted_writes,
+        "ext_slave_axi"                    : ext_slave_axi,
+        "ext_slave_axi_data_width"         : ext_slave_axi_data_width,
+        "event_matrix_channels"            : event_matrix_channels,
         "flash_mem_start_address"          : flash_mem_start_address,
         "flash_mem_size_address"           : flash_mem_size_address,
+        "flash_cache_size"                 : flash_cache_size,
+        "flash_cache_line_size"            : flash_cache_line_size,
+        "flash_cache_ways"                 : flash_cache_ways,
         "linker_onchip_code_start_address" : linker_onchip_code_start_address,
         "linker_onchip_code_size_address"  : linker_onchip_code_size_address,
         "linker_onchip_data_start_address" : linker_onchip_data_start_address,
         "linker_onchip_data_size_address"  : linker_onchip_data_size_address,
         "linker_onchip_il_start_address"   : linker_onchip_il_start_address,
         "linker_onchip_il_size_address"    : linker_onchip_il_size_address,
+        "linker_onchip_banks"              : linker_onchip_banks,
+        "linker_onchip_stack_bank"         : linker_onchip_stack_bank,
+        "linker_flash_load_overlays"       : linker_flash_load_overlays,
         "plic_used_n_interrupts"           : plic_used_n_interrupts,
         "plit_n_interrupts"                : plit_n_interrupts,
         "interrupts"                       : interrupts,
@@ -296,8 +296,13 @@ def add_registers(peripheral_json):
             for f in multireg["fields"]:
                 n_bits += count_bits(f["bits"])
 
-            # computes the number of registers needed to pack all the bit fields needed
-            n_multireg = int((count * n_bits) /  int(peripheral_json["regwidth"]))
+            # computes the number of registers needed: as reggen does, a multireg with
+            # a single field is packed, with more fields each copy has its own register
+            if len(multireg["fields"]) == 1 and str(multireg.get("compact", "true")).lower() != "false":
+                fields_per_reg = int(peripheral_json["regwidth"]) // n_bits
+            else:
+                fields_per_reg = 1
+            n_multireg = (count + fields_per_reg - 1) // fields_per_reg
             
             # generate the multiregisters
             for r in range(n_multireg):